@@ -79,6 +79,16 @@ ADDAPI char* ADDCALL sass_copy_c_string(const char* str);
 // to free overtaken memory when done
 ADDAPI void ADDCALL sass_free_memory(void* ptr);
 
+// Unused memory arenas kept for the next compilation
+// Only has an effect with the custom memory allocator
+// (SASS_CUSTOM_ALLOCATOR), without it (the default) the
+// setter is ignored and all getters and trim return 0
+ADDAPI void ADDCALL sass_memory_set_arena_retention(size_t arenas);
+ADDAPI size_t ADDCALL sass_memory_get_arena_retention(void);
+ADDAPI size_t ADDCALL sass_memory_get_retained_bytes(void);
+// give all unused arenas back to the system (returns bytes)
+ADDAPI size_t ADDCALL sass_memory_trim(void);
+
 // Some convenient string helper function
 ADDAPI char* ADDCALL sass_string_quote (const char* str, const char quote_mark);
 ADDAPI char* ADDCALL sass_string_unquote (const char* str);
@@ -14,6 +14,17 @@ extern "C" {
 
 // Forward declaration
 struct Sass_Compiler;
+struct Sass_Memory_Stats;
+struct Sass_StyleSheet_Cache;
+struct Sass_Directory_Cache;
+struct Sass_Import_Edge;
+struct Sass_Dependency_Graph;
+struct Sass_Watcher;
+
+// Typedef helpers for memory statistics
+typedef struct Sass_Memory_Stats (*Sass_Memory_Stats_Entry);
+// Typedef helpers for import graph edges
+typedef struct Sass_Import_Edge (*Sass_Import_Edge_Entry);
 
 // Forward declaration
 struct Sass_Options; // base struct
@@ -21,6 +32,11 @@ struct Sass_Context; // : Sass_Options
 struct Sass_File_Context; // : Sass_Context
 struct Sass_Data_Context; // : Sass_Context
 
+// Typedefs for watcher callbacks (to set the options of
+// every compilation and to take the results afterwards)
+typedef void (*Sass_Watch_Options_Fn) (struct Sass_Options* options, void* cookie);
+typedef void (*Sass_Watch_Result_Fn) (struct Sass_Context* ctx, void* cookie);
+
 // Compiler states
 enum Sass_Compiler_State {
   SASS_COMPILER_CREATED,
@@ -28,6 +44,15 @@ enum Sass_Compiler_State {
   SASS_COMPILER_EXECUTED
 };
 
+// Compiler phases where memory statistics are sampled
+enum Sass_Memory_Phase {
+  SASS_MEMORY_PARSED,
+  SASS_MEMORY_EXPANDED,
+  SASS_MEMORY_EXTENDED,
+  SASS_MEMORY_CSSIZED,
+  SASS_MEMORY_RENDERED
+};
+
 // Create and initialize an option struct
 ADDAPI struct Sass_Options* ADDCALL sass_make_options (void);
 // Create and initialize a specific context
@@ -38,6 +63,12 @@ ADDAPI struct Sass_Data_Context* ADDCALL sass_make_data_context (char* source_st
 ADDAPI int ADDCALL sass_compile_file_context (struct Sass_File_Context* ctx);
 ADDAPI int ADDCALL sass_compile_data_context (struct Sass_Data_Context* ctx);
 
+// Parse the file and all files it imports, and store their trees next to
+// them (see `write_precompiled`) without compiling. Later compilations
+// load them with `load_precompiled`. Fails with custom importers or
+// headers and if a tree can't be written (e.g. the folder is read-only)
+ADDAPI int ADDCALL sass_precompile_file_context (struct Sass_File_Context* ctx);
+
 // Create a sass compiler instance for more control
 ADDAPI struct Sass_Compiler* ADDCALL sass_make_file_compiler (struct Sass_File_Context* file_ctx);
 ADDAPI struct Sass_Compiler* ADDCALL sass_make_data_compiler (struct Sass_Data_Context* data_ctx);
@@ -56,6 +87,64 @@ ADDAPI void ADDCALL sass_delete_options(struct Sass_Options* options);
 ADDAPI void ADDCALL sass_delete_file_context (struct Sass_File_Context* ctx);
 ADDAPI void ADDCALL sass_delete_data_context (struct Sass_Data_Context* ctx);
 
+// Cache for parsed stylesheets of imported files, which can be attached
+// to many compilations via `sass_option_set_stylesheet_cache` (also at
+// the same time). A sheet is only used by one compilation at a time, the
+// others parse the file on their own meanwhile. It must not be deleted
+// while in use and is not used by compilations with custom importers.
+ADDAPI struct Sass_StyleSheet_Cache* ADDCALL sass_make_stylesheet_cache (void);
+ADDAPI void ADDCALL sass_delete_stylesheet_cache (struct Sass_StyleSheet_Cache* cache);
+// Drop all cached stylesheets not in use (e.g. to free memory)
+ADDAPI void ADDCALL sass_stylesheet_cache_clear (struct Sass_StyleSheet_Cache* cache);
+// Number of stylesheets currently cached
+ADDAPI size_t ADDCALL sass_stylesheet_cache_get_size (struct Sass_StyleSheet_Cache* cache);
+
+// Cache for directory listings used to resolve imports, which can be
+// attached to many compilations via `sass_option_set_directory_cache`
+// (also at the same time). Every directory is only read once, so the
+// cache must be told when files are created or removed.
+ADDAPI struct Sass_Directory_Cache* ADDCALL sass_make_directory_cache (void);
+ADDAPI void ADDCALL sass_delete_directory_cache (struct Sass_Directory_Cache* cache);
+// Forget the listing of the directory at path and of the directory containing it
+ADDAPI void ADDCALL sass_directory_cache_invalidate (struct Sass_Directory_Cache* cache, const char* path);
+// Forget all directory listings
+ADDAPI void ADDCALL sass_directory_cache_clear (struct Sass_Directory_Cache* cache);
+// Number of directory listings currently cached
+ADDAPI size_t ADDCALL sass_directory_cache_get_size (struct Sass_Directory_Cache* cache);
+
+// Imports of many compilations by their entry point, to find the entry
+// points that must be compiled again after files have changed. Attach
+// a stylesheet cache to the compilations to reuse unchanged imports.
+ADDAPI struct Sass_Dependency_Graph* ADDCALL sass_make_dependency_graph (void);
+ADDAPI void ADDCALL sass_delete_dependency_graph (struct Sass_Dependency_Graph* graph);
+// Record the imports of a parsed compiler for its entry point (replaces older ones)
+ADDAPI void ADDCALL sass_dependency_graph_add_compiler (struct Sass_Dependency_Graph* graph, struct Sass_Compiler* compiler);
+// Forget the entry point (by the absolute path of the entry file)
+ADDAPI void ADDCALL sass_dependency_graph_remove_entry (struct Sass_Dependency_Graph* graph, const char* entry);
+// Number of recorded entry points
+ADDAPI size_t ADDCALL sass_dependency_graph_get_size (struct Sass_Dependency_Graph* graph);
+// Find the entry points affected by the changed (also created or deleted) files.
+// Files with the same contents as recorded are ignored. Returns the number found.
+ADDAPI size_t ADDCALL sass_dependency_graph_find_affected (struct Sass_Dependency_Graph* graph, const char** paths, size_t count);
+// Entry points found by the last `sass_dependency_graph_find_affected` call
+ADDAPI const char* ADDCALL sass_dependency_graph_get_affected (struct Sass_Dependency_Graph* graph, size_t idx);
+
+// Watcher that compiles entry points again whenever files they depend on
+// change. Parsed imports are kept in memory, so only changed files are
+// parsed again. Every compilation gets its options from the options
+// callback and is passed to the result callback once done (the context
+// is deleted afterwards). Files are watched with inotify, so this is only
+// supported on Linux: it returns NULL on every other platform (and if no
+// inotify instance can be created), callers must check for that and fall
+// back to compiling on their own.
+ADDAPI struct Sass_Watcher* ADDCALL sass_make_watcher (Sass_Watch_Options_Fn options, Sass_Watch_Result_Fn result, void* cookie);
+ADDAPI void ADDCALL sass_delete_watcher (struct Sass_Watcher* watcher);
+// Compile the input file right away and watch its dependencies
+ADDAPI void ADDCALL sass_watcher_add_file (struct Sass_Watcher* watcher, const char* input_path);
+// Wait up to timeout milliseconds (forever if negative) for changes and compile
+// the affected files. Returns the number of compilations or -1 on errors.
+ADDAPI int ADDCALL sass_watcher_poll (struct Sass_Watcher* watcher, int timeout);
+
 // Getters for context from specific implementation
 ADDAPI struct Sass_Context* ADDCALL sass_file_context_get_context (struct Sass_File_Context* file_ctx);
 ADDAPI struct Sass_Context* ADDCALL sass_data_context_get_context (struct Sass_Data_Context* data_ctx);
@@ -77,6 +166,15 @@ ADDAPI bool ADDCALL sass_option_get_source_map_contents (struct Sass_Options* op
 ADDAPI bool ADDCALL sass_option_get_source_map_file_urls (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_omit_source_map_url (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_is_indented_syntax_src (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_memory_region (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_memory_stats (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_memory_limit (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_map_files (struct Sass_Options* options);
+ADDAPI struct Sass_StyleSheet_Cache* ADDCALL sass_option_get_stylesheet_cache (struct Sass_Options* options);
+ADDAPI struct Sass_Directory_Cache* ADDCALL sass_option_get_directory_cache (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_load_precompiled (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_write_precompiled (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_import_prefetch (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_indent (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_linefeed (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_input_path (struct Sass_Options* options);
@@ -96,6 +194,23 @@ ADDAPI void ADDCALL sass_option_set_source_map_contents (struct Sass_Options* op
 ADDAPI void ADDCALL sass_option_set_source_map_file_urls (struct Sass_Options* options, bool source_map_file_urls);
 ADDAPI void ADDCALL sass_option_set_omit_source_map_url (struct Sass_Options* options, bool omit_source_map_url);
 ADDAPI void ADDCALL sass_option_set_is_indented_syntax_src (struct Sass_Options* options, bool is_indented_syntax_src);
+// Release all nodes in one step after the compilation
+// Silently ignored without SASS_CUSTOM_ALLOCATOR (the default)
+ADDAPI void ADDCALL sass_option_set_memory_region (struct Sass_Options* options, bool memory_region);
+// Sample memory statistics once per phase (see below)
+ADDAPI void ADDCALL sass_option_set_memory_stats (struct Sass_Options* options, bool memory_stats);
+// Fail with an error once the compilation holds more bytes (zero is
+// unlimited). Without SASS_CUSTOM_ALLOCATOR (the default) only nodes
+// and values are charged, strings and containers are not counted.
+ADDAPI void ADDCALL sass_option_set_memory_limit (struct Sass_Options* options, size_t memory_limit);
+// Memory map big files instead of reading them (off by default, the
+// process gets a SIGBUS if a mapped file is truncated meanwhile)
+ADDAPI void ADDCALL sass_option_set_map_files (struct Sass_Options* options, bool map_files);
+ADDAPI void ADDCALL sass_option_set_stylesheet_cache (struct Sass_Options* options, struct Sass_StyleSheet_Cache* stylesheet_cache);
+ADDAPI void ADDCALL sass_option_set_directory_cache (struct Sass_Options* options, struct Sass_Directory_Cache* directory_cache);
+ADDAPI void ADDCALL sass_option_set_load_precompiled (struct Sass_Options* options, bool load_precompiled);
+ADDAPI void ADDCALL sass_option_set_write_precompiled (struct Sass_Options* options, bool write_precompiled);
+ADDAPI void ADDCALL sass_option_set_import_prefetch (struct Sass_Options* options, size_t import_prefetch);
 ADDAPI void ADDCALL sass_option_set_indent (struct Sass_Options* options, const char* indent);
 ADDAPI void ADDCALL sass_option_set_linefeed (struct Sass_Options* options, const char* linefeed);
 ADDAPI void ADDCALL sass_option_set_input_path (struct Sass_Options* options, const char* input_path);
@@ -152,6 +267,38 @@ ADDAPI Sass_Import_Entry ADDCALL sass_compiler_get_import_entry(struct Sass_Comp
 ADDAPI size_t ADDCALL sass_compiler_get_callee_stack_size(struct Sass_Compiler* compiler);
 ADDAPI Sass_Callee_Entry ADDCALL sass_compiler_get_last_callee(struct Sass_Compiler* compiler);
 ADDAPI Sass_Callee_Entry ADDCALL sass_compiler_get_callee_entry(struct Sass_Compiler* compiler, size_t idx);
+ADDAPI size_t ADDCALL sass_compiler_get_memory_stats_size(struct Sass_Compiler* compiler);
+ADDAPI Sass_Memory_Stats_Entry ADDCALL sass_compiler_get_memory_stats_entry(struct Sass_Compiler* compiler, size_t idx);
+ADDAPI size_t ADDCALL sass_compiler_get_import_edges_size(struct Sass_Compiler* compiler);
+ADDAPI Sass_Import_Edge_Entry ADDCALL sass_compiler_get_import_edge(struct Sass_Compiler* compiler, size_t idx);
+
+// Getters for import graph edges (every loaded file import, also repeated ones)
+ADDAPI const char* ADDCALL sass_import_edge_get_importer(Sass_Import_Edge_Entry edge);
+ADDAPI const char* ADDCALL sass_import_edge_get_imported(Sass_Import_Edge_Entry edge);
+ADDAPI const char* ADDCALL sass_import_edge_get_imp_path(Sass_Import_Edge_Entry edge);
+ADDAPI size_t ADDCALL sass_import_edge_get_line(Sass_Import_Edge_Entry edge);
+ADDAPI size_t ADDCALL sass_import_edge_get_column(Sass_Import_Edge_Entry edge);
+// Hash of the imported contents
+ADDAPI size_t ADDCALL sass_import_edge_get_hash(Sass_Import_Edge_Entry edge);
+
+// Getters for memory statistics (sampled once per phase)
+// Allocator counters are only available with SASS_CUSTOM_ALLOCATOR,
+// without it (the default) they are always zero and the bucket count
+// is zero too; only the object counts per class are filled.
+ADDAPI enum Sass_Memory_Phase ADDCALL sass_memory_stats_get_phase(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_arenas(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_resident_bytes(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_peak_bytes(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_large_objects(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_large_bytes(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_bucket_count(Sass_Memory_Stats_Entry stats);
+ADDAPI size_t ADDCALL sass_memory_stats_get_bucket_size(Sass_Memory_Stats_Entry stats, size_t idx);
+ADDAPI size_t ADDCALL sass_memory_stats_get_bucket_objects(Sass_Memory_Stats_Entry stats, size_t idx);
+ADDAPI size_t ADDCALL sass_memory_stats_get_bucket_bytes(Sass_Memory_Stats_Entry stats, size_t idx);
+ADDAPI size_t ADDCALL sass_memory_stats_get_bucket_free(Sass_Memory_Stats_Entry stats, size_t idx);
+ADDAPI size_t ADDCALL sass_memory_stats_get_class_count(Sass_Memory_Stats_Entry stats);
+ADDAPI const char* ADDCALL sass_memory_stats_get_class_name(Sass_Memory_Stats_Entry stats, size_t idx);
+ADDAPI size_t ADDCALL sass_memory_stats_get_class_objects(Sass_Memory_Stats_Entry stats, size_t idx);
 
 // Push function for paths (no manipulation support for now)
 ADDAPI void ADDCALL sass_option_push_plugin_path (struct Sass_Options* options, const char* path);
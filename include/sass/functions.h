@@ -18,6 +18,7 @@ struct Sass_Options;
 struct Sass_Compiler;
 struct Sass_Importer;
 struct Sass_Function;
+struct Sass_Pending_Import;
 
 // Typedef helpers for callee lists
 typedef struct Sass_Env (*Sass_Env_Frame);
@@ -32,6 +33,11 @@ typedef struct Sass_Importer* (*Sass_Importer_List);
 // Typedef defining importer signature and return type
 typedef Sass_Import_List (*Sass_Importer_Fn)
   (const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* compiler);
+// Typedef helpers for imports resolved asynchronously
+typedef struct Sass_Pending_Import (*Sass_Pending_Import_Entry);
+// Typedef defining asynchronous importer signature and return type
+typedef Sass_Pending_Import_Entry (*Sass_Async_Importer_Fn)
+  (const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* compiler);
 
 // Typedef helpers for custom functions lists
 typedef struct Sass_Function (*Sass_Function_Entry);
@@ -57,9 +63,12 @@ ADDAPI void ADDCALL sass_delete_importer_list (Sass_Importer_List list);
 // Creators for custom importer callback (with some additional pointer)
 // The pointer is mostly used to store the callback into the actual binding
 ADDAPI Sass_Importer_Entry ADDCALL sass_make_importer (Sass_Importer_Fn importer, double priority, void* cookie);
+// The importer returns a pending import (or NULL to skip) and resolves it later from any thread
+ADDAPI Sass_Importer_Entry ADDCALL sass_make_async_importer (Sass_Async_Importer_Fn importer, double priority, void* cookie);
 
 // Getters for import function descriptors
 ADDAPI Sass_Importer_Fn ADDCALL sass_importer_get_function (Sass_Importer_Entry cb);
+ADDAPI Sass_Async_Importer_Fn ADDCALL sass_importer_get_async_function (Sass_Importer_Entry cb);
 ADDAPI double ADDCALL sass_importer_get_priority (Sass_Importer_Entry cb);
 ADDAPI void* ADDCALL sass_importer_get_cookie (Sass_Importer_Entry cb);
 
@@ -73,6 +82,9 @@ ADDAPI Sass_Import_Entry ADDCALL sass_make_import_entry (const char* path, char*
 ADDAPI Sass_Import_Entry ADDCALL sass_make_import (const char* imp_path, const char* abs_base, char* source, char* srcmap);
 // set error message to abort import and to print out a message (path from existing object is used in output)
 ADDAPI Sass_Import_Entry ADDCALL sass_import_set_error(Sass_Import_Entry import, const char* message, size_t line, size_t col);
+// mark the entry as cacheable, a later result with the same key and version reuses the first one
+// within the compilation (its source is not parsed again and a file path is not loaded again)
+ADDAPI Sass_Import_Entry ADDCALL sass_import_set_cache_key(Sass_Import_Entry import, const char* key, const char* version);
 
 // Setters to insert an entry into the import list (you may also use [] access directly)
 // Since we are dealing with pointers they should have a guaranteed and fixed size
@@ -108,6 +120,15 @@ ADDAPI char* ADDCALL sass_import_take_srcmap (Sass_Import_Entry);
 ADDAPI size_t ADDCALL sass_import_get_error_line (Sass_Import_Entry);
 ADDAPI size_t ADDCALL sass_import_get_error_column (Sass_Import_Entry);
 ADDAPI const char* ADDCALL sass_import_get_error_message (Sass_Import_Entry);
+// Getters from cacheable import entry
+ADDAPI const char* ADDCALL sass_import_get_cache_key (Sass_Import_Entry);
+ADDAPI const char* ADDCALL sass_import_get_cache_version (Sass_Import_Entry);
+
+// Creator for the pending import returned by an asynchronous importer
+ADDAPI Sass_Pending_Import_Entry ADDCALL sass_make_pending_import (void);
+// Complete the pending import with the import list (or NULL to skip), may be called from any thread
+// The compiler takes ownership of the list and frees the pending import (don't use it afterwards)
+ADDAPI void ADDCALL sass_pending_import_resolve (Sass_Pending_Import_Entry pending, Sass_Import_List list);
 
 // Deallocator for associated memory (incl. entries)
 ADDAPI void ADDCALL sass_delete_import_list (Sass_Import_List);
@@ -55,7 +55,9 @@ namespace Sass {
 
   void AST_Node::update_pstate(const SourceSpan& pstate)
   {
-    pstate_.offset += pstate.position - pstate_.position + pstate.offset;
+    // extend our span up to the end of the given one
+    size_t end = pstate.position + pstate.offset;
+    if (end > pstate_.position) pstate_.offset = end - pstate_.position;
   }
 
   sass::string AST_Node::to_string(Sass_Inspect_Options opt) const
@@ -272,14 +274,15 @@ namespace Sass {
   /////////////////////////////////////////////////////////////////////////
 
   Assignment::Assignment(SourceSpan pstate, sass::string var, ExpressionObj val, bool is_default, bool is_global)
-  : Statement(pstate), variable_(var), value_(val), is_default_(is_default), is_global_(is_global)
+  : Statement(pstate), variable_(var), value_(val), is_default_(is_default), is_global_(is_global), symbol_(var)
   { statement_type(ASSIGNMENT); }
   Assignment::Assignment(const Assignment* ptr)
   : Statement(ptr),
     variable_(ptr->variable_),
     value_(ptr->value_),
     is_default_(ptr->is_default_),
-    is_global_(ptr->is_global_)
+    is_global_(ptr->is_global_),
+    symbol_(ptr->symbol_)
   { statement_type(ASSIGNMENT); }
 
   /////////////////////////////////////////////////////////////////////////
@@ -311,6 +314,7 @@ namespace Sass {
   : Statement(ptr), resource_(ptr->resource_)
   { statement_type(IMPORT_STUB); }
   Include Import_Stub::resource() { return resource_; };
+  void Import_Stub::resource(const Include& res) { resource_ = res; };
   sass::string Import_Stub::imp_path() { return resource_.imp_path; };
   sass::string Import_Stub::abs_path() { return resource_.abs_path; };
 
@@ -384,26 +388,34 @@ namespace Sass {
   ForRule::ForRule(SourceSpan pstate,
       sass::string var, ExpressionObj lo, ExpressionObj hi, Block_Obj b, bool inc)
   : ParentStatement(pstate, b),
-    variable_(var), lower_bound_(lo), upper_bound_(hi), is_inclusive_(inc)
+    variable_(var), lower_bound_(lo), upper_bound_(hi), is_inclusive_(inc), symbol_(var)
   { statement_type(FOR); }
   ForRule::ForRule(const ForRule* ptr)
   : ParentStatement(ptr),
     variable_(ptr->variable_),
     lower_bound_(ptr->lower_bound_),
     upper_bound_(ptr->upper_bound_),
-    is_inclusive_(ptr->is_inclusive_)
+    is_inclusive_(ptr->is_inclusive_),
+    symbol_(ptr->symbol_)
   { statement_type(FOR); }
 
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
 
   EachRule::EachRule(SourceSpan pstate, sass::vector<sass::string> vars, ExpressionObj lst, Block_Obj b)
-  : ParentStatement(pstate, b), variables_(vars), list_(lst)
-  { statement_type(EACH); }
+  : ParentStatement(pstate, b), list_(lst)
+  { statement_type(EACH); variables(vars); }
   EachRule::EachRule(const EachRule* ptr)
-  : ParentStatement(ptr), variables_(ptr->variables_), list_(ptr->list_)
+  : ParentStatement(ptr), variables_(ptr->variables_), list_(ptr->list_), symbols_(ptr->symbols_)
   { statement_type(EACH); }
 
+  void EachRule::variables(const sass::vector<sass::string>& vars)
+  {
+    variables_ = vars;
+    symbols_.clear();
+    for (const sass::string& var : vars) symbols_.push_back(Symbol(var));
+  }
+
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
 
@@ -455,7 +467,8 @@ namespace Sass {
     c_function_(ptr->c_function_),
     cookie_(ptr->cookie_),
     is_overload_stub_(ptr->is_overload_stub_),
-    signature_(ptr->signature_)
+    signature_(ptr->signature_),
+    symbol_(ptr->symbol_)
   { }
 
   Definition::Definition(SourceSpan pstate,
@@ -472,7 +485,8 @@ namespace Sass {
     c_function_(0),
     cookie_(0),
     is_overload_stub_(false),
-    signature_(0)
+    signature_(0),
+    symbol_(n + (t == MIXIN ? "[m]" : "[f]"))
   { }
 
   Definition::Definition(SourceSpan pstate,
@@ -490,7 +504,8 @@ namespace Sass {
     c_function_(0),
     cookie_(0),
     is_overload_stub_(overload_stub),
-    signature_(sig)
+    signature_(sig),
+    symbol_(n + "[f]")
   { }
 
   Definition::Definition(SourceSpan pstate,
@@ -507,20 +522,22 @@ namespace Sass {
     c_function_(c_func),
     cookie_(sass_function_get_cookie(c_func)),
     is_overload_stub_(false),
-    signature_(sig)
+    signature_(sig),
+    symbol_(n + "[f]")
   { }
 
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
 
   Mixin_Call::Mixin_Call(SourceSpan pstate, sass::string n, Arguments_Obj args, Parameters_Obj b_params, Block_Obj b)
-  : ParentStatement(pstate, b), name_(n), arguments_(args), block_parameters_(b_params)
+  : ParentStatement(pstate, b), name_(n), arguments_(args), block_parameters_(b_params), symbol_(n + "[m]")
   { }
   Mixin_Call::Mixin_Call(const Mixin_Call* ptr)
   : ParentStatement(ptr),
     name_(ptr->name_),
     arguments_(ptr->arguments_),
-    block_parameters_(ptr->block_parameters_)
+    block_parameters_(ptr->block_parameters_),
+    symbol_(ptr->symbol_)
   { }
 
   /////////////////////////////////////////////////////////////////////////
@@ -856,13 +873,14 @@ namespace Sass {
   /////////////////////////////////////////////////////////////////////////
 
   Parameter::Parameter(SourceSpan pstate, sass::string n, ExpressionObj def, bool rest)
-  : AST_Node(pstate), name_(n), default_value_(def), is_rest_parameter_(rest)
+  : AST_Node(pstate), name_(n), default_value_(def), is_rest_parameter_(rest), symbol_(n)
   { }
   Parameter::Parameter(const Parameter* ptr)
   : AST_Node(ptr),
     name_(ptr->name_),
     default_value_(ptr->default_value_),
-    is_rest_parameter_(ptr->is_rest_parameter_)
+    is_rest_parameter_(ptr->is_rest_parameter_),
+    symbol_(ptr->symbol_)
   { }
 
   /////////////////////////////////////////////////////////////////////////
@@ -55,7 +55,7 @@ namespace Sass {
   // Abstract base class for all abstract syntax tree nodes.
   //////////////////////////////////////////////////////////
   class AST_Node : public SharedObj {
-    ADD_PROPERTY(SourceSpan, pstate)
+    ADD_GUARDED_PROPERTY(SourceSpan, pstate)
   public:
     AST_Node(SourceSpan pstate)
     : pstate_(pstate)
@@ -146,9 +146,9 @@ namespace Sass {
     };
   private:
     // expressions in some contexts shouldn't be evaluated
-    ADD_PROPERTY(bool, is_delayed)
-    ADD_PROPERTY(bool, is_expanded)
-    ADD_PROPERTY(bool, is_interpolant)
+    ADD_GUARDED_PROPERTY(bool, is_delayed)
+    ADD_GUARDED_PROPERTY(bool, is_expanded)
+    ADD_GUARDED_PROPERTY(bool, is_interpolant)
     ADD_PROPERTY(Type, concrete_type)
   public:
     Expression(SourceSpan pstate, bool d = false, bool e = false, bool i = false, Type ct = NONE);
@@ -356,10 +356,13 @@ namespace Sass {
   /////////////////////////////////////////////////////////////////////////////
   template <typename K, typename T, typename U>
   class Hashed {
+  public:
+    typedef std::unordered_map<
+      K, T, ObjHash, ObjHashEquality,
+      Sass::Allocator<std::pair<const K, T>>
+    > map_type;
   private:
-    std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    > elements_;
+    map_type elements_;
 
     sass::vector<K> _keys;
     sass::vector<T> _values;
@@ -395,9 +398,7 @@ namespace Sass {
     }
     bool has_duplicate_key() const         { return duplicate_key_ != nullptr; }
     K get_duplicate_key() const  { return duplicate_key_; }
-    const std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    >& elements() { return elements_; }
+    const map_type& elements() { return elements_; }
     Hashed& operator<<(std::pair<K, T> p)
     {
       reset_hash();
@@ -431,9 +432,7 @@ namespace Sass {
       reset_duplicate_key();
       return *this;
     }
-    const std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    >& pairs() const { return elements_; }
+    const map_type& pairs() const { return elements_; }
 
     const sass::vector<K>& keys() const { return _keys; }
     const sass::vector<T>& values() const { return _values; }
@@ -617,8 +616,11 @@ namespace Sass {
     ADD_PROPERTY(ExpressionObj, value)
     ADD_PROPERTY(bool, is_default)
     ADD_PROPERTY(bool, is_global)
+    // Interned variable name
+    Symbol symbol_;
   public:
     Assignment(SourceSpan pstate, sass::string var, ExpressionObj val, bool is_default = false, bool is_global = false);
+    const Symbol& symbol() const { return symbol_; }
     ATTACH_AST_OPERATIONS(Assignment)
     ATTACH_CRTP_PERFORM_METHODS()
   };
@@ -646,6 +648,7 @@ namespace Sass {
   public:
     Import_Stub(SourceSpan pstate, Include res);
     Include resource();
+    void resource(const Include& res);
     sass::string imp_path();
     sass::string abs_path();
     ATTACH_AST_OPERATIONS(Import_Stub)
@@ -715,12 +718,17 @@ namespace Sass {
   // The Sass `@for` control directive.
   /////////////////////////////////////
   class ForRule final : public ParentStatement {
-    ADD_CONSTREF(sass::string, variable)
+    sass::string variable_;
     ADD_PROPERTY(ExpressionObj, lower_bound)
     ADD_PROPERTY(ExpressionObj, upper_bound)
     ADD_PROPERTY(bool, is_inclusive)
+    // Interned variable name
+    Symbol symbol_;
   public:
     ForRule(SourceSpan pstate, sass::string var, ExpressionObj lo, ExpressionObj hi, Block_Obj b, bool inc);
+    const sass::string& variable() const { return variable_; }
+    void variable(const sass::string& var) { variable_ = var; symbol_ = Symbol(var); }
+    const Symbol& symbol() const { return symbol_; }
     ATTACH_AST_OPERATIONS(ForRule)
     ATTACH_CRTP_PERFORM_METHODS()
   };
@@ -729,10 +737,15 @@ namespace Sass {
   // The Sass `@each` control directive.
   //////////////////////////////////////
   class EachRule final : public ParentStatement {
-    ADD_PROPERTY(sass::vector<sass::string>, variables)
+    sass::vector<sass::string> variables_;
     ADD_PROPERTY(ExpressionObj, list)
+    // Interned variable names
+    sass::vector<Symbol> symbols_;
   public:
     EachRule(SourceSpan pstate, sass::vector<sass::string> vars, ExpressionObj lst, Block_Obj b);
+    sass::vector<sass::string> variables() const { return variables_; }
+    void variables(const sass::vector<sass::string>& vars);
+    const sass::vector<Symbol>& symbols() const { return symbols_; }
     ATTACH_AST_OPERATIONS(EachRule)
     ATTACH_CRTP_PERFORM_METHODS()
   };
@@ -775,6 +788,8 @@ namespace Sass {
     ADD_PROPERTY(void*, cookie)
     ADD_PROPERTY(bool, is_overload_stub)
     ADD_PROPERTY(Signature, signature)
+    // Key in the environment
+    Symbol symbol_;
   public:
     Definition(SourceSpan pstate,
                sass::string n,
@@ -792,6 +807,7 @@ namespace Sass {
                sass::string n,
                Parameters_Obj params,
                Sass_Function_Entry c_func);
+    const Symbol& symbol() const { return symbol_; }
     ATTACH_AST_OPERATIONS(Definition)
     ATTACH_CRTP_PERFORM_METHODS()
   };
@@ -803,8 +819,11 @@ namespace Sass {
     ADD_CONSTREF(sass::string, name)
     ADD_PROPERTY(Arguments_Obj, arguments)
     ADD_PROPERTY(Parameters_Obj, block_parameters)
+    // Key of the definition
+    Symbol symbol_;
   public:
     Mixin_Call(SourceSpan pstate, sass::string n, Arguments_Obj args, Parameters_Obj b_params = {}, Block_Obj b = {});
+    const Symbol& symbol() const { return symbol_; }
     ATTACH_AST_OPERATIONS(Mixin_Call)
     ATTACH_CRTP_PERFORM_METHODS()
   };
@@ -1026,8 +1045,11 @@ namespace Sass {
     ADD_CONSTREF(sass::string, name)
     ADD_PROPERTY(ExpressionObj, default_value)
     ADD_PROPERTY(bool, is_rest_parameter)
+    // Interned parameter name
+    Symbol symbol_;
   public:
     Parameter(SourceSpan pstate, sass::string n, ExpressionObj def = {}, bool rest = false);
+    const Symbol& symbol() const { return symbol_; }
     ATTACH_AST_OPERATIONS(Parameter)
     ATTACH_CRTP_PERFORM_METHODS()
   };
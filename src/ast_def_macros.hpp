@@ -35,6 +35,12 @@ class LocalOption {
   LocalOption<size_t> cnt_##name(name, name + 1); \
   if (name > MAX_NESTING) throw Exception::NestingLimitError(pstate, traces); \
 
+#define MEMORY_GUARD(budget, pstate) \
+  if ((budget).exceeded()) { \
+    traces.push_back(Backtrace(pstate)); \
+    throw Exception::MemoryLimitError(pstate, traces, (budget).limit); \
+  } \
+
 #define ADD_PROPERTY(type, name)\
 protected:\
   type name##_;\
@@ -43,6 +49,15 @@ public:\
   type name(type name##__) { return name##_ = name##__; }\
 private:
 
+// Like ADD_PROPERTY, but immortal nodes ignore the setter
+#define ADD_GUARDED_PROPERTY(type, name)\
+protected:\
+  type name##_;\
+public:\
+  type name() const        { return name##_; }\
+  type name(type name##__) { if (isImmortal()) return name##_; return name##_ = name##__; }\
+private:
+
 #define HASH_PROPERTY(type, name)\
 protected:\
   type name##_;\
@@ -230,9 +230,6 @@ namespace Sass {
   typedef sass::vector<SelectorListObj> SelectorStack;
   typedef sass::vector<Sass_Import_Entry> ImporterStack;
 
-  // only to switch implementations for testing
-  #define environment_map std::map
-
   // ###########################################################################
   // explicit type conversion functions
   // ###########################################################################
@@ -363,7 +363,8 @@ namespace Sass {
     func_(ptr->func_),
     via_call_(ptr->via_call_),
     cookie_(ptr->cookie_),
-    hash_(ptr->hash_)
+    hash_(ptr->hash_),
+    symbol_(ptr->symbol_)
   { concrete_type(FUNCTION); }
 
   bool Function_Call::operator==(const Expression& rhs) const
@@ -393,6 +394,14 @@ namespace Sass {
     return sname();
   }
 
+  const Symbol& Function_Call::symbol() const
+  {
+    if (symbol_.empty()) {
+      symbol_ = Symbol(Util::normalize_underscores(name()) + "[f]");
+    }
+    return symbol_;
+  }
+
   bool Function_Call::is_css() {
     if (func_) return func_->is_css();
     return false;
@@ -402,17 +411,17 @@ namespace Sass {
   /////////////////////////////////////////////////////////////////////////
 
   Variable::Variable(SourceSpan pstate, sass::string n)
-  : PreValue(pstate), name_(n)
+  : PreValue(pstate), name_(n), symbol_(n)
   { concrete_type(VARIABLE); }
 
   Variable::Variable(const Variable* ptr)
-  : PreValue(ptr), name_(ptr->name_)
+  : PreValue(ptr), name_(ptr->name_), symbol_(ptr->symbol_)
   { concrete_type(VARIABLE); }
 
   bool Variable::operator==(const Expression& rhs) const
   {
     if (auto e = Cast<Variable>(&rhs)) {
-      return name() == e->name();
+      return symbol() == e->symbol();
     }
     return false;
   }
@@ -467,12 +476,16 @@ namespace Sass {
   // cancel out unnecessary units
   void Number::reduce()
   {
+    // immortals are unitless
+    if (isImmortal()) return;
     // apply conversion factor
     value_ *= this->Units::reduce();
   }
 
   void Number::normalize()
   {
+    // immortals are unitless
+    if (isImmortal()) return;
     // apply conversion factor
     value_ *= this->Units::normalize();
   }
@@ -1151,4 +1164,79 @@ namespace Sass {
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
 
+  /////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////
+
+  namespace {
+
+    // Upper bound of the immortal integers
+    const size_t immortal_numbers = 256;
+
+    template <class T>
+    T* make_immortal(T* node)
+    {
+      node->makeImmortal();
+      // cache the hash now, so it is never written
+      // again while being shared between threads
+      node->hash();
+      return node;
+    }
+
+    // Created on first use. Never deleted, as other
+    // static objects might still reference them.
+    struct Immortals {
+      Boolean* bool_false;
+      Boolean* bool_true;
+      Null* null;
+      Number* numbers[immortal_numbers];
+      Immortals()
+      {
+        // Must not live in the region or budget of a compilation
+        MemoryRegionScope suspend_region(nullptr);
+        MemoryBudgetScope suspend_budget(nullptr);
+        SourceSpan pstate(SourceSpan::immortal("[NA]"));
+        bool_false = make_immortal(new Boolean(pstate, false));
+        bool_true = make_immortal(new Boolean(pstate, true));
+        null = make_immortal(new Null(pstate));
+        for (size_t i = 0; i < immortal_numbers; i++) {
+          numbers[i] = make_immortal(new Number(pstate, (double)i));
+        }
+      }
+    };
+
+    const Immortals& immortals()
+    {
+      static const Immortals* instance = new Immortals();
+      return *instance;
+    }
+
+  }
+
+  Boolean* immortal_boolean(bool value)
+  {
+    return value ? immortals().bool_true : immortals().bool_false;
+  }
+
+  Null* immortal_null()
+  {
+    return immortals().null;
+  }
+
+  Number* make_number(SourceSpan pstate, double value, const sass::string& unit)
+  {
+    if (unit.empty() && value >= 0 && value < immortal_numbers &&
+        value == std::floor(value) && !std::signbit(value)) {
+      return immortals().numbers[(size_t)value];
+    }
+    return SASS_MEMORY_NEW(Number, pstate, value, unit);
+  }
+
+  Expression* mortal_copy(Expression* value, const SourceSpan& pstate)
+  {
+    if (value == nullptr || !value->isImmortal()) return value;
+    Expression* copy = SASS_MEMORY_COPY(value);
+    copy->pstate(pstate);
+    return copy;
+  }
+
 }
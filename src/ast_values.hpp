@@ -163,6 +163,8 @@ namespace Sass {
     ADD_PROPERTY(bool, via_call)
     ADD_PROPERTY(void*, cookie)
     mutable size_t hash_;
+    // Key of the definition (created on first use)
+    mutable Symbol symbol_;
   public:
     Function_Call(SourceSpan pstate, sass::string n, Arguments_Obj args, void* cookie);
     Function_Call(SourceSpan pstate, sass::string n, Arguments_Obj args, Function_Obj func);
@@ -173,6 +175,7 @@ namespace Sass {
     Function_Call(SourceSpan pstate, String_Obj n, Arguments_Obj args);
 
     sass::string name() const;
+    const Symbol& symbol() const;
     bool is_css();
 
     bool operator==(const Expression& rhs) const override;
@@ -188,8 +191,11 @@ namespace Sass {
   ///////////////////////
   class Variable final : public PreValue {
     ADD_CONSTREF(sass::string, name)
+    // Interned name for lookups
+    Symbol symbol_;
   public:
     Variable(SourceSpan pstate, sass::string n);
+    const Symbol& symbol() const { return symbol_; }
     virtual bool operator==(const Expression& rhs) const override;
     virtual size_t hash() const override;
     ATTACH_AST_OPERATIONS(Variable)
@@ -201,7 +207,7 @@ namespace Sass {
   ////////////////////////////////////////////////
   class Number final : public Value, public Units {
     HASH_PROPERTY(double, value)
-    ADD_PROPERTY(bool, zero)
+    ADD_GUARDED_PROPERTY(bool, zero)
     mutable size_t hash_;
   public:
     Number(SourceSpan pstate, double val, sass::string u = "", bool zero = true);
@@ -493,6 +499,19 @@ namespace Sass {
     ATTACH_CRTP_PERFORM_METHODS()
   };
 
+  /////////////////////////////////////////////////////////////////////////
+  // Immortal instances of common constant values. They are shared by all
+  // compilations and threads, are never refcounted and ignore any change
+  // to their flags and source span (see `ADD_GUARDED_PROPERTY`).
+  /////////////////////////////////////////////////////////////////////////
+  Boolean* immortal_boolean(bool value);
+  Null* immortal_null();
+  // Immortal for unitless integers 0..255, else a new number
+  Number* make_number(SourceSpan pstate, double value, const sass::string& unit = "");
+  // Mortal copy of an immortal with the span of the expression that
+  // produced it, so it can be mapped in the output. Else unchanged.
+  Expression* mortal_copy(Expression* value, const SourceSpan& pstate);
+
 }
 
 #endif
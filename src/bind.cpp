@@ -86,7 +86,7 @@ namespace Sass {
                 }
               }
               // assign new arglist to environment
-              env->local_frame()[p->name()] = arglist;
+              env->local_frame()[p->symbol()] = arglist;
             }
           // invalid state
           else {
@@ -96,7 +96,7 @@ namespace Sass {
 
           // expand keyword arguments into their parameters
           List* arglist = SASS_MEMORY_NEW(List, p->pstate(), 0, SASS_COMMA, true);
-          env->local_frame()[p->name()] = arglist;
+          env->local_frame()[p->symbol()] = arglist;
           Map_Obj argmap = Cast<Map>(a->value());
           for (auto key : argmap->keys()) {
             if (String_Constant_Obj str = Cast<String_Constant>(key)) {
@@ -164,7 +164,7 @@ namespace Sass {
             }
           }
           // assign new arglist to environment
-          env->local_frame()[p->name()] = arglist;
+          env->local_frame()[p->symbol()] = arglist;
         }
         // consumed parameter
         ++ip;
@@ -233,7 +233,7 @@ namespace Sass {
             msg << callee << " has no parameter named " << param;
             error(msg.str(), a->pstate(), traces);
           }
-          env->local_frame()[param] = argmap->at(key);
+          env->local_frame()[param_map[param]->symbol()] = argmap->at(key);
         }
         ++ia;
         continue;
@@ -242,14 +242,14 @@ namespace Sass {
       }
 
       if (a->name().empty()) {
-        if (env->has_local(p->name())) {
+        if (env->has_local(p->symbol())) {
           sass::ostream msg;
           msg << "parameter " << p->name()
           << " provided more than once in call to " << callee;
           error(msg.str(), a->pstate(), traces);
         }
         // ordinal arg -- bind it to the next param
-        env->local_frame()[p->name()] = a->value();
+        env->local_frame()[p->symbol()] = a->value();
         ++ip;
       }
       else {
@@ -263,21 +263,24 @@ namespace Sass {
             error(msg.str(), a->pstate(), traces);
           }
         }
-        if (param_map[a->name()]) {
-          if (param_map[a->name()]->is_rest_parameter()) {
+        Parameter* named = param_map[a->name()];
+        if (named) {
+          if (named->is_rest_parameter()) {
             sass::ostream msg;
             msg << "argument " << a->name() << " of " << callee
                 << "cannot be used as named argument";
             error(msg.str(), a->pstate(), traces);
           }
         }
-        if (env->has_local(a->name())) {
+        // reuse the interned name of the parameter
+        const Symbol key(named ? named->symbol() : Symbol(a->name()));
+        if (env->has_local(key)) {
           sass::ostream msg;
           msg << "parameter " << p->name()
               << "provided more than once in call to " << callee;
           error(msg.str(), a->pstate(), traces);
         }
-        env->local_frame()[a->name()] = a->value();
+        env->local_frame()[key] = a->value();
       }
     }
     // EO while ia
@@ -290,13 +293,13 @@ namespace Sass {
       // cerr << "env for default params:" << endl;
       // env->print();
       // cerr << "********" << endl;
-      if (!env->has_local(leftover->name())) {
+      if (!env->has_local(leftover->symbol())) {
         if (leftover->is_rest_parameter()) {
-          env->local_frame()[leftover->name()] = varargs;
+          env->local_frame()[leftover->symbol()] = varargs;
         }
         else if (leftover->default_value()) {
           Expression* dv = leftover->default_value()->perform(eval);
-          env->local_frame()[leftover->name()] = dv;
+          env->local_frame()[leftover->symbol()] = dv;
         }
         else {
           // param is unbound and has no default value -- error
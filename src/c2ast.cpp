@@ -15,10 +15,10 @@ namespace Sass {
     Value* e = NULL;
     switch (sass_value_get_tag(v)) {
       case SASS_BOOLEAN: {
-        e = SASS_MEMORY_NEW(Boolean, pstate, !!sass_boolean_get_value(v));
+        e = immortal_boolean(!!sass_boolean_get_value(v));
       } break;
       case SASS_NUMBER: {
-        e = SASS_MEMORY_NEW(Number, pstate, sass_number_get_value(v), sass_number_get_unit(v));
+        e = make_number(pstate, sass_number_get_value(v), sass_number_get_unit(v));
       } break;
       case SASS_COLOR: {
         e = SASS_MEMORY_NEW(Color_RGBA, pstate, sass_color_get_r(v), sass_color_get_g(v), sass_color_get_b(v), sass_color_get_a(v));
@@ -48,7 +48,7 @@ namespace Sass {
         e = m;
       } break;
       case SASS_NULL: {
-        e = SASS_MEMORY_NEW(Null, pstate);
+        e = immortal_null();
       } break;
       case SASS_ERROR: {
         error("Error in C function: " + sass::string(sass_error_get_message(v)), pstate, traces);
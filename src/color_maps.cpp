@@ -162,7 +162,8 @@ namespace Sass {
   }
 
   namespace Colors {
-    const SourceSpan color_table("[COLOR TABLE]");
+    // shared by all compilations, also at the same time
+    const SourceSpan color_table(SourceSpan::immortal("[COLOR TABLE]"));
     const Color_RGBA aliceblue(color_table, 240, 248, 255, 1);
     const Color_RGBA antiquewhite(color_table, 250, 235, 215, 1);
     const Color_RGBA cyan(color_table, 0, 255, 255, 1);
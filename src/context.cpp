@@ -18,6 +18,8 @@
 #include "parser.hpp"
 #include "cssize.hpp"
 #include "source.hpp"
+#include "serializer.hpp"
+#include "prefetch.hpp"
 
 namespace Sass {
   using namespace Constants;
@@ -43,7 +45,12 @@ namespace Sass {
   }
 
   Context::Context(struct Sass_Context& c_ctx)
-  : CWD(File::get_cwd()),
+  // cached nodes may reference our nodes and
+  // prefetched nodes are not in our region
+  : region(c_ctx.memory_region && !c_ctx.stylesheet_cache && !c_ctx.import_prefetch),
+    budget(c_ctx.memory_limit),
+    cached_sheets(c_ctx.stylesheet_cache),
+    CWD(File::get_cwd()),
     c_options(c_ctx),
     entry_path(""),
     head_imports(0),
@@ -54,6 +61,14 @@ namespace Sass {
     strings(),
     resources(),
     sheets(),
+    cache(c_ctx.stylesheet_cache),
+    cached_imports(),
+    directories(),
+    dirs(c_ctx.directory_cache ? c_ctx.directory_cache : &directories),
+    importer_results(),
+    pending_imports(),
+    prefetch(nullptr),
+    selectors(),
     import_stack(),
     callee_stack(),
     traces(),
@@ -115,12 +130,34 @@ namespace Sass {
     sort (c_importers.begin(), c_importers.end(), sort_importers);
   }
 
+  // wait for an asynchronous importer and take over its result
+  static Sass_Import_List wait_import(Sass_Pending_Import_Entry pending)
+  {
+    if (pending == nullptr) return nullptr;
+    Sass_Import_List list;
+    {
+      std::unique_lock<std::mutex> lock(pending->mutex);
+      pending->done.wait(lock, [pending] { return pending->resolved; });
+      list = pending->list;
+    }
+    delete pending;
+    return list;
+  }
+
   Context::~Context()
   {
-    // resources were allocated by malloc
+    // importers may still be working on requests
+    // we did not need (e.g. after an error)
+    for (auto& pending : pending_imports) {
+      sass_delete_import_list(wait_import(pending.second));
+    }
+    pending_imports.clear();
+    // nodes in our region are released in bulk
+    // once all members are gone (see `region`)
+    region.release();
+    // resources were allocated by malloc or mapped
     for (size_t i = 0; i < resources.size(); ++i) {
-      free(resources[i].contents);
-      free(resources[i].srcmap);
+      if (!resources[i].cached) resources[i].release();
     }
     // free all strings we kept alive during compiler execution
     for (size_t n = 0; n < strings.size(); ++n) free(strings[n]);
@@ -222,12 +259,12 @@ namespace Sass {
     // make sure we resolve against an absolute path
     sass::string base_path(rel2abs(import.base_path));
     // first try to resolve the load path relative to the base path
-    sass::vector<Include> vec(resolve_includes(base_path, import.imp_path));
+    sass::vector<Include> vec(resolve_includes(base_path, import.imp_path, dirs));
     // then search in every include path (but only if nothing found yet)
     for (size_t i = 0, S = include_paths.size(); vec.size() == 0 && i < S; ++i)
     {
       // call resolve_includes and individual base path and append all results
-      sass::vector<Include> resolved(resolve_includes(include_paths[i], import.imp_path));
+      sass::vector<Include> resolved(resolve_includes(include_paths[i], import.imp_path, dirs));
       if (resolved.size()) vec.insert(vec.end(), resolved.begin(), resolved.end());
     }
     // return vector
@@ -236,7 +273,9 @@ namespace Sass {
 
   // register include with resolved path and its content
   // memory of the resources will be freed by us on exit
-  void Context::register_resource(const Include& inc, const Resource& res)
+  // a cached sheet is registered the same way, but we
+  // copy its tree and only load the files it imports
+  void Context::register_resource(const Include& inc, const Resource& res, CachedStyleSheet* cached)
   {
 
     // do not parse same resource twice
@@ -272,10 +311,22 @@ namespace Sass {
     // add the entry to the stack
     import_stack.push_back(import);
 
-    // get pointer to the loaded content
-    const char* contents = resources[idx].contents;
-    SourceFileObj source = SASS_MEMORY_NEW(SourceFile,
-      inc.abs_path.c_str(), contents, idx);
+    // reference the loaded content (no copy)
+    // resources outlive the compilation
+    SourceFileObj source;
+    if (cached) {
+      // owns the registered resource
+      cached_sheets.sheets.push_back(cached);
+      source = cached->source;
+      // it keeps the index of the compilation
+      // that read it, so map it to ours
+      emitter.add_shared_source(source, idx);
+    }
+    else {
+      const Resource& loaded = resources[idx];
+      source = SASS_MEMORY_NEW(SourceFile, inc.abs_path.c_str(),
+        SourceBuffer(loaded.contents, loaded.length), idx);
+    }
 
     // create the initial parser state from resource
     SourceSpan pstate(source);
@@ -298,30 +349,70 @@ namespace Sass {
       }
     }
 
-    // create a parser instance from the given c_str buffer
-    Parser p(source, *this, traces);
     // do not yet dispose these buffers
     sass_import_take_source(import);
     sass_import_take_srcmap(import);
-    // then parse the root block
-    Block_Obj root = p.parse();
+    // collect the file imports of this sheet
+    cached_imports.push_back({});
+    // only plain files can be precompiled
+    bool precompile = idx > 0 && c_importers.empty() && c_headers.empty();
+    Block_Obj root;
+    if (cached && !cached->tree.empty()) {
+      // evaluation changes nodes in place, so every
+      // compilation decodes a copy (loads the imports)
+      Deserializer deserializer(*this, source);
+      root = deserializer.deserialize(cached->tree.data(), cached->tree.size());
+    }
+    else if (cached) {
+      // load the same files as the parser did
+      for (const CachedImport& imp : cached->imports) {
+        import_file(imp.importer, imp.pstate);
+      }
+      root = cached->root;
+    }
+    else if (precompile && c_options.load_precompiled) {
+      // loads the imports if successful
+      root = load_precompiled(*this, source);
+    }
+    bool parsed = root.isNull();
+    if (parsed && prefetch) {
+      // queue the imports while parsing and load them afterwards
+      sass::vector<CachedImport> imports;
+      root = prefetch->parse(source, res.indented, imports);
+      for (const CachedImport& imp : imports) {
+        import_file(imp.importer, imp.pstate);
+      }
+    }
+    if (root.isNull()) {
+      // create a parser instance from the given c_str buffer
+      Parser p(source, *this, traces);
+      p.indented_syntax = res.indented;
+      // then parse the root block
+      root = p.parse();
+    }
     // delete memory of current stack frame
     sass_delete_import(import_stack.back());
     // remove current stack frame
     import_stack.pop_back();
     // create key/value pair for ast node
     std::pair<const sass::string, StyleSheet>
-      ast_pair(inc.abs_path, { res, root });
+      ast_pair(inc.abs_path, { res, source, root, std::move(cached_imports.back()) });
+    cached_imports.pop_back();
     // register resulting resource
     sheets.insert(ast_pair);
+    // store the tree for the next compilation
+    // failing to do so is not an error
+    if (parsed && precompile && c_options.write_precompiled) {
+      write_precompiled(sheets.at(inc.abs_path));
+    }
   }
 
   // register include with resolved path and its content
   // memory of the resources will be freed by us on exit
-  void Context::register_resource(const Include& inc, const Resource& res, SourceSpan& prstate)
+  void Context::register_resource(const Include& inc, const Resource& res, SourceSpan& prstate, CachedStyleSheet* cached)
   {
     traces.push_back(Backtrace(prstate));
-    register_resource(inc, res);
+    register_resource(inc, res, cached);
     traces.pop_back();
   }
 
@@ -331,7 +422,8 @@ namespace Sass {
 
     // search for valid imports (ie. partials) on the filesystem
     // this may return more than one valid result (ambiguous imp_path)
-    const sass::vector<Include> resolved(find_includes(imp));
+    const sass::vector<Include> resolved(prefetch ?
+      prefetch->find_includes(imp) : find_includes(imp));
 
     // error nicely on ambiguous imp_path
     if (resolved.size() > 1) {
@@ -350,11 +442,21 @@ namespace Sass {
       bool use_cache = c_importers.size() == 0;
       // use cache for the resource loading
       if (use_cache && sheets.count(resolved[0].abs_path)) return resolved[0];
+      // reuse sheets parsed by other compilations
+      if (use_cache && cache) return load_cached(resolved[0], pstate);
+      // take over the sheet if it was loaded in the background
+      if (prefetch) {
+        if (CachedStyleSheetObj loaded = prefetch->take(resolved[0].abs_path)) {
+          register_resource(resolved[0], loaded->resource, pstate, loaded);
+          return resolved[0];
+        }
+      }
       // try to read the content of the resolved file entry
       // the memory buffer returned must be freed by us!
-      if (char* contents = read_file(resolved[0].abs_path)) {
+      Resource res(read_resource(resolved[0].abs_path, map_files()));
+      if (res.contents) {
         // register the newly resolved file resource
-        register_resource(resolved[0], { contents, 0 }, pstate);
+        register_resource(resolved[0], res, pstate);
         // return resolved entry
         return resolved[0];
       }
@@ -365,7 +467,137 @@ namespace Sass {
 
   }
 
-  void Context::import_url (Import* imp, sass::string load_path, const sass::string& ctx_path) {
+  // Load the resolved file from the stylesheet cache if it is
+  // unchanged and its imports still resolve to the same files.
+  // Otherwise parse it and put the result into the cache.
+  Include Context::load_cached(const Include& inc, SourceSpan pstate)
+  {
+    FileStamp stamp;
+    const sass::string& abs_path(inc.abs_path);
+    if (!get_stamp(abs_path, stamp)) return { inc, "" };
+    if (CachedStyleSheet* cached = cache->find(abs_path, stamp, this)) {
+      // ours until we are destroyed
+      cached_sheets.sheets.push_back(cached);
+      bool valid = true;
+      for (const CachedImport& imp : cached->imports) {
+        const sass::vector<Include> resolved(find_includes(imp.importer));
+        if (resolved.size() != 1 || resolved[0].abs_path != imp.abs_path) {
+          valid = false;
+          break;
+        }
+      }
+      if (valid) {
+        register_resource(inc, cached->resource, pstate, cached);
+        return inc;
+      }
+    }
+    // the memory buffer returned must be freed by us!
+    // not mapped, since the cache keeps it while files change
+    Resource res(read_resource(abs_path, false));
+    if (!res.contents) return { inc, "" };
+    size_t idx = resources.size();
+    register_resource(inc, res, pstate);
+    // encode the tree before we evaluate it
+    sass::string tree;
+    if (!serialize_sheet(sheets.at(abs_path), tree)) return inc;
+    // ownership goes over to the cached sheet
+    resources[idx].cached = true;
+    CachedStyleSheet* sheet = SASS_MEMORY_NEW(CachedStyleSheet,
+      stamp, sheets.at(abs_path), std::move(tree));
+    cached_sheets.sheets.push_back(sheet);
+    cache->insert(abs_path, sheet, this);
+    return inc;
+  }
+
+  // Load a file import of the current sheet or raise an error
+  Include Context::import_file(const Importer& importer, SourceSpan pstate)
+  {
+    Include include(load_import(importer, pstate));
+    if (include.abs_path.empty()) {
+      error("File to import not found or unreadable: " + importer.imp_path + ".", pstate, traces);
+    }
+    // remember the import of the current sheet
+    cached_imports.back().push_back({ importer, include.abs_path, pstate });
+    import_edges.push_back({ importer, include.abs_path, pstate });
+    return include;
+  }
+
+  sass::vector<Sass_Import_Edge>& Context::get_import_graph()
+  {
+    // hash every file only once
+    std::map<const sass::string, uint32_t> hashes;
+    for (size_t i = import_graph.size(); i < import_edges.size(); ++i) {
+      const CachedImport& imp(import_edges[i]);
+      auto hash = hashes.find(imp.abs_path);
+      if (hash == hashes.end()) {
+        const StyleSheet& sheet(sheets.at(imp.abs_path));
+        hash = hashes.insert({ imp.abs_path, content_hash(sheet.contents, sheet.length) }).first;
+      }
+      Sass_Import_Edge edge;
+      edge.importer = imp.importer.ctx_path;
+      edge.imported = imp.abs_path;
+      edge.imp_path = imp.importer.imp_path;
+      edge.line = imp.pstate.getLine();
+      edge.column = imp.pstate.getColumn();
+      edge.hash = hash->second;
+      import_graph.push_back(edge);
+    }
+    return import_graph;
+  }
+
+  bool SelectorSource::operator==(const SelectorSource& rhs) const
+  {
+    return text == rhs.text
+      && pstate.source == rhs.pstate.source
+      && pstate.position == rhs.pstate.position
+      && pstate.offset == rhs.pstate.offset
+      && allow_parent == rhs.allow_parent
+      && chroot == rhs.chroot;
+  }
+
+  size_t SelectorSource::hash(const sass::string& text, const SourceSpan& pstate)
+  {
+    size_t hash = std::hash<sass::string>()(text);
+    hash_combine(hash, pstate.source.ptr());
+    hash_combine(hash, pstate.position);
+    return hash;
+  }
+
+  size_t SelectorSource::Hash::operator()(const SelectorSource& key) const
+  {
+    return SelectorSource::hash(key.text, key.pstate);
+  }
+
+  // Most interpolated selectors evaluate to a new text every time
+  // (e.g. `.a-#{$i}` in a loop), so a text is only cached once it
+  // is seen for the second time. Only the first sighting pays for
+  // the hash, and only repeated ones pay for the clone.
+  SelectorListObj Context::parse_selector(sass::string text, const SourceSpan& pstate,
+    Backtraces traces, bool allow_parent, bool chroot)
+  {
+    size_t hash = SelectorSource::hash(text, pstate);
+    size_t& sighting = selector_sightings[hash % SassSelectorCacheSize];
+    bool repeated = sighting == hash;
+    sighting = hash;
+    if (repeated) {
+      auto it = selectors.find({ text, pstate, allow_parent, chroot });
+      if (it != selectors.end()) return SASS_MEMORY_CLONE(it->second);
+    }
+    // the text is only copied if it will be cached
+    SelectorSource key{ sass::string(), pstate, allow_parent, chroot };
+    bool cache = repeated && selectors.size() < SassSelectorCacheSize;
+    if (cache) key.text = text;
+    ItplFile* source = SASS_MEMORY_NEW(ItplFile, std::move(text), pstate);
+    Parser p(source, *this, traces, allow_parent);
+    SelectorListObj parsed = p.parseSelectorList(chroot);
+    // parse it again next time, so the warnings
+    // are printed every time it is evaluated
+    if (!cache || p.warnings) return parsed;
+    selectors.insert({ std::move(key), parsed });
+    return SASS_MEMORY_CLONE(parsed);
+  }
+
+  void Context::import_url (Import* imp, sass::string load_path, const sass::string& ctx_path, sass::vector<CachedImport>* deferred) {
 
     SourceSpan pstate(imp->pstate());
     sass::string imp_path(unquote(load_path));
@@ -393,11 +625,9 @@ namespace Sass {
     }
     else {
       const Importer importer(imp_path, ctx_path);
-      Include include(load_import(importer, pstate));
-      if (include.abs_path.empty()) {
-        error("File to import not found or unreadable: " + imp_path + ".", pstate, traces);
-      }
-      imp->incs().push_back(include);
+      // deferred imports are loaded later (see `ImportPrefetcher`)
+      if (deferred) imp->incs().push_back(prefetch->defer(importer, pstate, *deferred));
+      else imp->incs().push_back(import_file(importer, pstate));
     }
 
   }
@@ -413,10 +643,9 @@ namespace Sass {
     // process all custom importers (or custom headers)
     for (Sass_Importer_Entry& importer_ent : importers) {
       // int priority = sass_importer_get_priority(importer);
-      Sass_Importer_Fn fn = sass_importer_get_function(importer_ent);
       // skip importer if it returns NULL
       if (Sass_Import_List includes =
-          fn(load_path.c_str(), importer_ent, c_compiler)
+          call_importer(importer_ent, load_path, ctx_path)
       ) {
         // get c pointer copy to iterate over
         Sass_Import_List it_includes = includes;
@@ -432,6 +661,19 @@ namespace Sass {
           Importer importer(uniq_path, ctx_path);
           // query data from the current include
           Sass_Import_Entry include_ent = *it_includes;
+          // reuse the include of an earlier result with the same key
+          // (the buffers are freed with the list, never parsed again)
+          const char* cache_key = sass_import_get_cache_key(include_ent);
+          const char* cache_version = safe_str(sass_import_get_cache_version(include_ent));
+          if (cache_key && !sass_import_get_error_message(include_ent)) {
+            auto cached = importer_results.find(cache_key);
+            if (cached != importer_results.end() && cached->second.version == cache_version) {
+              imp->incs().push_back({ importer, cached->second.include.abs_path });
+              import_edges.push_back({ importer, cached->second.include.abs_path, pstate });
+              ++it_includes;
+              continue;
+            }
+          }
           char* source = sass_import_take_source(include_ent);
           char* srcmap = sass_import_take_srcmap(include_ent);
           size_t line = sass_import_get_error_line(include_ent);
@@ -442,7 +684,7 @@ namespace Sass {
           if (const char* err_message = sass_import_get_error_message(include_ent)) {
             if (source || srcmap) register_resource({ importer, uniq_path }, { source, srcmap }, pstate);
             if (line == sass::string::npos && column == sass::string::npos) error(err_message, pstate, traces);
-            else { error(err_message, { pstate.source, { line, column } }, traces); }
+            else { error(err_message, { pstate.source, pstate.source->getByteOffset({ line, column }) }, traces); }
           }
           // content for import was set
           else if (source) {
@@ -455,6 +697,12 @@ namespace Sass {
             imp->incs().push_back(include);
             // register the resource buffers
             register_resource(include, { source, srcmap }, pstate);
+            import_edges.push_back({ importer, path_key, pstate });
+            // added once parsed, so import loops are still detected
+            if (cache_key) {
+              importer_results.erase(cache_key);
+              importer_results.insert({ cache_key, { cache_version, include } });
+            }
           }
           // only a path was retuned
           // try to load it like normal
@@ -466,7 +714,13 @@ namespace Sass {
             // or resolves the file on the filesystem
             // added and resolved via `add_file`
             // finally stores everything on `imp`
+            size_t incs = imp->incs().size();
             import_url(imp, abs_path, ctx_path);
+            // urls are not loaded and need no cache
+            if (cache_key && imp->incs().size() > incs) {
+              importer_results.erase(cache_key);
+              importer_results.insert({ cache_key, { cache_version, imp->incs().back() } });
+            }
           }
           // move to next
           ++it_includes;
@@ -483,10 +737,49 @@ namespace Sass {
     return has_import;
   }
 
+  // asynchronous importers are waited for
+  Sass_Import_List Context::call_importer(Sass_Importer_Entry importer, const sass::string& load_path, const char* ctx_path)
+  {
+    if (Sass_Importer_Fn fn = sass_importer_get_function(importer)) {
+      return fn(load_path.c_str(), importer, c_compiler);
+    }
+    // may have been requested ahead of time
+    if (!c_importers.empty() && importer == c_importers.front()) {
+      auto it = pending_imports.find({ load_path, ctx_path });
+      if (it != pending_imports.end()) {
+        Sass_Pending_Import_Entry pending = it->second;
+        pending_imports.erase(it);
+        return wait_import(pending);
+      }
+    }
+    Sass_Async_Importer_Fn fn = sass_importer_get_async_function(importer);
+    return wait_import(fn(load_path.c_str(), importer, c_compiler));
+  }
+
+  bool Context::has_async_importer() const
+  {
+    return !c_importers.empty() && sass_importer_get_async_function(c_importers.front());
+  }
+
+  // the later importers are only called if it skips one,
+  // so they are not requested ahead of time
+  void Context::request_imports(const sass::vector<sass::string>& urls, const char* ctx_path)
+  {
+    if (!has_async_importer()) return;
+    Sass_Importer_Entry importer = c_importers.front();
+    Sass_Async_Importer_Fn fn = sass_importer_get_async_function(importer);
+    for (const sass::string& url : urls) {
+      auto key = std::make_pair(url, sass::string(ctx_path));
+      if (pending_imports.count(key)) continue;
+      pending_imports[key] = fn(url.c_str(), importer, c_compiler);
+    }
+  }
+
   void register_function(Context&, Signature sig, Native_Function f, Env* env);
   void register_function(Context&, Signature sig, Native_Function f, size_t arity, Env* env);
   void register_overload_stub(Context&, sass::string name, Env* env);
   void register_built_in_functions(Context&, Env* env);
+  Env* built_in_functions(Context&);
   void register_c_functions(Context&, Env* env, Sass_Function_List);
   void register_c_function(Context&, Env* env, Sass_Function_Entry);
 
@@ -515,7 +808,20 @@ namespace Sass {
     }
     // create a copy of the resulting buffer string
     // this must be freed or taken over by implementor
-    return sass_copy_c_string(emitted.buffer.c_str());
+    char* output = sass_copy_c_string(emitted.buffer.c_str());
+    sample_memory(SASS_MEMORY_RENDERED);
+    return output;
+  }
+
+  void Context::sample_memory(Sass_Memory_Phase phase)
+  {
+    // only sample if requested
+    if (!c_options.memory_stats) return;
+    memory_stats.emplace_back();
+    Sass_Memory_Stats& stats = memory_stats.back();
+    stats.phase = phase;
+    sampleMemory(region, stats.memory);
+    stats.classes = census.counts();
   }
 
   void Context::apply_custom_headers(Block_Obj root, const char* ctx_path, SourceSpan pstate)
@@ -535,30 +841,30 @@ namespace Sass {
     }
   }
 
-  Block_Obj File_Context::parse()
+  void File_Context::load()
   {
 
     // check if entry file is given
-    if (input_path.empty()) return {};
+    if (input_path.empty()) return;
 
     // create absolute path from input filename
     // ToDo: this should be resolved via custom importers
     sass::string abs_path(rel2abs(input_path, CWD));
 
     // try to load the entry file
-    char* contents = read_file(abs_path);
+    Resource res(read_resource(abs_path, map_files()));
 
     // alternatively also look inside each include path folder
     // I think this differs from ruby sass (IMO too late to remove)
-    for (size_t i = 0, S = include_paths.size(); contents == 0 && i < S; ++i) {
+    for (size_t i = 0, S = include_paths.size(); res.contents == 0 && i < S; ++i) {
       // build absolute path for this include path entry
       abs_path = rel2abs(input_path, include_paths[i]);
       // try to load the resulting path
-      contents = read_file(abs_path);
+      res = read_resource(abs_path, map_files());
     }
 
     // abort early if no content could be loaded (various reasons)
-    if (!contents) throw std::runtime_error(
+    if (!res.contents) throw std::runtime_error(
       "File to read not found or unreadable: "
       + std::string(input_path.c_str()));
 
@@ -569,18 +875,38 @@ namespace Sass {
     Sass_Import_Entry import = sass_make_import(
       input_path.c_str(),
       entry_path.c_str(),
-      contents,
+      res.contents,
       0
     );
     // add the entry to the stack
     import_stack.push_back(import);
 
     // create the source entry for file entry
-    register_resource({{ input_path, "." }, abs_path }, { contents, 0 });
+    // imports are loaded meanwhile if enabled
+    {
+      ImportPrefetcher prefetcher(*this);
+      register_resource({{ input_path, "." }, abs_path }, res);
+    }
 
+  }
+
+  Block_Obj File_Context::parse()
+  {
+    load();
     // create root ast tree node
     return compile();
+  }
 
+  sass::vector<sass::string> File_Context::precompile()
+  {
+    load();
+    sass::vector<sass::string> failed;
+    for (const auto& sheet : sheets) {
+      if (!write_precompiled(sheet.second)) {
+        failed.push_back(sheet.first);
+      }
+    }
+    return failed;
   }
 
   Block_Obj Data_Context::parse()
@@ -589,16 +915,6 @@ namespace Sass {
     // check if source string is given
     if (!source_c_str) return {};
 
-    // convert indented sass syntax
-    if(c_options.is_indented_syntax_src) {
-      // call sass2scss to convert the string
-      char * converted = sass2scss(source_c_str,
-        // preserve the structure as much as possible
-        SASS2SCSS_PRETTIFY_1 | SASS2SCSS_KEEP_COMMENT);
-      // replace old source_c_str with converted
-      free(source_c_str); source_c_str = converted;
-    }
-
     // remember entry path (defaults to stdin for string)
     entry_path = input_path.empty() ? "stdin" : input_path;
 
@@ -618,7 +934,13 @@ namespace Sass {
     import_stack.push_back(import);
 
     // register a synthetic resource (path does not really exist, skip in includes)
-    register_resource({{ input_path, "." }, input_path }, { source_c_str, srcmap_c_str });
+    // imports are loaded meanwhile if enabled
+    {
+      ImportPrefetcher prefetcher(*this);
+      Resource res(source_c_str, srcmap_c_str);
+      res.indented = c_options.is_indented_syntax_src;
+      register_resource({{ input_path, "." }, input_path }, res);
+    }
 
     // create root ast tree node
     return compile();
@@ -633,9 +955,8 @@ namespace Sass {
     Block_Obj root = sheets.at(entry_path).root;
     // abort on invalid root
     if (root.isNull()) return {};
-    Env global; // create root environment
-    // register built-in functions on env
-    register_built_in_functions(*this, &global);
+    // create root environment on top of the built-ins
+    Env global(built_in_functions(*this));
     // register custom functions (defined via C-API)
     for (size_t i = 0, S = c_functions.size(); i < S; ++i)
     { register_c_function(*this, &global, c_functions[i]); }
@@ -649,14 +970,17 @@ namespace Sass {
       auto styles = sheet.second;
       check_nesting(styles.root);
     }
+    sample_memory(SASS_MEMORY_PARSED);
     // expand and eval the tree
     root = expand(root);
+    sample_memory(SASS_MEMORY_EXPANDED);
 
     Extension unsatisfied;
     // check that all extends were used
     if (extender.checkForUnsatisfiedExtends(unsatisfied)) {
       throw Exception::UnsatisfiedExtend(traces, unsatisfied);
     }
+    sample_memory(SASS_MEMORY_EXTENDED);
 
     // check nesting
     check_nesting(root);
@@ -667,6 +991,7 @@ namespace Sass {
     // ToDo: maybe we can do this somewhere else?
     Remove_Placeholders remove_placeholders;
     root->perform(&remove_placeholders);
+    sample_memory(SASS_MEMORY_CSSIZED);
 
     // return processed tree
     return root;
@@ -717,7 +1042,7 @@ namespace Sass {
   {
     Definition* def = make_native_function(sig, f, ctx);
     def->environment(env);
-    (*env)[def->name() + "[f]"] = def;
+    env->set_local(def->symbol(), def);
   }
 
   void register_function(Context& ctx, Signature sig, Native_Function f, size_t arity, Env* env)
@@ -726,19 +1051,19 @@ namespace Sass {
     sass::ostream ss;
     ss << def->name() << "[f]" << arity;
     def->environment(env);
-    (*env)[ss.str()] = def;
+    env->set_local(Symbol(ss.str()), def);
   }
 
   void register_overload_stub(Context& ctx, sass::string name, Env* env)
   {
     Definition* stub = SASS_MEMORY_NEW(Definition,
-                                       SourceSpan{ "[built-in function]" },
+                                       SourceSpan::immortal("[built-in function]"),
                                        nullptr,
                                        name,
                                        Parameters_Obj{},
                                        nullptr,
                                        true);
-    (*env)[name + "[f]"] = stub;
+    env->set_local(stub->symbol(), stub);
   }
 
 
@@ -857,7 +1182,63 @@ namespace Sass {
   {
     Definition* def = make_c_function(descr, ctx);
     def->environment(env);
-    (*env)[def->name() + "[f]"] = def;
+    // may shadow a built-in function
+    env->set_local(def->symbol(), def);
+  }
+
+  namespace {
+
+    // Shared between threads, so nothing may
+    // touch the reference counts or the hashes
+    void make_immortal(Expression* value)
+    {
+      if (value == nullptr) return;
+      value->makeImmortal();
+      value->hash();
+      if (List* list = Cast<List>(value)) {
+        for (Expression* item : list->elements()) make_immortal(item);
+      }
+      else if (Unary_Expression* unary = Cast<Unary_Expression>(value)) {
+        make_immortal(unary->operand());
+      }
+    }
+
+    void make_immortal(Definition* def)
+    {
+      def->makeImmortal();
+      if (Parameters* params = def->parameters()) {
+        params->makeImmortal();
+        for (Parameter* param : params->elements()) {
+          param->makeImmortal();
+          make_immortal(param->default_value());
+        }
+      }
+    }
+
+    Env* freeze_built_in_functions(Context& ctx)
+    {
+      // Must not live in the region or budget of a compilation
+      MemoryRegionScope suspend_region(nullptr);
+      MemoryBudgetScope suspend_budget(nullptr);
+      Env* env = new Env();
+      register_built_in_functions(ctx, env);
+      for (auto& entry : env->local_frame()) {
+        make_immortal(Cast<Definition>(entry.second));
+      }
+      env->is_frozen(true);
+      return env;
+    }
+
+  }
+
+  // Built-in functions are the same for every compilation, so their
+  // signatures are only parsed once. The definitions are immortal and
+  // never changed, so all root environments can link to this frame.
+  // Never deleted, as other static objects might still reference it.
+  Env* built_in_functions(Context& ctx)
+  {
+    static Env* frame = freeze_built_in_functions(ctx);
+    return frame;
   }
 
 }
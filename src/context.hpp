@@ -6,29 +6,70 @@
 #include "sass.hpp"
 #include "ast.hpp"
 
+#include <array>
+#include <unordered_map>
+
 
 #define BUFFERSIZE 255
 #include "b64/encode.h"
 
 #include "sass_context.hpp"
 #include "stylesheet.hpp"
+#include "dependencies.hpp"
 #include "plugins.hpp"
 #include "output.hpp"
 
 namespace Sass {
 
+  class ImportPrefetcher;
+
+  // Evaluated text of a selector. Parsing the same text at the same
+  // span with the same flags always gives the same selector.
+  struct SelectorSource {
+    sass::string text;
+    SourceSpan pstate;
+    bool allow_parent;
+    bool chroot;
+    bool operator==(const SelectorSource& rhs) const;
+    static size_t hash(const sass::string& text, const SourceSpan& pstate);
+    struct Hash { size_t operator()(const SelectorSource& key) const; };
+  };
+
+  // Include of a cacheable custom importer result,
+  // reused for later results with the same version
+  struct CachedImporterResult {
+    sass::string version;
+    Include include;
+  };
+
   class Context {
   public:
-    void import_url (Import* imp, sass::string load_path, const sass::string& ctx_path);
+    void import_url (Import* imp, sass::string load_path, const sass::string& ctx_path, sass::vector<CachedImport>* deferred = nullptr);
     bool call_headers(const sass::string& load_path, const char* ctx_path, SourceSpan& pstate, Import* imp)
     { return call_loader(load_path, ctx_path, pstate, imp, c_headers, false); };
     bool call_importers(const sass::string& load_path, const char* ctx_path, SourceSpan& pstate, Import* imp)
     { return call_loader(load_path, ctx_path, pstate, imp, c_importers, true); };
 
+    // Start the first custom importer on the urls if it is asynchronous,
+    // so they are resolved at the same time. The results are taken once
+    // the importers are called in order (see `call_importer`).
+    void request_imports(const sass::vector<sass::string>& urls, const char* ctx_path);
+    bool has_async_importer() const;
+
   private:
     bool call_loader(const sass::string& load_path, const char* ctx_path, SourceSpan& pstate, Import* imp, sass::vector<Sass_Importer_Entry> importers, bool only_one = true);
+    Sass_Import_List call_importer(Sass_Importer_Entry importer, const sass::string& load_path, const char* ctx_path);
 
   public:
+    // memory region for our nodes (must be
+    // first, so it is destroyed at the end)
+    MemoryRegion region;
+    // bytes we may hold before aborting
+    MemoryBudget budget;
+    // cached sheets used by us (given back to the
+    // cache once all other members are destroyed)
+    CachedStyleSheets cached_sheets;
+
     const sass::string CWD;
     struct Sass_Options& c_options;
     sass::string entry_path;
@@ -44,13 +85,47 @@ namespace Sass {
     sass::vector<char*> strings;
     sass::vector<Resource> resources;
     std::map<const sass::string, StyleSheet> sheets;
+    // stylesheets shared between compilations
+    StyleSheetCache* cache;
+    // whether to memory map files (cached sheets
+    // outlive us, their files may change meanwhile)
+    bool map_files() const { return c_options.map_files && cache == nullptr; }
+    // file imports of the sheets being parsed
+    sass::vector<sass::vector<CachedImport>> cached_imports;
+    // directory listings for the import resolution
+    DirectoryCache directories;
+    // the shared one from the options or ours
+    DirectoryCache* dirs;
+    // results of custom importers by cache key
+    std::unordered_map<sass::string, CachedImporterResult> importer_results;
+    // imports requested from the first custom importer
+    // ahead of time, by load path and importing path
+    std::map<std::pair<sass::string, sass::string>, Sass_Pending_Import_Entry> pending_imports;
+    // loads imports ahead of time (while parsing)
+    ImportPrefetcher* prefetch;
+    // selectors parsed from evaluated text (never changed)
+    std::unordered_map<SelectorSource, SelectorListObj, SelectorSource::Hash> selectors;
+    // hashes of the texts parsed so far by their last digits
+    // (a text is only cached once its hash is found here)
+    std::array<size_t, SassSelectorCacheSize> selector_sightings{};
     ImporterStack import_stack;
     sass::vector<Sass_Callee> callee_stack;
     sass::vector<Backtrace> traces;
     Extender extender;
 
+    // live objects per class and the
+    // statistics sampled after each phase
+    ObjectCensus census;
+    std::vector<Sass_Memory_Stats> memory_stats;
+    void sample_memory(Sass_Memory_Phase phase);
+
     struct Sass_Compiler* c_compiler;
 
+    // every import of a file (once loaded)
+    sass::vector<CachedImport> import_edges;
+    // the same for the c api (see `get_import_graph`)
+    sass::vector<Sass_Import_Edge> import_graph;
+
     // absolute paths to includes
     sass::vector<sass::string> included_files;
     // relative includes for sourcemap
@@ -84,13 +159,23 @@ namespace Sass {
     virtual char* render(Block_Obj root);
     virtual char* render_srcmap();
 
-    void register_resource(const Include&, const Resource&);
-    void register_resource(const Include&, const Resource&, SourceSpan&);
+    void register_resource(const Include&, const Resource&, CachedStyleSheet* cached = nullptr);
+    void register_resource(const Include&, const Resource&, SourceSpan&, CachedStyleSheet* cached = nullptr);
     sass::vector<Include> find_includes(const Importer& import);
     Include load_import(const Importer&, SourceSpan pstate);
+    Include load_cached(const Include&, SourceSpan pstate);
+    Include import_file(const Importer&, SourceSpan pstate);
+
+    // Parse the selector from the evaluated text or copy the one
+    // parsed before from the same source (callers may change it).
+    // Selectors that gave warnings are parsed again every time.
+    SelectorListObj parse_selector(sass::string text, const SourceSpan& pstate,
+      Backtraces traces, bool allow_parent, bool chroot);
 
     Sass_Output_Style output_style() { return c_options.output_style; };
     sass::vector<sass::string> get_included_files(bool skip = false, size_t headers = 0);
+    // all imports with positions and content hashes
+    sass::vector<Sass_Import_Edge>& get_import_graph();
 
   private:
     void collect_plugin_paths(const char* paths_str);
@@ -117,6 +202,13 @@ namespace Sass {
     { }
     virtual ~File_Context();
     virtual Block_Obj parse();
+    // Load the entry and all its imports without compiling
+    // them (which changes the trees) and store their trees
+    // next to the files. Returns the files not stored.
+    sass::vector<sass::string> precompile();
+  private:
+    // load the entry and all its imports
+    void load();
   };
 
   class Data_Context : public Context {
@@ -0,0 +1,92 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include "dependencies.hpp"
+#include "context.hpp"
+#include "MurmurHash2.hpp"
+
+namespace Sass {
+
+  static const uint32_t seed = 0x5A55C0DE;
+
+  uint32_t content_hash(const char* data, size_t size)
+  {
+    return MurmurHash2(data, (int)size, seed);
+  }
+
+  // name of the file as it may be imported, without partial
+  // prefix and extension (an index file is imported by its
+  // directory name)
+  static sass::string import_name(const sass::string& path)
+  {
+    sass::string name(File::base_name(path));
+    size_t dot = name.find_last_of('.');
+    if (dot != sass::string::npos) {
+      sass::string ext(name.substr(dot));
+      if (ext == ".scss" || ext == ".sass" || ext == ".css") name.erase(dot);
+    }
+    if (!name.empty() && name[0] == '_') name.erase(0, 1);
+    if (name == "index") {
+      sass::string dir(File::dir_name(path));
+      if (!dir.empty()) return import_name(dir.substr(0, dir.size() - 1));
+    }
+    return name;
+  }
+
+  void DependencyGraph::add(Context& ctx)
+  {
+    remove(ctx.entry_path);
+    Entry& entry(entries[ctx.entry_path]);
+    const StyleSheet& sheet(ctx.sheets.at(ctx.entry_path));
+    entry.files[ctx.entry_path] = content_hash(sheet.contents, sheet.length);
+    for (const Sass_Import_Edge& edge : ctx.get_import_graph()) {
+      entry.files[edge.imported] = edge.hash;
+      entry.imports.insert(import_name(edge.imp_path));
+    }
+    for (auto& file : entry.files) {
+      dependents[file.first].insert(ctx.entry_path);
+    }
+  }
+
+  void DependencyGraph::remove(const sass::string& entry)
+  {
+    auto it = entries.find(entry);
+    if (it == entries.end()) return;
+    for (auto& file : it->second.files) {
+      auto dependent = dependents.find(file.first);
+      dependent->second.erase(entry);
+      if (dependent->second.empty()) dependents.erase(dependent);
+    }
+    entries.erase(it);
+  }
+
+  const sass::vector<sass::string>& DependencyGraph::find_affected(const sass::vector<sass::string>& changed)
+  {
+    std::set<sass::string> found;
+    for (const sass::string& path : changed) {
+      sass::string abs_path(File::rel2abs(path));
+      auto dependent = dependents.find(abs_path);
+      if (dependent == dependents.end()) {
+        // may shadow or resolve a file we know
+        const sass::string name(import_name(abs_path));
+        for (auto& entry : entries) {
+          if (entry.second.imports.count(name)) found.insert(entry.first);
+        }
+        continue;
+      }
+      sass::string data;
+      bool readable = File::read_bytes(abs_path, data);
+      uint32_t hash = content_hash(data.data(), data.size());
+      for (const sass::string& entry : dependent->second) {
+        // entries may have seen different versions
+        if (!readable || entries.at(entry).files.at(abs_path) != hash) {
+          found.insert(entry);
+        }
+      }
+    }
+    affected.assign(found.begin(), found.end());
+    return affected;
+  }
+
+}
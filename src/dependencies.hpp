@@ -0,0 +1,84 @@
+#ifndef SASS_DEPENDENCIES_H
+#define SASS_DEPENDENCIES_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <map>
+#include <set>
+#include <cstdint>
+#include "file.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // hash of file contents to detect real changes
+  uint32_t content_hash(const char* data, size_t size);
+
+  // An import of one file by another
+  struct ImportEdge {
+    // absolute path of the importing file
+    sass::string importer;
+    // absolute path of the imported file
+    sass::string imported;
+    // path as found in the import statement
+    sass::string imp_path;
+    // position of the import statement
+    size_t line;
+    size_t column;
+    // of the imported contents
+    uint32_t hash;
+  };
+
+  // Imports of many compilations by their entry point. Used to find
+  // the entry points that must be compiled again after files have
+  // changed. Unchanged imports can then be taken from a stylesheet
+  // cache (see `StyleSheetCache`). Not safe to use from many threads.
+  class DependencyGraph {
+
+    private:
+
+      struct Entry {
+        // content hash of every loaded file
+        std::map<const sass::string, uint32_t> files;
+        // paths as found in import statements
+        std::set<sass::string> imports;
+      };
+
+      // by entry path (see `Context::entry_path`)
+      std::map<const sass::string, Entry> entries;
+      // entry points that include a file
+      std::map<const sass::string, std::set<sass::string>> dependents;
+      // result of the last `find_affected`
+      sass::vector<sass::string> affected;
+
+    public:
+
+      // Record the imports of the parsed compilation for its entry
+      // point, replacing the ones of an earlier compilation
+      void add(Context& ctx);
+      // Forget the entry point
+      void remove(const sass::string& entry);
+
+      // Find the entry points that must be compiled again after the
+      // files have changed (also created or deleted). Files with the
+      // same contents as recorded are ignored. Created files affect
+      // all entry points with an import that may resolve to them.
+      const sass::vector<sass::string>& find_affected(const sass::vector<sass::string>& changed);
+
+      // number of entry points
+      size_t size() const { return entries.size(); }
+      // entry points found by `find_affected`
+      const sass::vector<sass::string>& get_affected() const { return affected; }
+
+  };
+
+}
+
+// handles for the c api
+struct Sass_Import_Edge : Sass::ImportEdge {};
+struct Sass_Dependency_Graph : Sass::DependencyGraph {};
+
+#endif
@@ -41,6 +41,9 @@ namespace Sass {
   void Emitter::add_source_index(size_t idx)
   { wbuf.smap.source_index.push_back(idx); }
 
+  void Emitter::add_shared_source(const SourceData* source, size_t idx)
+  { wbuf.smap.shared_ids[source] = idx; }
+
   sass::string Emitter::render_srcmap(Context &ctx)
   { return wbuf.smap.render_srcmap(ctx); }
 
@@ -53,8 +56,6 @@ namespace Sass {
   { wbuf.smap.add_open_mapping(node); }
   void Emitter::add_close_mapping(const AST_Node* node)
   { wbuf.smap.add_close_mapping(node); }
-  SourceSpan Emitter::remap(const SourceSpan& pstate)
-  { return wbuf.smap.remap(pstate); }
 
   // MAIN BUFFER MANIPULATION
 
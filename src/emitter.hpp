@@ -26,12 +26,12 @@ namespace Sass {
       const OutputBuffer output(void) { return wbuf; }
       // proxy methods for source maps
       void add_source_index(size_t idx);
+      void add_shared_source(const SourceData* source, size_t idx);
       void set_filename(const sass::string& str);
       void add_open_mapping(const AST_Node* node);
       void add_close_mapping(const AST_Node* node);
       void schedule_mapping(const AST_Node* node);
       sass::string render_srcmap(Context &ctx);
-      SourceSpan remap(const SourceSpan& pstate);
 
     public:
       struct Sass_Output_Options& opt;
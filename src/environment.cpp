@@ -4,20 +4,86 @@
 
 namespace Sass {
 
+  template <typename T>
+  const typename EnvFrame<T>::Slot& EnvFrame<T>::at(size_t slot) const
+  {
+    if (slot < local_slots) return local_[slot];
+    slot -= local_slots;
+    return chunks_[slot / SassEnvChunkSize][slot % SassEnvChunkSize];
+  }
+
+  template <typename T>
+  typename EnvFrame<T>::Slot& EnvFrame<T>::at(size_t slot)
+  {
+    return const_cast<Slot&>(static_cast<const EnvFrame&>(*this).at(slot));
+  }
+
+  template <typename T>
+  size_t EnvFrame<T>::lookup(const Symbol& key) const
+  {
+    if (index_.empty()) {
+      for (size_t i = 0; i < size_; ++i) {
+        if (at(i).first == key) return i;
+      }
+      return sass::string::npos;
+    }
+    auto it = index_.find(key);
+    return it == index_.end() ? sass::string::npos : it->second;
+  }
+
+  template <typename T>
+  size_t EnvFrame<T>::find(const Symbol& key) const
+  {
+    size_t slot = lookup(key);
+    if (slot != sass::string::npos && !at(slot).used) return sass::string::npos;
+    return slot;
+  }
+
+  template <typename T>
+  T& EnvFrame<T>::operator[](const Symbol& key)
+  {
+    size_t slot = lookup(key);
+    if (slot == sass::string::npos) {
+      slot = size_;
+      if (slot >= local_slots && (slot - local_slots) % SassEnvChunkSize == 0) {
+        chunks_.emplace_back(new Slot[SassEnvChunkSize]());
+      }
+      ++size_;
+      at(slot).first = key;
+      if (!index_.empty()) index_[key] = slot;
+      // built once and then kept up to date
+      else if (size_ == SassEnvIndexThreshold) {
+        for (size_t i = 0; i < size_; ++i) index_[at(i).first] = i;
+      }
+    }
+    Slot& entry = at(slot);
+    entry.used = true;
+    return entry.second;
+  }
+
+  template <typename T>
+  void EnvFrame<T>::erase(const Symbol& key)
+  {
+    size_t slot = lookup(key);
+    if (slot == sass::string::npos) return;
+    at(slot).second = T();
+    at(slot).used = false;
+  }
+
   template <typename T>
   Environment<T>::Environment(bool is_shadow)
-  : local_frame_(environment_map<sass::string, T>()),
-    parent_(0), is_shadow_(false)
+  : local_frame_(),
+    parent_(0), is_shadow_(false), is_frozen_(false)
   { }
   template <typename T>
   Environment<T>::Environment(Environment<T>* env, bool is_shadow)
-  : local_frame_(environment_map<sass::string, T>()),
-    parent_(env), is_shadow_(is_shadow)
+  : local_frame_(),
+    parent_(env), is_shadow_(is_shadow), is_frozen_(false)
   { }
   template <typename T>
   Environment<T>::Environment(Environment<T>& env, bool is_shadow)
-  : local_frame_(environment_map<sass::string, T>()),
-    parent_(&env), is_shadow_(is_shadow)
+  : local_frame_(),
+    parent_(&env), is_shadow_(is_shadow), is_frozen_(false)
   { }
 
   // link parent to create a stack
@@ -26,12 +92,19 @@ namespace Sass {
   template <typename T>
   void Environment<T>::link(Environment* env) { parent_ = env; }
 
+  // frozen frames are not part of the stack
+  template <typename T>
+  bool Environment<T>::has_parent() const
+  {
+    return parent_ && !parent_->is_frozen_;
+  }
+
   // this is used to find the global frame
   // which is the second last on the stack
   template <typename T>
   bool Environment<T>::is_lexical() const
   {
-    return !! parent_ && parent_->parent_;
+    return has_parent() && parent_->has_parent();
   }
 
   // only match the real root scope
@@ -41,43 +114,41 @@ namespace Sass {
   template <typename T>
   bool Environment<T>::is_global() const
   {
-    return parent_ && ! parent_->parent_;
+    return has_parent() && ! parent_->has_parent();
   }
 
   template <typename T>
-  environment_map<sass::string, T>& Environment<T>::local_frame() {
+  EnvFrame<T>& Environment<T>::local_frame() {
     return local_frame_;
   }
 
   template <typename T>
-  bool Environment<T>::has_local(const sass::string& key) const
-  { return local_frame_.find(key) != local_frame_.end(); }
+  bool Environment<T>::has_local(const Symbol& key) const
+  { return local_frame_.find(key) != sass::string::npos; }
 
   template <typename T> EnvResult
-  Environment<T>::find_local(const sass::string& key)
+  Environment<T>::find_local(const Symbol& key)
   {
-    auto end = local_frame_.end();
-    auto it = local_frame_.find(key);
-    return EnvResult(it, it != end);
+    return EnvResult(&local_frame_, local_frame_.find(key));
   }
 
   template <typename T>
-  T& Environment<T>::get_local(const sass::string& key)
+  T& Environment<T>::get_local(const Symbol& key)
   { return local_frame_[key]; }
 
   template <typename T>
-  void Environment<T>::set_local(const sass::string& key, const T& val)
+  void Environment<T>::set_local(const Symbol& key, const T& val)
   {
     local_frame_[key] = val;
   }
   template <typename T>
-  void Environment<T>::set_local(const sass::string& key, T&& val)
+  void Environment<T>::set_local(const Symbol& key, T&& val)
   {
     local_frame_[key] = val;
   }
 
   template <typename T>
-  void Environment<T>::del_local(const sass::string& key)
+  void Environment<T>::del_local(const Symbol& key)
   { local_frame_.erase(key); }
 
   template <typename T>
@@ -91,30 +162,30 @@ namespace Sass {
   }
 
   template <typename T>
-  bool Environment<T>::has_global(const sass::string& key)
+  bool Environment<T>::has_global(const Symbol& key)
   { return global_env()->has(key); }
 
   template <typename T>
-  T& Environment<T>::get_global(const sass::string& key)
+  T& Environment<T>::get_global(const Symbol& key)
   { return (*global_env())[key]; }
 
   template <typename T>
-  void Environment<T>::set_global(const sass::string& key, const T& val)
+  void Environment<T>::set_global(const Symbol& key, const T& val)
   {
     global_env()->local_frame_[key] = val;
   }
   template <typename T>
-  void Environment<T>::set_global(const sass::string& key, T&& val)
+  void Environment<T>::set_global(const Symbol& key, T&& val)
   {
     global_env()->local_frame_[key] = val;
   }
 
   template <typename T>
-  void Environment<T>::del_global(const sass::string& key)
+  void Environment<T>::del_global(const Symbol& key)
   { global_env()->local_frame_.erase(key); }
 
   template <typename T>
-  Environment<T>* Environment<T>::lexical_env(const sass::string& key)
+  Environment<T>* Environment<T>::lexical_env(const Symbol& key)
   {
     Environment* cur = this;
     while (cur) {
@@ -130,7 +201,7 @@ namespace Sass {
   // move down the stack but stop before we
   // reach the global frame (is not included)
   template <typename T>
-  bool Environment<T>::has_lexical(const sass::string& key) const
+  bool Environment<T>::has_lexical(const Symbol& key) const
   {
     auto cur = this;
     while (cur->is_lexical()) {
@@ -144,14 +215,14 @@ namespace Sass {
   // either update already existing lexical value
   // or if flag is set, we create one if no lexical found
   template <typename T>
-  void Environment<T>::set_lexical(const sass::string& key, const T& val)
+  void Environment<T>::set_lexical(const Symbol& key, const T& val)
   {
     Environment<T>* cur = this;
     bool shadow = false;
     while ((cur && cur->is_lexical()) || shadow) {
       EnvResult rv(cur->find_local(key));
       if (rv.found) {
-        rv.it->second = val;
+        rv.value() = val;
         return;
       }
       shadow = cur->is_shadow();
@@ -161,14 +232,14 @@ namespace Sass {
   }
   // this one moves the value
   template <typename T>
-  void Environment<T>::set_lexical(const sass::string& key, T&& val)
+  void Environment<T>::set_lexical(const Symbol& key, T&& val)
   {
     Environment<T>* cur = this;
     bool shadow = false;
     while ((cur && cur->is_lexical()) || shadow) {
       EnvResult rv(cur->find_local(key));
       if (rv.found) {
-        rv.it->second = val;
+        rv.value() = val;
         return;
       }
       shadow = cur->is_shadow();
@@ -180,7 +251,7 @@ namespace Sass {
   // look on the full stack for key
   // include all scopes available
   template <typename T>
-  bool Environment<T>::has(const sass::string& key) const
+  bool Environment<T>::has(const Symbol& key) const
   {
     auto cur = this;
     while (cur) {
@@ -195,7 +266,7 @@ namespace Sass {
   // look on the full stack for key
   // include all scopes available
   template <typename T> EnvResult
-  Environment<T>::find(const sass::string& key)
+  Environment<T>::find(const Symbol& key)
   {
     auto cur = this;
     while (true) {
@@ -208,13 +279,12 @@ namespace Sass {
 
   // use array access for getter and setter functions
   template <typename T>
-  T& Environment<T>::get(const sass::string& key)
+  T& Environment<T>::get(const Symbol& key)
   {
     auto cur = this;
     while (cur) {
-      if (cur->has_local(key)) {
-        return cur->get_local(key);
-      }
+      EnvResult rv(cur->find_local(key));
+      if (rv.found) return rv.value();
       cur = cur->parent_;
     }
     return get_local(key);
@@ -222,13 +292,12 @@ namespace Sass {
 
   // use array access for getter and setter functions
   template <typename T>
-  T& Environment<T>::operator[](const sass::string& key)
+  T& Environment<T>::operator[](const Symbol& key)
   {
     auto cur = this;
     while (cur) {
-      if (cur->has_local(key)) {
-        return cur->get_local(key);
-      }
+      EnvResult rv(cur->find_local(key));
+      if (rv.found) return rv.value();
       cur = cur->parent_;
     }
     return get_local(key);
@@ -241,8 +310,8 @@ namespace Sass {
     size_t indent = 0;
     if (parent_) indent = parent_->print(prefix) + 1;
     std::cerr << prefix << sass::string(indent, ' ') << "== " << this << std::endl;
-    for (typename environment_map<sass::string, T>::iterator i = local_frame_.begin(); i != local_frame_.end(); ++i) {
-      if (!ends_with(i->first, "[f]") && !ends_with(i->first, "[f]4") && !ends_with(i->first, "[f]2")) {
+    for (auto i = local_frame_.begin(); i != local_frame_.end(); ++i) {
+      if (!ends_with(i->first.to_string(), "[f]") && !ends_with(i->first.to_string(), "[f]4") && !ends_with(i->first.to_string(), "[f]2")) {
         std::cerr << prefix << sass::string(indent, ' ') << i->first << " " << i->second;
         if (Value* val = Cast<Value>(i->second))
         { std::cerr << " : " << val->to_string(); }
@@ -254,6 +323,7 @@ namespace Sass {
   #endif
 */
   // compile implementation for AST_Node
+  template class EnvFrame<AST_Node_Obj>;
   template class Environment<AST_Node_Obj>;
 
 }
@@ -5,31 +5,97 @@
 // __EXTENSIONS__ fix on Solaris.
 #include "sass.hpp"
 
-#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include "ast_fwd_decl.hpp"
 #include "ast_def_macros.hpp"
+#include "symbol.hpp"
 
 namespace Sass {
 
+  // Entries of one frame. Most frames only hold a few entries, which
+  // are kept in the frame itself and found by a linear scan over the
+  // symbols. More entries go into chunks of `SassEnvChunkSize` slots,
+  // larger frames (e.g. the global one or the built-in functions)
+  // also get a hash index. Full chunks are never grown, so references
+  // to the values stay valid while entries are added (callers hold on
+  // to them across nested calls). A deleted entry keeps its slot
+  // (without value) for a later set.
+  template <typename T>
+  class EnvFrame {
+  public:
+    struct Slot {
+      Symbol first;
+      T second;
+      bool used;
+    };
+    // also visits deleted entries (with empty values)
+    class iterator {
+      EnvFrame* frame;
+      size_t slot;
+    public:
+      iterator(EnvFrame* frame, size_t slot) : frame(frame), slot(slot) {}
+      Slot& operator*() const { return frame->at(slot); }
+      Slot* operator->() const { return &frame->at(slot); }
+      iterator& operator++() { ++slot; return *this; }
+      bool operator!=(const iterator& other) const { return slot != other.slot; }
+    };
+  private:
+    // frames of calls mostly get a few arguments
+    static const size_t local_slots = 4;
+    Slot local_[local_slots];
+    sass::vector<std::unique_ptr<Slot[]>> chunks_;
+    size_t size_;
+    // slot by symbol (only for larger frames)
+    std::unordered_map<Symbol, size_t> index_;
+    // slot of the symbol, also if deleted
+    size_t lookup(const Symbol& key) const;
+  public:
+    EnvFrame() : local_(), size_(0) {}
+    // slot of the entry or npos
+    size_t find(const Symbol& key) const;
+    // inserts an empty entry if not found
+    T& operator[](const Symbol& key);
+    void erase(const Symbol& key);
+    Slot& at(size_t slot);
+    const Slot& at(size_t slot) const;
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size_); }
+  };
+
   // this defeats the whole purpose of environment being templatable!!
-  typedef environment_map<sass::string, AST_Node_Obj>::iterator EnvIter;
+  typedef EnvFrame<AST_Node_Obj> EnvSlots;
 
   class EnvResult {
     public:
-      EnvIter it;
+      EnvSlots* frame;
+      size_t slot;
       bool found;
     public:
-      EnvResult(EnvIter it, bool found)
-      : it(it), found(found) {}
+      EnvResult(EnvSlots* frame, size_t slot)
+      : frame(frame), slot(slot), found(slot != sass::string::npos) {}
+      // stays valid if the frame gets new entries
+      AST_Node_Obj& value() const { return frame->at(slot).second; }
   };
 
+  // Frames are keyed by interned symbols. Callers on hot paths
+  // should pass symbols they prepared upfront (e.g. `Variable`),
+  // since passing a string has to look it up in the symbol table.
   template <typename T>
   class Environment {
-    // TODO: test with map
-    environment_map<sass::string, T> local_frame_;
+    EnvFrame<T> local_frame_;
     ADD_PROPERTY(Environment*, parent)
     ADD_PROPERTY(bool, is_shadow)
+    // Frozen frames are shared between compilations and never
+    // written to. They don't count as a scope of the stack and
+    // only serve as fallback for lookups (e.g. built-ins).
+    ADD_PROPERTY(bool, is_frozen)
+
+    // parent that counts as a scope of the stack
+    bool has_parent() const;
 
   public:
     Environment(bool is_shadow = false);
@@ -52,62 +118,62 @@ namespace Sass {
 
     // scope operates on the current frame
 
-    environment_map<sass::string, T>& local_frame();
+    EnvFrame<T>& local_frame();
 
-    bool has_local(const sass::string& key) const;
+    bool has_local(const Symbol& key) const;
 
-    EnvResult find_local(const sass::string& key);
+    EnvResult find_local(const Symbol& key);
 
-    T& get_local(const sass::string& key);
+    T& get_local(const Symbol& key);
 
     // set variable on the current frame
-    void set_local(const sass::string& key, const T& val);
-    void set_local(const sass::string& key, T&& val);
+    void set_local(const Symbol& key, const T& val);
+    void set_local(const Symbol& key, T&& val);
 
-    void del_local(const sass::string& key);
+    void del_local(const Symbol& key);
 
     // global operates on the global frame
     // which is the second last on the stack
     Environment* global_env();
     // get the env where the variable already exists
     // if it does not yet exist, we return current env
-    Environment* lexical_env(const sass::string& key);
+    Environment* lexical_env(const Symbol& key);
 
-    bool has_global(const sass::string& key);
+    bool has_global(const Symbol& key);
 
-    T& get_global(const sass::string& key);
+    T& get_global(const Symbol& key);
 
     // set a variable on the global frame
-    void set_global(const sass::string& key, const T& val);
-    void set_global(const sass::string& key, T&& val);
+    void set_global(const Symbol& key, const T& val);
+    void set_global(const Symbol& key, T&& val);
 
-    void del_global(const sass::string& key);
+    void del_global(const Symbol& key);
 
     // see if we have a lexical variable
     // move down the stack but stop before we
     // reach the global frame (is not included)
-    bool has_lexical(const sass::string& key) const;
+    bool has_lexical(const Symbol& key) const;
 
     // see if we have a lexical we could update
     // either update already existing lexical value
     // or we create a new one on the current frame
-    void set_lexical(const sass::string& key, T&& val);
-    void set_lexical(const sass::string& key, const T& val);
+    void set_lexical(const Symbol& key, T&& val);
+    void set_lexical(const Symbol& key, const T& val);
 
     // look on the full stack for key
     // include all scopes available
-    bool has(const sass::string& key) const;
+    bool has(const Symbol& key) const;
 
     // look on the full stack for key
     // include all scopes available
-    T& get(const sass::string& key);
+    T& get(const Symbol& key);
 
     // look on the full stack for key
     // include all scopes available
-    EnvResult find(const sass::string& key);
+    EnvResult find(const Symbol& key);
 
     // use array access for getter and setter functions
-    T& operator[](const sass::string& key);
+    T& operator[](const Symbol& key);
 
     #ifdef DEBUG
     size_t print(sass::string prefix = "");
@@ -60,6 +60,14 @@ namespace Sass {
     : Base(pstate, msg, traces)
     { }
 
+    MemoryLimitError::MemoryLimitError(SourceSpan pstate, Backtraces traces, size_t limit)
+    : Base(pstate, def_msg, traces)
+    {
+      sass::ostream stm;
+      stm << "Memory limit of " << limit << " bytes exceeded";
+      msg = stm.str();
+    }
+
     DuplicateKeyError::DuplicateKeyError(Backtraces traces, const Map& dup, const Expression& org)
     : Base(org.pstate(), def_msg, traces), dup(dup), org(org)
     {
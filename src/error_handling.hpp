@@ -96,6 +96,12 @@ namespace Sass {
         virtual ~NestingLimitError() throw() {};
     };
 
+    class MemoryLimitError : public Base {
+      public:
+        MemoryLimitError(SourceSpan pstate, Backtraces traces, size_t limit);
+        virtual ~MemoryLimitError() throw() {};
+    };
+
     class DuplicateKeyError : public Base {
       protected:
         const Map& dup;
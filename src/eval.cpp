@@ -35,6 +35,14 @@
 
 namespace Sass {
 
+  // Environment keys of functions with special handling
+  static const Symbol AnyFunction("*[f]");
+  static const Symbol CallFunction("call[f]");
+  static const Symbol IfFunction("if[f]");
+  static const Symbol WarnFunction("@warn[f]");
+  static const Symbol ErrorFunction("@error[f]");
+  static const Symbol DebugFunction("@debug[f]");
+
   Eval::Eval(Expand& exp)
   : exp(exp),
     ctx(exp.ctx),
@@ -43,8 +51,8 @@ namespace Sass {
     is_in_comment(false),
     is_in_selector_schema(false)
   {
-    bool_true = SASS_MEMORY_NEW(Boolean, "[NA]", true);
-    bool_false = SASS_MEMORY_NEW(Boolean, "[NA]", false);
+    bool_true = immortal_boolean(true);
+    bool_false = immortal_boolean(false);
   }
   Eval::~Eval() { }
 
@@ -82,6 +90,7 @@ namespace Sass {
   {
     Expression* val = 0;
     for (size_t i = 0, L = b->length(); i < L; ++i) {
+      MEMORY_GUARD(ctx.budget, b->at(i)->pstate());
       val = b->at(i)->perform(this);
       if (val) return val;
     }
@@ -91,12 +100,12 @@ namespace Sass {
   Expression* Eval::operator()(Assignment* a)
   {
     Env* env = environment();
-    sass::string var(a->variable());
+    const Symbol& var(a->symbol());
     if (a->is_global()) {
       if (!env->has_global(var)) {
         deprecated(
           "!global assignments won't be able to declare new variables in future versions.",
-          "Consider adding `" + var + ": null` at the top level.",
+          "Consider adding `" + a->variable() + ": null` at the top level.",
           true, a->pstate());
       }
       if (a->is_default()) {
@@ -176,7 +185,7 @@ namespace Sass {
   // But iteration vars are reset afterwards
   Expression* Eval::operator()(ForRule* f)
   {
-    sass::string variable(f->variable());
+    const Symbol& variable(f->symbol());
     ExpressionObj low = f->lower_bound()->perform(this);
     if (low->concrete_type() != Expression::NUMBER) {
       traces.push_back(Backtrace(low->pstate()));
@@ -208,7 +217,7 @@ namespace Sass {
       for (double i = start;
            i < end;
            ++i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
+        Number_Obj it = make_number(low->pstate(), i, sass_end->unit());
         env.set_local(variable, it);
         val = body->perform(this);
         if (val) break;
@@ -218,7 +227,7 @@ namespace Sass {
       for (double i = start;
            i > end;
            --i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
+        Number_Obj it = make_number(low->pstate(), i, sass_end->unit());
         env.set_local(variable, it);
         val = body->perform(this);
         if (val) break;
@@ -232,7 +241,7 @@ namespace Sass {
   // But iteration vars are reset afterwards
   Expression* Eval::operator()(EachRule* e)
   {
-    sass::vector<sass::string> variables(e->variables());
+    const sass::vector<Symbol>& variables(e->symbols());
     ExpressionObj expr = e->list()->perform(this);
     Env env(environment(), true);
     env_stack().push_back(&env);
@@ -291,7 +300,7 @@ namespace Sass {
             // https://github.com/sass/libsass/issues/3078
             for (size_t j = 0, K = variables.size(); j < K; ++j) {
               env.set_local(variables[j], j >= scalars->length()
-                ? SASS_MEMORY_NEW(Null, expr->pstate()) : scalars->at(j));
+                ? immortal_null() : scalars->at(j));
             }
           }
         } else {
@@ -299,7 +308,7 @@ namespace Sass {
             env.set_local(variables.at(0), item);
             for (size_t j = 1, K = variables.size(); j < K; ++j) {
               // XXX: this is never hit via spec tests
-              Expression* res = SASS_MEMORY_NEW(Null, expr->pstate());
+              Expression* res = immortal_null();
               env.set_local(variables[j], res);
             }
           }
@@ -344,19 +353,17 @@ namespace Sass {
     Env* env = environment();
 
     // try to use generic function
-    if (env->has("@warn[f]")) {
+    if (env->has(WarnFunction)) {
 
       // add call stack entry
       callee_stack().push_back({
         "@warn",
-        w->pstate().getPath(),
-        w->pstate().getLine(),
-        w->pstate().getColumn(),
+        w->pstate(),
         SASS_CALLEE_FUNCTION,
         { env }
       });
 
-      Definition* def = Cast<Definition>((*env)["@warn[f]"]);
+      Definition* def = Cast<Definition>((*env)[WarnFunction]);
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
@@ -392,19 +399,17 @@ namespace Sass {
     Env* env = environment();
 
     // try to use generic function
-    if (env->has("@error[f]")) {
+    if (env->has(ErrorFunction)) {
 
       // add call stack entry
       callee_stack().push_back({
         "@error",
-        e->pstate().getPath(),
-        e->pstate().getLine(),
-        e->pstate().getColumn(),
+        e->pstate(),
         SASS_CALLEE_FUNCTION,
         { env }
       });
 
-      Definition* def = Cast<Definition>((*env)["@error[f]"]);
+      Definition* def = Cast<Definition>((*env)[ErrorFunction]);
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
@@ -436,19 +441,17 @@ namespace Sass {
     Env* env = environment();
 
     // try to use generic function
-    if (env->has("@debug[f]")) {
+    if (env->has(DebugFunction)) {
 
       // add call stack entry
       callee_stack().push_back({
         "@debug",
-        d->pstate().getPath(),
-        d->pstate().getLine(),
-        d->pstate().getColumn(),
+        d->pstate(),
         SASS_CALLEE_FUNCTION,
         { env }
       });
 
-      Definition* def = Cast<Definition>((*env)["@debug[f]"]);
+      Definition* def = Cast<Definition>((*env)[DebugFunction]);
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
@@ -487,8 +490,8 @@ namespace Sass {
                                 l->length() / 2);
       for (size_t i = 0, L = l->length(); i < L; i += 2)
       {
-        ExpressionObj key = (*l)[i+0]->perform(this);
-        ExpressionObj val = (*l)[i+1]->perform(this);
+        ExpressionObj key = mortal_copy((*l)[i+0]->perform(this), (*l)[i+0]->pstate());
+        ExpressionObj val = mortal_copy((*l)[i+1]->perform(this), (*l)[i+1]->pstate());
         // make sure the color key never displays its real name
         key->is_delayed(true); // verified
         *lm << std::make_pair(key, val);
@@ -511,7 +514,7 @@ namespace Sass {
                                l->is_arglist(),
                                l->is_bracketed());
     for (size_t i = 0, L = l->length(); i < L; ++i) {
-      ll->append((*l)[i]->perform(this));
+      ll->append(mortal_copy((*l)[i]->perform(this), (*l)[i]->pstate()));
     }
     ll->is_interpolant(l->is_interpolant());
     ll->from_selector(l->from_selector());
@@ -534,10 +537,10 @@ namespace Sass {
                                 m->pstate(),
                                 m->length());
     for (auto key : m->keys()) {
-      Expression* ex_key = key->perform(this);
+      Expression* ex_key = mortal_copy(key->perform(this), key->pstate());
       Expression* ex_val = m->at(key);
       if (ex_val == NULL) continue;
-      ex_val = ex_val->perform(this);
+      ex_val = mortal_copy(ex_val->perform(this), ex_val->pstate());
       *mm << std::make_pair(ex_key, ex_val);
     }
 
@@ -799,12 +802,12 @@ namespace Sass {
     // see if it's a relational expression
     try {
       switch(op_type) {
-        case Sass_OP::EQ:  return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::eq(lhs, rhs));
-        case Sass_OP::NEQ: return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::neq(lhs, rhs));
-        case Sass_OP::GT:  return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::gt(lhs, rhs));
-        case Sass_OP::GTE: return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::gte(lhs, rhs));
-        case Sass_OP::LT:  return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::lt(lhs, rhs));
-        case Sass_OP::LTE: return SASS_MEMORY_NEW(Boolean, b->pstate(), Operators::lte(lhs, rhs));
+        case Sass_OP::EQ:  return immortal_boolean(Operators::eq(lhs, rhs));
+        case Sass_OP::NEQ: return immortal_boolean(Operators::neq(lhs, rhs));
+        case Sass_OP::GT:  return immortal_boolean(Operators::gt(lhs, rhs));
+        case Sass_OP::GTE: return immortal_boolean(Operators::gte(lhs, rhs));
+        case Sass_OP::LT:  return immortal_boolean(Operators::lt(lhs, rhs));
+        case Sass_OP::LTE: return immortal_boolean(Operators::lte(lhs, rhs));
         default: break;
       }
     }
@@ -902,9 +905,7 @@ namespace Sass {
   {
     ExpressionObj operand = u->operand()->perform(this);
     if (u->optype() == Unary_Expression::NOT) {
-      Boolean* result = SASS_MEMORY_NEW(Boolean, u->pstate(), (bool)*operand);
-      result->value(!result->value());
-      return result;
+      return immortal_boolean(!(bool)*operand);
     }
     else if (Number_Obj nr = Cast<Number>(operand)) {
       // negate value for minus unary expression
@@ -961,6 +962,7 @@ namespace Sass {
         stm << "Stack depth exceeded max of " << Constants::MaxCallStack;
         error(stm.str(), c->pstate(), traces);
     }
+    MEMORY_GUARD(ctx.budget, c->pstate());
 
     if (Cast<String_Schema>(c->sname())) {
       ExpressionObj evaluated_name = c->sname()->perform(this);
@@ -971,14 +973,14 @@ namespace Sass {
     }
 
     sass::string name(Util::normalize_underscores(c->name()));
-    sass::string full_name(name + "[f]");
+    Symbol full_name(c->symbol());
 
     // we make a clone here, need to implement that further
     Arguments_Obj args = c->arguments();
 
     Env* env = environment();
     if (!env->has(full_name) || (!c->via_call() && Prelexer::re_special_fun(name.c_str()))) {
-      if (!env->has("*[f]")) {
+      if (!env->has(AnyFunction)) {
         for (Argument_Obj arg : args->elements()) {
           if (List_Obj ls = Cast<List>(arg->value())) {
             if (ls->size() == 0) error("() isn't a valid CSS value.", c->pstate(), traces);
@@ -999,15 +1001,15 @@ namespace Sass {
         return str;
       } else {
         // call generic function
-        full_name = "*[f]";
+        full_name = AnyFunction;
       }
     }
 
     // further delay for calls
-    if (full_name != "call[f]") {
+    if (full_name != CallFunction) {
       args->set_delayed(false); // verified
     }
-    if (full_name != "if[f]") {
+    if (full_name != IfFunction) {
       args = Cast<Arguments>(args->perform(this));
     }
     Definition* def = Cast<Definition>((*env)[full_name]);
@@ -1024,9 +1026,9 @@ namespace Sass {
         // arguments before rest argument plus rest
         if (rest) L += rest->length() - 1;
       }
-      ss << full_name << L;
-      full_name = ss.str();
-      sass::string resolved_name(full_name);
+      ss << full_name.c_str() << L;
+      Symbol resolved_name(ss.str());
+      full_name = resolved_name;
       if (!env->has(resolved_name)) error("overloaded function `" + sass::string(c->name()) + "` given wrong number of arguments", c->pstate(), traces);
       def = Cast<Definition>((*env)[resolved_name]);
     }
@@ -1048,9 +1050,7 @@ namespace Sass {
       traces.push_back(Backtrace(c->pstate(), msg));
       callee_stack().push_back({
         c->name().c_str(),
-        c->pstate().getPath(),
-        c->pstate().getLine(),
-        c->pstate().getColumn(),
+        c->pstate(),
         SASS_CALLEE_FUNCTION,
         { env }
       });
@@ -1073,7 +1073,7 @@ namespace Sass {
     // convert call into C-API compatible form
     else if (c_function) {
       Sass_Function_Fn c_func = sass_function_get_function(c_function);
-      if (full_name == "*[f]") {
+      if (full_name == AnyFunction) {
         String_Quoted_Obj str = SASS_MEMORY_NEW(String_Quoted, c->pstate(), c->name());
         Arguments_Obj new_args = SASS_MEMORY_NEW(Arguments, c->pstate());
         new_args->append(SASS_MEMORY_NEW(Argument, c->pstate(), str));
@@ -1088,9 +1088,7 @@ namespace Sass {
       traces.push_back(Backtrace(c->pstate(), msg));
       callee_stack().push_back({
         c->name().c_str(),
-        c->pstate().getPath(),
-        c->pstate().getLine(),
-        c->pstate().getColumn(),
+        c->pstate(),
         SASS_CALLEE_C_FUNCTION,
         { env }
       });
@@ -1099,8 +1097,7 @@ namespace Sass {
       union Sass_Value* c_args = sass_make_list(params->length(), SASS_COMMA, false);
       for(size_t i = 0; i < params->length(); i++) {
         Parameter_Obj param = params->at(i);
-        sass::string key = param->name();
-        AST_Node_Obj node = fn_env.get_local(key);
+        AST_Node_Obj node = fn_env.get_local(param->symbol());
         ExpressionObj arg = Cast<Expression>(node);
         sass_list_set_value(c_args, i, arg->perform(&ast2c));
       }
@@ -1140,9 +1137,8 @@ namespace Sass {
   {
     ExpressionObj value;
     Env* env = environment();
-    const sass::string& name(v->name());
-    EnvResult rv(env->find(name));
-    if (rv.found) value = static_cast<Expression*>(rv.it->second.ptr());
+    EnvResult rv(env->find(v->symbol()));
+    if (rv.found) value = static_cast<Expression*>(rv.value().ptr());
     else error("Undefined variable: \"" + v->name() + "\".", v->pstate(), traces);
     if (Argument* arg = Cast<Argument>(value)) value = arg->value();
     if (Number* nr = Cast<Number>(value)) nr->zero(true); // force flag
@@ -1150,7 +1146,7 @@ namespace Sass {
     if (force) value->is_expanded(false);
     value->set_delayed(false); // verified
     value = value->perform(this);
-    if(!force) rv.it->second = value;
+    if(!force) rv.value() = value;
     return value.detach();
   }
 
@@ -1290,7 +1286,7 @@ namespace Sass {
 
     }
     if (!s->is_interpolant()) {
-      if (s->length() > 1 && res == "") return SASS_MEMORY_NEW(Null, s->pstate());
+      if (s->length() > 1 && res == "") return immortal_null();
       String_Constant_Obj str = SASS_MEMORY_NEW(String_Constant, s->pstate(), res, s->css());
       return str.detach();
     }
@@ -1509,13 +1505,11 @@ namespace Sass {
     ExpressionObj sel = s->contents()->perform(this);
     sass::string result_str(sel->to_string(options()));
     result_str = unquote(Util::rtrim(result_str));
-    ItplFile* source = SASS_MEMORY_NEW(ItplFile,
-      result_str.c_str(), s->pstate());
-    Parser p(source, ctx, traces);
 
     // If a schema contains a reference to parent it is already
     // connected to it, so don't connect implicitly anymore
-    SelectorListObj parsed = p.parseSelectorList(true);
+    SelectorListObj parsed = ctx.parse_selector(
+      std::move(result_str), s->pstate(), traces, true, true);
     flag_is_in_selector_schema.reset();
     return parsed.detach();
   }
@@ -1525,7 +1519,7 @@ namespace Sass {
     if (SelectorListObj pr = exp.original()) {
       return operator()(pr);
     } else {
-      return SASS_MEMORY_NEW(Null, p->pstate());
+      return immortal_null();
     }
   }
 
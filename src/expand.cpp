@@ -20,6 +20,10 @@ namespace Sass {
   // simple endless recursion protection
   const size_t maxRecursion = 500;
 
+  // Environment keys set for every mixin call
+  static const Symbol ContentBlock("@content[m]");
+  static const Symbol InMixin("is_in_mixin");
+
   Expand::Expand(Context& ctx, Env* env, SelectorStack* stack, SelectorStack* originals)
   : ctx(ctx),
     traces(ctx.traces),
@@ -260,7 +264,7 @@ namespace Sass {
     ExpressionObj mq = eval(m->schema());
     sass::string str_mq(mq->to_css(ctx.c_options));
     ItplFile* source = SASS_MEMORY_NEW(ItplFile,
-      str_mq.c_str(), m->pstate());
+      std::move(str_mq), m->pstate());
     Parser parser(source, ctx, traces);
     // Create a new CSS only representation of the media rule
     CssMediaRuleObj css = SASS_MEMORY_NEW(CssMediaRule, m->pstate(), m->block());
@@ -333,6 +337,8 @@ namespace Sass {
     }
     ExpressionObj value = d->value();
     if (value) value = value->perform(&eval);
+    // immortals carry no source span for the output
+    if (value) value = mortal_copy(value, d->value()->pstate());
     Block_Obj bb = ab ? operator()(ab) : NULL;
     if (!bb) {
       if (!value || (value->is_invisible() && !d->is_important())) {
@@ -357,12 +363,12 @@ namespace Sass {
   Statement* Expand::operator()(Assignment* a)
   {
     Env* env = environment();
-    const sass::string& var(a->variable());
+    const Symbol& var(a->symbol());
     if (a->is_global()) {
       if (!env->has_global(var)) {
         deprecated(
           "!global assignments won't be able to declare new variables in future versions.",
-          "Consider adding `" + var + ": null` at the top level.",
+          "Consider adding `" + a->variable() + ": null` at the top level.",
           true, a->pstate());
       }
       if (a->is_default()) {
@@ -523,7 +529,7 @@ namespace Sass {
   // But iteration vars are reset afterwards
   Statement* Expand::operator()(ForRule* f)
   {
-    sass::string variable(f->variable());
+    const Symbol& variable(f->symbol());
     ExpressionObj low = f->lower_bound()->perform(&eval);
     if (low->concrete_type() != Expression::NUMBER) {
       traces.push_back(Backtrace(low->pstate()));
@@ -555,7 +561,7 @@ namespace Sass {
       for (double i = start;
            i < end;
            ++i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
+        Number_Obj it = make_number(low->pstate(), i, sass_end->unit());
         env.set_local(variable, it);
         append_block(body);
       }
@@ -564,7 +570,7 @@ namespace Sass {
       for (double i = start;
            i > end;
            --i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
+        Number_Obj it = make_number(low->pstate(), i, sass_end->unit());
         env.set_local(variable, it);
         append_block(body);
       }
@@ -578,7 +584,7 @@ namespace Sass {
   // But iteration vars are reset afterwards
   Statement* Expand::operator()(EachRule* e)
   {
-    sass::vector<sass::string> variables(e->variables());
+    const sass::vector<Symbol>& variables(e->symbols());
     ExpressionObj expr = e->list()->perform(&eval);
     List_Obj list;
     Map_Obj map;
@@ -637,7 +643,7 @@ namespace Sass {
           } else {
             for (size_t j = 0, K = variables.size(); j < K; ++j) {
               env.set_local(variables[j], j >= scalars->length()
-                ? SASS_MEMORY_NEW(Null, expr->pstate())
+                ? immortal_null()
                 : (*scalars)[j]->perform(&eval));
             }
           }
@@ -645,7 +651,7 @@ namespace Sass {
           if (variables.size() > 0) {
             env.set_local(variables.at(0), item);
             for (size_t j = 1, K = variables.size(); j < K; ++j) {
-              ExpressionObj res = SASS_MEMORY_NEW(Null, expr->pstate());
+              ExpressionObj res = immortal_null();
               env.set_local(variables[j], res);
             }
           }
@@ -744,8 +750,7 @@ namespace Sass {
   {
     Env* env = environment();
     Definition_Obj dd = SASS_MEMORY_COPY(d);
-    env->local_frame()[d->name() +
-                        (d->type() == Definition::MIXIN ? "[m]" : "[f]")] = dd;
+    env->local_frame()[d->symbol()] = dd;
 
     if (d->type() == Definition::FUNCTION && (
       Prelexer::calc_fn_call(d->name().c_str()) ||
@@ -775,7 +780,7 @@ namespace Sass {
     recursions ++;
 
     Env* env = environment();
-    sass::string full_name(c->name() + "[m]");
+    const Symbol& full_name(c->symbol());
     if (!env->has(full_name)) {
       error("no mixin named " + c->name(), c->pstate(), traces);
     }
@@ -792,9 +797,7 @@ namespace Sass {
     traces.push_back(Backtrace(c->pstate(), msg));
     ctx.callee_stack.push_back({
       c->name().c_str(),
-      c->pstate().getPath(),
-      c->pstate().getLine(),
-      c->pstate().getColumn(),
+      c->pstate(),
       SASS_CALLEE_MIXIN,
       { env }
     });
@@ -812,7 +815,7 @@ namespace Sass {
                                           c->block(),
                                           Definition::MIXIN);
       thunk->environment(env);
-      new_env.local_frame()["@content[m]"] = thunk;
+      new_env.local_frame()[ContentBlock] = thunk;
     }
 
     bind(sass::string("Mixin"), c->name(), params, args, &new_env, &eval, traces);
@@ -820,7 +823,7 @@ namespace Sass {
     Block_Obj trace_block = SASS_MEMORY_NEW(Block, c->pstate());
     Trace_Obj trace = SASS_MEMORY_NEW(Trace, c->pstate(), c->name(), trace_block);
 
-    env->set_global("is_in_mixin", bool_true);
+    env->set_global(InMixin, bool_true);
     if (Block* pr = block_stack.back()) {
       trace_block->is_root(pr->is_root());
     }
@@ -833,7 +836,7 @@ namespace Sass {
       if (ith) trace->block()->append(ith);
     }
     block_stack.pop_back();
-    env->del_global("is_in_mixin");
+    env->del_global(InMixin);
 
     ctx.callee_stack.pop_back();
     env_stack.pop_back();
@@ -847,7 +850,7 @@ namespace Sass {
   {
     Env* env = environment();
     // convert @content directives into mixin calls to the underlying thunk
-    if (!env->has("@content[m]")) return 0;
+    if (!env->has(ContentBlock)) return 0;
     Arguments_Obj args = c->arguments();
     if (!args) args = SASS_MEMORY_NEW(Arguments, c->pstate());
 
@@ -866,6 +869,7 @@ namespace Sass {
     if (b->is_root()) call_stack.push_back(b);
     for (size_t i = 0, L = b->length(); i < L; ++i) {
       Statement* stm = b->at(i);
+      MEMORY_GUARD(ctx.budget, stm->pstate());
       Statement_Obj ith = stm->perform(this);
       if (ith) block_stack.back()->append(ith);
     }
@@ -12,8 +12,13 @@
 # define S_ISDIR(mode) (((mode) & S_IFMT) == S_IFDIR)
 #else
 # include <unistd.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <dirent.h>
+# include <errno.h>
 #endif
 #include <cstdio>
+#include <ctime>
 #include <vector>
 #include <algorithm>
 #include <sys/stat.h>
@@ -25,7 +30,6 @@
 #include "error_handling.hpp"
 #include "util.hpp"
 #include "util_string.hpp"
-#include "sass2scss.h"
 
 #ifdef _WIN32
 # include <windows.h>
@@ -101,6 +105,42 @@ namespace Sass {
       #endif
     }
 
+    bool get_stamp(const sass::string& path, FileStamp& stamp)
+    {
+      #ifdef _WIN32
+        wchar_t resolved[32768];
+        // windows unicode filepaths are encoded in utf16
+        sass::string abspath(join_paths(get_cwd(), path));
+        if (!(abspath[0] == '/' && abspath[1] == '/')) {
+          abspath = "//?/" + abspath;
+        }
+        std::wstring wpath(UTF_8::convert_to_utf16(abspath));
+        std::replace(wpath.begin(), wpath.end(), '/', '\\');
+        DWORD rv = GetFullPathNameW(wpath.c_str(), 32767, resolved, NULL);
+        if (rv > 32767) throw Exception::OperationError("Path is too long");
+        if (rv == 0) throw Exception::OperationError("Path could not be resolved");
+        WIN32_FILE_ATTRIBUTE_DATA attrs;
+        if (!GetFileAttributesExW(resolved, GetFileExInfoStandard, &attrs)) return false;
+        if (attrs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) return false;
+        stamp.size = ((uint64_t)attrs.nFileSizeHigh << 32) | attrs.nFileSizeLow;
+        // file times are in 100 nanosecond intervals
+        stamp.mtime = (((int64_t)attrs.ftLastWriteTime.dwHighDateTime << 32)
+          | attrs.ftLastWriteTime.dwLowDateTime) * 100;
+      #else
+        struct stat st;
+        if (stat(path.c_str(), &st) == -1 || S_ISDIR(st.st_mode)) return false;
+        stamp.size = st.st_size;
+        #if defined(__APPLE__)
+          stamp.mtime = st.st_mtimespec.tv_sec * INT64_C(1000000000) + st.st_mtimespec.tv_nsec;
+        #elif defined(__linux__)
+          stamp.mtime = st.st_mtim.tv_sec * INT64_C(1000000000) + st.st_mtim.tv_nsec;
+        #else
+          stamp.mtime = st.st_mtime * INT64_C(1000000000);
+        #endif
+      #endif
+      return true;
+    }
+
     // return if given path is absolute
     // works with *nix and windows paths
     bool is_absolute_path(const sass::string& path)
@@ -341,13 +381,16 @@ namespace Sass {
     // (4) given + extension
     // (5) given + _index.scss
     // (6) given + _index.sass
-    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, const sass::vector<sass::string>& exts)
+    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, DirectoryCache* dirs, const sass::vector<sass::string>& exts)
     {
       sass::string filename = join_paths(root, file);
       // split the filename
       sass::string base(dir_name(file));
       sass::string name(base_name(file));
       sass::vector<Include> includes;
+      auto file_exists = [dirs](const sass::string& path) {
+        return dirs ? dirs->file_exists(path) : File::file_exists(path);
+      };
       // create full path (maybe relative)
       sass::string rel_path(join_paths(base, name));
       sass::string abs_path(join_paths(root, rel_path));
@@ -437,9 +480,19 @@ namespace Sass {
       return sass::string("");
     }
 
+    // check for the extension of the indented syntax
+    static bool is_indented_syntax(const sass::string& path)
+    {
+      sass::string extension;
+      if (path.length() > 5) {
+        extension = path.substr(path.length() - 5, 5);
+      }
+      Util::ascii_str_tolower(&extension);
+      return extension == ".sass";
+    }
+
     // try to load the given filename
     // returned memory must be freed
-    // will auto convert .sass files
     char* read_file(const sass::string& path)
     {
       #ifdef _WIN32
@@ -493,18 +546,90 @@ namespace Sass {
         contents[size] = '\0';
         contents[size + 1] = '\0';
       #endif
-      sass::string extension;
-      if (path.length() > 5) {
-        extension = path.substr(path.length() - 5, 5);
-      }
-      Util::ascii_str_tolower(&extension);
-      if (extension == ".sass" && contents != 0) {
-        char * converted = sass2scss(contents, SASS2SCSS_PRETTIFY_1 | SASS2SCSS_KEEP_COMMENT);
-        free(contents); // free the indented contents
-        return converted; // should be freed by caller
-      } else {
-        return contents;
+      return contents;
+    }
+
+    Resource read_resource(const sass::string& path, bool map)
+    {
+      bool indented = is_indented_syntax(path);
+      #ifndef _WIN32
+        if (map) {
+          int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+          if (fd == -1) return { 0, 0 };
+          struct stat st;
+          if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+            close(fd);
+            return { 0, 0 };
+          }
+          const size_t size = st.st_size;
+          const size_t page = sysconf(_SC_PAGESIZE);
+          // the lexer needs two null bytes after the contents, which
+          // the kernel only provides if the last page is not full
+          // recently modified files may still be written to
+          const bool settled = std::time(nullptr) - st.st_mtime >= SassMappedFileMinAge;
+          if (settled && size >= SassMappedFileMinSize && size % page != 0 && size % page <= page - 2) {
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data != MAP_FAILED) {
+              char* contents = static_cast<char*>(data);
+              // file may have grown after we checked the size
+              if (contents[size] == 0 && contents[size + 1] == 0) {
+                Resource res(contents, 0, size, true);
+                res.indented = indented;
+                return res;
+              }
+              munmap(data, size);
+            }
+          }
+          else {
+            close(fd);
+          }
+        }
+      #endif
+      Resource res(read_file(path), 0);
+      res.indented = indented;
+      return res;
+    }
+
+    bool read_bytes(const sass::string& path, sass::string& data)
+    {
+      #ifdef _WIN32
+        std::wstring wpath(UTF_8::convert_to_utf16(path));
+        FILE* fd = _wfopen(wpath.c_str(), L"rb");
+      #else
+        FILE* fd = std::fopen(path.c_str(), "rb");
+      #endif
+      if (fd == nullptr) return false;
+      char buffer[4096];
+      data.clear();
+      while (size_t read = std::fread(buffer, 1, sizeof(buffer), fd)) {
+        data.append(buffer, read);
       }
+      bool failed = std::ferror(fd) != 0;
+      return std::fclose(fd) == 0 && !failed;
+    }
+
+    bool write_bytes(const sass::string& path, const sass::string& data)
+    {
+      sass::string temp(path + ".tmp");
+      #ifdef _WIN32
+        std::wstring wpath(UTF_8::convert_to_utf16(path));
+        std::wstring wtemp(UTF_8::convert_to_utf16(temp));
+        FILE* fd = _wfopen(wtemp.c_str(), L"wb");
+      #else
+        FILE* fd = std::fopen(temp.c_str(), "wb");
+      #endif
+      if (fd == nullptr) return false;
+      bool written = std::fwrite(data.data(), 1, data.size(), fd) == data.size();
+      written = std::fclose(fd) == 0 && written;
+      #ifdef _WIN32
+        if (written && MoveFileExW(wtemp.c_str(), wpath.c_str(), MOVEFILE_REPLACE_EXISTING)) return true;
+        _wremove(wtemp.c_str());
+      #else
+        if (written && std::rename(temp.c_str(), path.c_str()) == 0) return true;
+        std::remove(temp.c_str());
+      #endif
+      return false;
     }
 
     // split a path string delimited by semicolons or colons (OS dependent)
@@ -528,4 +653,136 @@ namespace Sass {
     }
 
   }
+
+  sass::string DirectoryCache::dir_key(const sass::string& path)
+  {
+    sass::string dir(File::dir_name(path));
+    if (!File::is_absolute_path(dir)) {
+      dir = File::join_paths(File::get_cwd(), dir);
+    }
+    dir = File::make_canonical_path(dir);
+    #if !FS_CASE_SENSITIVE
+      Util::ascii_str_tolower(&dir);
+    #endif
+    return dir;
+  }
+
+  DirectoryCache::Listing DirectoryCache::read_listing(const sass::string& dir)
+  {
+    Listing listing{ true, {} };
+    #ifndef _WIN32
+      DIR* handle = opendir(dir.c_str());
+      if (handle == nullptr) {
+        // nothing can exist in there
+        if (errno == ENOENT || errno == ENOTDIR) listing.unlisted = false;
+        return listing;
+      }
+      while (struct dirent* entry = readdir(handle)) {
+        sass::string name(entry->d_name);
+        #ifdef _DIRENT_HAVE_D_TYPE
+          if (entry->d_type == DT_DIR) continue;
+          if (entry->d_type == DT_REG) {
+            listing.files.insert(name);
+            continue;
+          }
+        #endif
+        // links and unknown types
+        if (File::file_exists(dir + name)) {
+          listing.files.insert(name);
+        }
+      }
+      listing.unlisted = closedir(handle) != 0;
+    #endif
+    return listing;
+  }
+
+  bool DirectoryCache::file_exists(const sass::string& path)
+  {
+    sass::string dir(dir_key(path));
+    sass::string name(File::base_name(path));
+    #if !FS_CASE_SENSITIVE
+      Util::ascii_str_tolower(&name);
+    #endif
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = listings.find(dir);
+    if (it == listings.end()) {
+      // others may probe meanwhile
+      lock.unlock();
+      Listing listing(read_listing(dir));
+      lock.lock();
+      it = listings.insert({ dir, std::move(listing) }).first;
+    }
+    if (it->second.unlisted) {
+      lock.unlock();
+      return File::file_exists(path);
+    }
+    return it->second.files.count(name) != 0;
+  }
+
+  void DirectoryCache::invalidate(const sass::string& path)
+  {
+    sass::string parent(dir_key(path));
+    sass::string dir(dir_key(path + "/"));
+    std::lock_guard<std::mutex> lock(mutex);
+    listings.erase(parent);
+    listings.erase(dir);
+  }
+
+  void DirectoryCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    listings.clear();
+  }
+
+  size_t DirectoryCache::size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return listings.size();
+  }
+
+  bool MappedBytes::read(const sass::string& path)
+  {
+    #ifndef _WIN32
+      int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd == -1) return false;
+      struct stat st;
+      if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+      }
+      if (st.st_size >= SassMappedFileMinSize) {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+          close(fd);
+          mapping = data;
+          length = st.st_size;
+          return true;
+        }
+      }
+      close(fd);
+    #endif
+    if (!File::read_bytes(path, buffer)) return false;
+    length = buffer.size();
+    return true;
+  }
+
+  MappedBytes::~MappedBytes()
+  {
+    #ifndef _WIN32
+      if (mapping) munmap(mapping, length);
+    #endif
+  }
+
+  void Resource::release()
+  {
+    #ifndef _WIN32
+      if (mapped) munmap(contents, length);
+      else free(contents);
+    #else
+      free(contents);
+    #endif
+    free(srcmap);
+    contents = srcmap = 0;
+  }
+
 }
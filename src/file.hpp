@@ -6,13 +6,29 @@
 #include "sass.hpp"
 
 #include <string>
+#include <cstring>
+#include <cstdint>
 #include <vector>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "sass/context.h"
 #include "ast_fwd_decl.hpp"
 
 namespace Sass {
 
+  // detects changes of a file
+  struct FileStamp {
+    // size in bytes
+    size_t size;
+    // last modification (nanoseconds if available)
+    int64_t mtime;
+    bool operator==(const FileStamp& rhs) const {
+      return size == rhs.size && mtime == rhs.mtime;
+    }
+  };
+
   namespace File {
 
     // return the current directory
@@ -22,6 +38,10 @@ namespace Sass {
     // test if path exists and is a file
     bool file_exists(const sass::string& file);
 
+    // get size and modification time of a file
+    // returns false if the file can't be accessed
+    bool get_stamp(const sass::string& file, FileStamp& stamp);
+
     // return if given path is absolute
     // works with *nix and windows paths
     bool is_absolute_path(const sass::string& path);
@@ -65,7 +85,6 @@ namespace Sass {
 
     // try to load the given filename
     // returned memory must be freed
-    // will auto convert .sass files
     char* read_file(const sass::string& file);
 
   }
@@ -106,19 +125,106 @@ namespace Sass {
       char* contents;
       // connected sourcemap
       char* srcmap;
+      // length of the contents
+      size_t length;
+      // contents are memory mapped
+      bool mapped;
+      // owned by a stylesheet cache
+      bool cached;
+      // written in the indented syntax
+      bool indented;
     public:
       Resource(char* contents, char* srcmap)
-      : contents(contents), srcmap(srcmap)
+      : contents(contents), srcmap(srcmap),
+        length(contents ? std::strlen(contents) : 0),
+        mapped(false), cached(false), indented(false)
+      { }
+      Resource(char* contents, char* srcmap, size_t length, bool mapped)
+      : contents(contents), srcmap(srcmap),
+        length(length), mapped(mapped), cached(false), indented(false)
       { }
+      // give back the buffers (only to be called by the owner)
+      void release();
+  };
+
+  // whole contents of a file only ever replaced by renaming another
+  // one over it (see `File::write_bytes`), so the mapping can't be
+  // truncated under us. Bigger files are memory mapped if possible.
+  class MappedBytes {
+    private:
+      // contents if mapped
+      void* mapping;
+      // contents if read
+      sass::string buffer;
+      size_t length;
+    public:
+      MappedBytes() : mapping(nullptr), buffer(), length(0) { }
+      MappedBytes(const MappedBytes&) = delete;
+      MappedBytes& operator=(const MappedBytes&) = delete;
+      ~MappedBytes();
+      // returns false if the file could not be read
+      bool read(const sass::string& file);
+      const char* data() const
+      { return mapping ? static_cast<const char*>(mapping) : buffer.data(); }
+      size_t size() const { return length; }
+  };
+
+  // Regular files per directory, each directory is only read once
+  // to answer all the probes of the import resolution. Listings are
+  // kept until invalidated, so a cache shared between compilations
+  // must be told about created or removed files (e.g. by a watcher).
+  // It is safe to use from many threads.
+  class DirectoryCache {
+    private:
+      struct Listing {
+        // could not be read (probes fall back to stat)
+        bool unlisted;
+        // names of regular files (after symlinks)
+        std::unordered_set<sass::string> files;
+      };
+      std::mutex mutex;
+      // by absolute directory path with trailing slash
+      std::unordered_map<sass::string, Listing> listings;
+      static sass::string dir_key(const sass::string& path);
+      static Listing read_listing(const sass::string& dir);
+    public:
+      // same as `File::file_exists`, but answered from the listing
+      bool file_exists(const sass::string& path);
+      // forget the directory at path and the one containing it
+      void invalidate(const sass::string& path);
+      // forget all directories
+      void clear();
+      // number of directories read
+      size_t size();
   };
 
   namespace File {
 
+    // try to load the given filename into a resource
+    // regular files are memory mapped where possible if `map`
+    // is set (only if asked for: truncating a mapped file
+    // raises SIGBUS, so it must not outlive the compilation)
+    // contents are null if the file could not be read
+    Resource read_resource(const sass::string& file, bool map = false);
+
+    // read the whole file without any conversion
+    // returns false if the file could not be read
+    bool read_bytes(const sass::string& file, sass::string& data);
+
+    // replace the file with the given data (written to
+    // a temporary file first, so readers never see half
+    // of it), returns false if the file was not written
+    bool write_bytes(const sass::string& file, const sass::string& data);
+
+    // probes the files via the directory cache if given
     sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file,
-      const sass::vector<sass::string>& exts = { ".scss", ".sass", ".css" });
+      DirectoryCache* dirs = nullptr, const sass::vector<sass::string>& exts = { ".scss", ".sass", ".css" });
 
   }
 
 }
 
+// handle for the c api
+struct Sass_Directory_Cache : Sass::DirectoryCache {};
+
 #endif
@@ -35,16 +35,16 @@ namespace Sass {
     BUILT_IN(rgb)
     {
       if (
-        string_argument(env["$red"]) ||
-        string_argument(env["$green"]) ||
-        string_argument(env["$blue"])
+        string_argument(env[ARGNAME("$red")]) ||
+        string_argument(env[ARGNAME("$green")]) ||
+        string_argument(env[ARGNAME("$blue")])
       ) {
         return SASS_MEMORY_NEW(String_Constant, pstate, "rgb("
-                                                        + env["$red"]->to_string()
+                                                        + env[ARGNAME("$red")]->to_string()
                                                         + ", "
-                                                        + env["$green"]->to_string()
+                                                        + env[ARGNAME("$green")]->to_string()
                                                         + ", "
-                                                        + env["$blue"]->to_string()
+                                                        + env[ARGNAME("$blue")]->to_string()
                                                         + ")"
         );
       }
@@ -60,19 +60,19 @@ namespace Sass {
     BUILT_IN(rgba_4)
     {
       if (
-        string_argument(env["$red"]) ||
-        string_argument(env["$green"]) ||
-        string_argument(env["$blue"]) ||
-        string_argument(env["$alpha"])
+        string_argument(env[ARGNAME("$red")]) ||
+        string_argument(env[ARGNAME("$green")]) ||
+        string_argument(env[ARGNAME("$blue")]) ||
+        string_argument(env[ARGNAME("$alpha")])
       ) {
         return SASS_MEMORY_NEW(String_Constant, pstate, "rgba("
-                                                        + env["$red"]->to_string()
+                                                        + env[ARGNAME("$red")]->to_string()
                                                         + ", "
-                                                        + env["$green"]->to_string()
+                                                        + env[ARGNAME("$green")]->to_string()
                                                         + ", "
-                                                        + env["$blue"]->to_string()
+                                                        + env[ARGNAME("$blue")]->to_string()
                                                         + ", "
-                                                        + env["$alpha"]->to_string()
+                                                        + env[ARGNAME("$alpha")]->to_string()
                                                         + ")"
         );
       }
@@ -89,12 +89,12 @@ namespace Sass {
     BUILT_IN(rgba_2)
     {
       if (
-        string_argument(env["$color"])
+        string_argument(env[ARGNAME("$color")])
       ) {
         return SASS_MEMORY_NEW(String_Constant, pstate, "rgba("
-                                                        + env["$color"]->to_string()
+                                                        + env[ARGNAME("$color")]->to_string()
                                                         + ", "
-                                                        + env["$alpha"]->to_string()
+                                                        + env[ARGNAME("$alpha")]->to_string()
                                                         + ")"
         );
       }
@@ -102,14 +102,14 @@ namespace Sass {
       Color_RGBA_Obj c_arg = ARG("$color", Color)->toRGBA();
 
       if (
-        string_argument(env["$alpha"])
+        string_argument(env[ARGNAME("$alpha")])
       ) {
         sass::ostream strm;
         strm << "rgba("
                  << (int)c_arg->r() << ", "
                  << (int)c_arg->g() << ", "
                  << (int)c_arg->b() << ", "
-                 << env["$alpha"]->to_string()
+                 << env[ARGNAME("$alpha")]->to_string()
              << ")";
         return SASS_MEMORY_NEW(String_Constant, pstate, strm.str());
       }
@@ -128,21 +128,21 @@ namespace Sass {
     BUILT_IN(red)
     {
       Color_RGBA_Obj color = ARG("$color", Color)->toRGBA();
-      return SASS_MEMORY_NEW(Number, pstate, color->r());
+      return make_number(pstate, color->r());
     }
 
     Signature green_sig = "green($color)";
     BUILT_IN(green)
     {
       Color_RGBA_Obj color = ARG("$color", Color)->toRGBA();
-      return SASS_MEMORY_NEW(Number, pstate, color->g());
+      return make_number(pstate, color->g());
     }
 
     Signature blue_sig = "blue($color)";
     BUILT_IN(blue)
     {
       Color_RGBA_Obj color = ARG("$color", Color)->toRGBA();
-      return SASS_MEMORY_NEW(Number, pstate, color->b());
+      return make_number(pstate, color->b());
     }
 
     Color_RGBA* colormix(Context& ctx, SourceSpan& pstate, Color* color1, Color* color2, double weight) {
@@ -181,16 +181,16 @@ namespace Sass {
     BUILT_IN(hsl)
     {
       if (
-        string_argument(env["$hue"]) ||
-        string_argument(env["$saturation"]) ||
-        string_argument(env["$lightness"])
+        string_argument(env[ARGNAME("$hue")]) ||
+        string_argument(env[ARGNAME("$saturation")]) ||
+        string_argument(env[ARGNAME("$lightness")])
       ) {
         return SASS_MEMORY_NEW(String_Constant, pstate, "hsl("
-                                                        + env["$hue"]->to_string()
+                                                        + env[ARGNAME("$hue")]->to_string()
                                                         + ", "
-                                                        + env["$saturation"]->to_string()
+                                                        + env[ARGNAME("$saturation")]->to_string()
                                                         + ", "
-                                                        + env["$lightness"]->to_string()
+                                                        + env[ARGNAME("$lightness")]->to_string()
                                                         + ")"
         );
       }
@@ -208,19 +208,19 @@ namespace Sass {
     BUILT_IN(hsla)
     {
       if (
-        string_argument(env["$hue"]) ||
-        string_argument(env["$saturation"]) ||
-        string_argument(env["$lightness"]) ||
-        string_argument(env["$alpha"])
+        string_argument(env[ARGNAME("$hue")]) ||
+        string_argument(env[ARGNAME("$saturation")]) ||
+        string_argument(env[ARGNAME("$lightness")]) ||
+        string_argument(env[ARGNAME("$alpha")])
       ) {
         return SASS_MEMORY_NEW(String_Constant, pstate, "hsla("
-                                                        + env["$hue"]->to_string()
+                                                        + env[ARGNAME("$hue")]->to_string()
                                                         + ", "
-                                                        + env["$saturation"]->to_string()
+                                                        + env[ARGNAME("$saturation")]->to_string()
                                                         + ", "
-                                                        + env["$lightness"]->to_string()
+                                                        + env[ARGNAME("$lightness")]->to_string()
                                                         + ", "
-                                                        + env["$alpha"]->to_string()
+                                                        + env[ARGNAME("$alpha")]->to_string()
                                                         + ")"
         );
       }
@@ -307,8 +307,8 @@ namespace Sass {
     BUILT_IN(saturate)
     {
       // CSS3 filter function overload: pass literal through directly
-      if (!Cast<Number>(env["$amount"])) {
-        return SASS_MEMORY_NEW(String_Quoted, pstate, "saturate(" + env["$color"]->to_string(ctx.c_options) + ")");
+      if (!Cast<Number>(env[ARGNAME("$amount")])) {
+        return SASS_MEMORY_NEW(String_Quoted, pstate, "saturate(" + env[ARGNAME("$color")]->to_string(ctx.c_options) + ")");
       }
 
       Color* col = ARG("$color", Color);
@@ -332,7 +332,7 @@ namespace Sass {
     BUILT_IN(grayscale)
     {
       // CSS3 filter function overload: pass literal through directly
-      Number* amount = Cast<Number>(env["$color"]);
+      Number* amount = Cast<Number>(env[ARGNAME("$color")]);
       if (amount) {
         return SASS_MEMORY_NEW(String_Quoted, pstate, "grayscale(" + amount->to_string(ctx.c_options) + ")");
       }
@@ -360,7 +360,7 @@ namespace Sass {
     BUILT_IN(invert)
     {
       // CSS3 filter function overload: pass literal through directly
-      Number* amount = Cast<Number>(env["$color"]);
+      Number* amount = Cast<Number>(env[ARGNAME("$color")]);
       double weight = DARG_U_PRCT("$weight");
       if (amount) {
         // TODO: does not throw on 100% manually passed as value
@@ -386,18 +386,18 @@ namespace Sass {
     Signature opacity_sig = "opacity($color)";
     BUILT_IN(alpha)
     {
-      String_Constant* ie_kwd = Cast<String_Constant>(env["$color"]);
+      String_Constant* ie_kwd = Cast<String_Constant>(env[ARGNAME("$color")]);
       if (ie_kwd) {
         return SASS_MEMORY_NEW(String_Quoted, pstate, "alpha(" + ie_kwd->value() + ")");
       }
 
       // CSS3 filter function overload: pass literal through directly
-      Number* amount = Cast<Number>(env["$color"]);
+      Number* amount = Cast<Number>(env[ARGNAME("$color")]);
       if (amount) {
         return SASS_MEMORY_NEW(String_Quoted, pstate, "opacity(" + amount->to_string(ctx.c_options) + ")");
       }
 
-      return SASS_MEMORY_NEW(Number, pstate, ARG("$color", Color)->a());
+      return make_number(pstate, ARG("$color", Color)->a());
     }
 
     Signature opacify_sig = "opacify($color, $amount)";
@@ -430,13 +430,13 @@ namespace Sass {
     BUILT_IN(adjust_color)
     {
       Color* col = ARG("$color", Color);
-      Number* r = Cast<Number>(env["$red"]);
-      Number* g = Cast<Number>(env["$green"]);
-      Number* b = Cast<Number>(env["$blue"]);
-      Number* h = Cast<Number>(env["$hue"]);
-      Number* s = Cast<Number>(env["$saturation"]);
-      Number* l = Cast<Number>(env["$lightness"]);
-      Number* a = Cast<Number>(env["$alpha"]);
+      Number* r = Cast<Number>(env[ARGNAME("$red")]);
+      Number* g = Cast<Number>(env[ARGNAME("$green")]);
+      Number* b = Cast<Number>(env[ARGNAME("$blue")]);
+      Number* h = Cast<Number>(env[ARGNAME("$hue")]);
+      Number* s = Cast<Number>(env[ARGNAME("$saturation")]);
+      Number* l = Cast<Number>(env[ARGNAME("$lightness")]);
+      Number* a = Cast<Number>(env[ARGNAME("$alpha")]);
 
       bool rgb = r || g || b;
       bool hsl = h || s || l;
@@ -475,13 +475,13 @@ namespace Sass {
     BUILT_IN(scale_color)
     {
       Color* col = ARG("$color", Color);
-      Number* r = Cast<Number>(env["$red"]);
-      Number* g = Cast<Number>(env["$green"]);
-      Number* b = Cast<Number>(env["$blue"]);
-      Number* h = Cast<Number>(env["$hue"]);
-      Number* s = Cast<Number>(env["$saturation"]);
-      Number* l = Cast<Number>(env["$lightness"]);
-      Number* a = Cast<Number>(env["$alpha"]);
+      Number* r = Cast<Number>(env[ARGNAME("$red")]);
+      Number* g = Cast<Number>(env[ARGNAME("$green")]);
+      Number* b = Cast<Number>(env[ARGNAME("$blue")]);
+      Number* h = Cast<Number>(env[ARGNAME("$hue")]);
+      Number* s = Cast<Number>(env[ARGNAME("$saturation")]);
+      Number* l = Cast<Number>(env[ARGNAME("$lightness")]);
+      Number* a = Cast<Number>(env[ARGNAME("$alpha")]);
 
       bool rgb = r || g || b;
       bool hsl = h || s || l;
@@ -529,13 +529,13 @@ namespace Sass {
     BUILT_IN(change_color)
     {
       Color* col = ARG("$color", Color);
-      Number* r = Cast<Number>(env["$red"]);
-      Number* g = Cast<Number>(env["$green"]);
-      Number* b = Cast<Number>(env["$blue"]);
-      Number* h = Cast<Number>(env["$hue"]);
-      Number* s = Cast<Number>(env["$saturation"]);
-      Number* l = Cast<Number>(env["$lightness"]);
-      Number* a = Cast<Number>(env["$alpha"]);
+      Number* r = Cast<Number>(env[ARGNAME("$red")]);
+      Number* g = Cast<Number>(env[ARGNAME("$green")]);
+      Number* b = Cast<Number>(env[ARGNAME("$blue")]);
+      Number* h = Cast<Number>(env[ARGNAME("$hue")]);
+      Number* s = Cast<Number>(env[ARGNAME("$saturation")]);
+      Number* l = Cast<Number>(env[ARGNAME("$lightness")]);
+      Number* a = Cast<Number>(env[ARGNAME("$alpha")]);
 
       bool rgb = r || g || b;
       bool hsl = h || s || l;
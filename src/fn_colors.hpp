@@ -8,16 +8,16 @@ namespace Sass {
   namespace Functions {
 
     // macros for common ranges (u mean unsigned or upper, r for full range)
-    #define DARG_U_FACT(argname) get_arg_r(argname, env, sig, pstate, traces, - 0.0, 1.0) // double
-    #define DARG_R_FACT(argname) get_arg_r(argname, env, sig, pstate, traces, - 1.0, 1.0) // double
-    #define DARG_U_BYTE(argname) get_arg_r(argname, env, sig, pstate, traces, - 0.0, 255.0) // double
-    #define DARG_R_BYTE(argname) get_arg_r(argname, env, sig, pstate, traces, - 255.0, 255.0) // double
-    #define DARG_U_PRCT(argname) get_arg_r(argname, env, sig, pstate, traces, - 0.0, 100.0) // double
-    #define DARG_R_PRCT(argname) get_arg_r(argname, env, sig, pstate, traces, - 100.0, 100.0) // double
+    #define DARG_U_FACT(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 0.0, 1.0) // double
+    #define DARG_R_FACT(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 1.0, 1.0) // double
+    #define DARG_U_BYTE(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 0.0, 255.0) // double
+    #define DARG_R_BYTE(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 255.0, 255.0) // double
+    #define DARG_U_PRCT(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 0.0, 100.0) // double
+    #define DARG_R_PRCT(argname) get_arg_r(ARGNAME(argname), env, sig, pstate, traces, - 100.0, 100.0) // double
 
     // macros for color related inputs (rbg and alpha/opacity values)
-    #define COLOR_NUM(argname) color_num(argname, env, sig, pstate, traces) // double
-    #define ALPHA_NUM(argname) alpha_num(argname, env, sig, pstate, traces) // double
+    #define COLOR_NUM(argname) color_num(ARGNAME(argname), env, sig, pstate, traces) // double
+    #define ALPHA_NUM(argname) alpha_num(ARGNAME(argname), env, sig, pstate, traces) // double
 
     extern Signature rgb_sig;
     extern Signature rgba_4_sig;
@@ -35,36 +35,34 @@ namespace Sass {
     Signature length_sig = "length($list)";
     BUILT_IN(length)
     {
-      if (SelectorList * sl = Cast<SelectorList>(env["$list"])) {
-        return SASS_MEMORY_NEW(Number, pstate, (double) sl->length());
+      if (SelectorList * sl = Cast<SelectorList>(env[ARGNAME("$list")])) {
+        return make_number(pstate, (double) sl->length());
       }
       Expression* v = ARG("$list", Expression);
       if (v->concrete_type() == Expression::MAP) {
-        Map* map = Cast<Map>(env["$list"]);
-        return SASS_MEMORY_NEW(Number, pstate, (double)(map ? map->length() : 1));
+        Map* map = Cast<Map>(env[ARGNAME("$list")]);
+        return make_number(pstate, (double)(map ? map->length() : 1));
       }
       if (v->concrete_type() == Expression::SELECTOR) {
         if (CompoundSelector * h = Cast<CompoundSelector>(v)) {
-          return SASS_MEMORY_NEW(Number, pstate, (double)h->length());
+          return make_number(pstate, (double)h->length());
         } else if (SelectorList * ls = Cast<SelectorList>(v)) {
-          return SASS_MEMORY_NEW(Number, pstate, (double)ls->length());
+          return make_number(pstate, (double)ls->length());
         } else {
-          return SASS_MEMORY_NEW(Number, pstate, 1);
+          return make_number(pstate, 1);
         }
       }
 
-      List* list = Cast<List>(env["$list"]);
-      return SASS_MEMORY_NEW(Number,
-                             pstate,
-                             (double)(list ? list->size() : 1));
+      List* list = Cast<List>(env[ARGNAME("$list")]);
+      return make_number(pstate, (double)(list ? list->size() : 1));
     }
 
     Signature nth_sig = "nth($list, $n)";
     BUILT_IN(nth)
     {
       double nr = ARGVAL("$n");
-      Map* m = Cast<Map>(env["$list"]);
-      if (SelectorList * sl = Cast<SelectorList>(env["$list"])) {
+      Map* m = Cast<Map>(env[ARGNAME("$list")]);
+      if (SelectorList * sl = Cast<SelectorList>(env[ARGNAME("$list")])) {
         size_t len = m ? m->length() : sl->length();
         bool empty = m ? m->empty() : sl->empty();
         if (empty) error("argument `$list` of `" + sass::string(sig) + "` must not be empty", pstate, traces);
@@ -72,7 +70,7 @@ namespace Sass {
         if (index < 0 || index > len - 1) error("index out of bounds for `" + sass::string(sig) + "`", pstate, traces);
         return Cast<Value>(Listize::perform(sl->get(static_cast<int>(index))));
       }
-      List_Obj l = Cast<List>(env["$list"]);
+      List_Obj l = Cast<List>(env[ARGNAME("$list")]);
       if (nr == 0) error("argument `$n` of `" + sass::string(sig) + "` must be non-zero", pstate, traces);
       // if the argument isn't a list, then wrap it in a singleton list
       if (!m && !l) {
@@ -101,8 +99,8 @@ namespace Sass {
     Signature set_nth_sig = "set-nth($list, $n, $value)";
     BUILT_IN(set_nth)
     {
-      Map_Obj m = Cast<Map>(env["$list"]);
-      List_Obj l = Cast<List>(env["$list"]);
+      Map_Obj m = Cast<Map>(env[ARGNAME("$list")]);
+      List_Obj l = Cast<List>(env[ARGNAME("$list")]);
       Number_Obj n = ARG("$n", Number);
       ExpressionObj v = ARG("$value", Expression);
       if (!l) {
@@ -125,8 +123,8 @@ namespace Sass {
     Signature index_sig = "index($list, $value)";
     BUILT_IN(index)
     {
-      Map_Obj m = Cast<Map>(env["$list"]);
-      List_Obj l = Cast<List>(env["$list"]);
+      Map_Obj m = Cast<Map>(env[ARGNAME("$list")]);
+      List_Obj l = Cast<List>(env[ARGNAME("$list")]);
       ExpressionObj v = ARG("$value", Expression);
       if (!l) {
         l = SASS_MEMORY_NEW(List, pstate, 1);
@@ -136,18 +134,18 @@ namespace Sass {
         l = m->to_list(pstate);
       }
       for (size_t i = 0, L = l->length(); i < L; ++i) {
-        if (Operators::eq(l->value_at_index(i), v)) return SASS_MEMORY_NEW(Number, pstate, (double)(i+1));
+        if (Operators::eq(l->value_at_index(i), v)) return make_number(pstate, (double)(i+1));
       }
-      return SASS_MEMORY_NEW(Null, pstate);
+      return immortal_null();
     }
 
     Signature join_sig = "join($list1, $list2, $separator: auto, $bracketed: auto)";
     BUILT_IN(join)
     {
-      Map_Obj m1 = Cast<Map>(env["$list1"]);
-      Map_Obj m2 = Cast<Map>(env["$list2"]);
-      List_Obj l1 = Cast<List>(env["$list1"]);
-      List_Obj l2 = Cast<List>(env["$list2"]);
+      Map_Obj m1 = Cast<Map>(env[ARGNAME("$list1")]);
+      Map_Obj m2 = Cast<Map>(env[ARGNAME("$list2")]);
+      List_Obj l1 = Cast<List>(env[ARGNAME("$list1")]);
+      List_Obj l2 = Cast<List>(env[ARGNAME("$list2")]);
       String_Constant_Obj sep = ARG("$separator", String_Constant);
       enum Sass_Separator sep_val = (l1 ? l1->separator() : SASS_SPACE);
       Value* bracketed = ARG("$bracketed", Value);
@@ -188,10 +186,10 @@ namespace Sass {
     Signature append_sig = "append($list, $val, $separator: auto)";
     BUILT_IN(append)
     {
-      Map_Obj m = Cast<Map>(env["$list"]);
-      List_Obj l = Cast<List>(env["$list"]);
+      Map_Obj m = Cast<Map>(env[ARGNAME("$list")]);
+      List_Obj l = Cast<List>(env[ARGNAME("$list")]);
       ExpressionObj v = ARG("$val", Expression);
-      if (SelectorList * sl = Cast<SelectorList>(env["$list"])) {
+      if (SelectorList * sl = Cast<SelectorList>(env[ARGNAME("$list")])) {
         l = Cast<List>(Listize::perform(sl));
       }
       String_Constant_Obj sep = ARG("$separator", String_Constant);
@@ -262,7 +260,7 @@ namespace Sass {
     Signature list_separator_sig = "list_separator($list)";
     BUILT_IN(list_separator)
     {
-      List_Obj l = Cast<List>(env["$list"]);
+      List_Obj l = Cast<List>(env[ARGNAME("$list")]);
       if (!l) {
         l = SASS_MEMORY_NEW(List, pstate, 1);
         l->append(ARG("$list", Expression));
@@ -277,7 +275,7 @@ namespace Sass {
     {
       ValueObj value = ARG("$list", Value);
       List_Obj list = Cast<List>(value);
-      return SASS_MEMORY_NEW(Boolean, pstate, list && list->is_bracketed());
+      return immortal_boolean(list && list->is_bracketed());
     }
 
   }
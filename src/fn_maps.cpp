@@ -19,11 +19,11 @@ namespace Sass {
       ExpressionObj v = ARG("$key", Expression);
       try {
         ValueObj val = m->at(v);
-        if (!val) return SASS_MEMORY_NEW(Null, pstate);
+        if (!val) return immortal_null();
         val->set_delayed(false);
         return val.detach();
       } catch (const std::out_of_range&) {
-        return SASS_MEMORY_NEW(Null, pstate);
+        return immortal_null();
       }
       catch (...) { throw; }
     }
@@ -33,7 +33,7 @@ namespace Sass {
     {
       Map_Obj m = ARGM("$map", Map);
       ExpressionObj v = ARG("$key", Expression);
-      return SASS_MEMORY_NEW(Boolean, pstate, m->has(v));
+      return immortal_boolean(m->has(v));
     }
 
     Signature map_keys_sig = "map-keys($map)";
@@ -7,7 +7,7 @@ namespace Sass {
 
   namespace Functions {
 
-    #define ARGM(argname, argtype) get_arg_m(argname, env, sig, pstate, traces)
+    #define ARGM(argname, argtype) get_arg_m(ARGNAME(argname), env, sig, pstate, traces)
 
     extern Signature map_get_sig;
     extern Signature map_merge_sig;
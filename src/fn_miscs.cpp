@@ -8,6 +8,10 @@ namespace Sass {
 
   namespace Functions {
 
+    // Environment keys set while expanding mixins
+    static const Symbol InMixin("is_in_mixin");
+    static const Symbol ContentBlock("@content[m]");
+
     //////////////////////////
     // INTROSPECTION FUNCTIONS
     //////////////////////////
@@ -24,11 +28,11 @@ namespace Sass {
     {
       sass::string s = Util::normalize_underscores(unquote(ARG("$name", String_Constant)->value()));
 
-      if(d_env.has("$"+s)) {
-        return SASS_MEMORY_NEW(Boolean, pstate, true);
+      if(d_env.has(Symbol("$"+s))) {
+        return immortal_boolean(true);
       }
       else {
-        return SASS_MEMORY_NEW(Boolean, pstate, false);
+        return immortal_boolean(false);
       }
     }
 
@@ -37,29 +41,29 @@ namespace Sass {
     {
       sass::string s = Util::normalize_underscores(unquote(ARG("$name", String_Constant)->value()));
 
-      if(d_env.has_global("$"+s)) {
-        return SASS_MEMORY_NEW(Boolean, pstate, true);
+      if(d_env.has_global(Symbol("$"+s))) {
+        return immortal_boolean(true);
       }
       else {
-        return SASS_MEMORY_NEW(Boolean, pstate, false);
+        return immortal_boolean(false);
       }
     }
 
     Signature function_exists_sig = "function-exists($name)";
     BUILT_IN(function_exists)
     {
-      String_Constant* ss = Cast<String_Constant>(env["$name"]);
+      String_Constant* ss = Cast<String_Constant>(env[ARGNAME("$name")]);
       if (!ss) {
-        error("$name: " + (env["$name"]->to_string()) + " is not a string for `function-exists'", pstate, traces);
+        error("$name: " + (env[ARGNAME("$name")]->to_string()) + " is not a string for `function-exists'", pstate, traces);
       }
 
       sass::string name = Util::normalize_underscores(unquote(ss->value()));
 
-      if(d_env.has(name+"[f]")) {
-        return SASS_MEMORY_NEW(Boolean, pstate, true);
+      if(d_env.has(Symbol(name+"[f]"))) {
+        return immortal_boolean(true);
       }
       else {
-        return SASS_MEMORY_NEW(Boolean, pstate, false);
+        return immortal_boolean(false);
       }
     }
 
@@ -68,35 +72,37 @@ namespace Sass {
     {
       sass::string s = Util::normalize_underscores(unquote(ARG("$name", String_Constant)->value()));
 
-      if(d_env.has(s+"[m]")) {
-        return SASS_MEMORY_NEW(Boolean, pstate, true);
+      if(d_env.has(Symbol(s+"[m]"))) {
+        return immortal_boolean(true);
       }
       else {
-        return SASS_MEMORY_NEW(Boolean, pstate, false);
+        return immortal_boolean(false);
       }
     }
 
+    // Created on startup, since lazy init would
+    // put it into the region of a compilation
+    static const auto *const features = new std::unordered_set<sass::string> {
+      "global-variable-shadowing",
+      "extend-selector-pseudoclass",
+      "at-error",
+      "units-level-3",
+      "custom-property"
+    };
+
     Signature feature_exists_sig = "feature-exists($feature)";
     BUILT_IN(feature_exists)
     {
       sass::string s = unquote(ARG("$feature", String_Constant)->value());
-
-      static const auto *const features = new std::unordered_set<sass::string> {
-        "global-variable-shadowing",
-        "extend-selector-pseudoclass",
-        "at-error",
-        "units-level-3",
-        "custom-property"
-      };
-      return SASS_MEMORY_NEW(Boolean, pstate, features->find(s) != features->end());
+      return immortal_boolean(features->find(s) != features->end());
     }
 
     Signature call_sig = "call($function, $args...)";
     BUILT_IN(call)
     {
       sass::string function;
-      Function* ff = Cast<Function>(env["$function"]);
-      String_Constant* ss = Cast<String_Constant>(env["$function"]);
+      Function* ff = Cast<Function>(env[ARGNAME("$function")]);
+      String_Constant* ss = Cast<String_Constant>(env[ARGNAME("$function")]);
 
       if (ss) {
         function = Util::normalize_underscores(unquote(ss->value()));
@@ -150,7 +156,7 @@ namespace Sass {
     Signature not_sig = "not($value)";
     BUILT_IN(sass_not)
     {
-      return SASS_MEMORY_NEW(Boolean, pstate, ARG("$value", Expression)->is_false());
+      return immortal_boolean(ARG("$value", Expression)->is_false());
     }
 
     Signature if_sig = "if($condition, $if-true, $if-false)";
@@ -159,7 +165,7 @@ namespace Sass {
       Expand expand(ctx, &d_env, &selector_stack, &original_stack);
       ExpressionObj cond = ARG("$condition", Expression)->perform(&expand.eval);
       bool is_true = !cond->is_false();
-      ExpressionObj res = ARG(is_true ? "$if-true" : "$if-false", Expression);
+      ExpressionObj res = is_true ? ARG("$if-true", Expression) : ARG("$if-false", Expression);
       ValueObj qwe = Cast<Value>(res->perform(&expand.eval));
       // res = res->perform(&expand.eval.val_eval);
       qwe->set_delayed(false); // clone?
@@ -202,22 +208,22 @@ namespace Sass {
     Signature content_exists_sig = "content-exists()";
     BUILT_IN(content_exists)
     {
-      if (!d_env.has_global("is_in_mixin")) {
+      if (!d_env.has_global(InMixin)) {
         error("Cannot call content-exists() except within a mixin.", pstate, traces);
       }
-      return SASS_MEMORY_NEW(Boolean, pstate, d_env.has_lexical("@content[m]"));
+      return immortal_boolean(d_env.has_lexical(ContentBlock));
     }
 
     Signature get_function_sig = "get-function($name, $css: false)";
     BUILT_IN(get_function)
     {
-      String_Constant* ss = Cast<String_Constant>(env["$name"]);
+      String_Constant* ss = Cast<String_Constant>(env[ARGNAME("$name")]);
       if (!ss) {
-        error("$name: " + (env["$name"]->to_string()) + " is not a string for `get-function'", pstate, traces);
+        error("$name: " + (env[ARGNAME("$name")]->to_string()) + " is not a string for `get-function'", pstate, traces);
       }
 
       sass::string name = Util::normalize_underscores(unquote(ss->value()));
-      sass::string full_name = name + "[f]";
+      Symbol full_name(name + "[f]");
 
       Boolean_Obj css = ARG("$css", Boolean);
       if (!css->is_false()) {
@@ -166,7 +166,7 @@ namespace Sass {
     Signature random_sig = "random($limit:false)";
     BUILT_IN(random)
     {
-      AST_Node_Obj arg = env["$limit"];
+      AST_Node_Obj arg = env[ARGNAME("$limit")];
       Value* v = Cast<Value>(arg);
       Number* l = Cast<Number>(arg);
       Boolean* b = Cast<Boolean>(arg);
@@ -185,12 +185,12 @@ namespace Sass {
         }
         std::uniform_real_distribution<> distributor(1, lv + 1);
         uint_fast32_t distributed = static_cast<uint_fast32_t>(distributor(rand));
-        return SASS_MEMORY_NEW(Number, pstate, (double)distributed);
+        return make_number(pstate, (double)distributed);
       }
       else if (b) {
         std::uniform_real_distribution<> distributor(0, 1);
         double distributed = static_cast<double>(distributor(rand));
-        return SASS_MEMORY_NEW(Number, pstate, distributed);
+        return make_number(pstate, distributed);
       } else if (v) {
         traces.push_back(Backtrace(pstate));
         throw Exception::InvalidArgumentType(pstate, traces, "random", "$limit", "number", v);
@@ -223,7 +223,7 @@ namespace Sass {
     {
       Number_Obj arg = ARGN("$number");
       bool unitless = arg->is_unitless();
-      return SASS_MEMORY_NEW(Boolean, pstate, unitless);
+      return immortal_boolean(unitless);
     }
 
     Signature comparable_sig = "comparable($number1, $number2)";
@@ -232,13 +232,13 @@ namespace Sass {
       Number_Obj n1 = ARGN("$number1");
       Number_Obj n2 = ARGN("$number2");
       if (n1->is_unitless() || n2->is_unitless()) {
-        return SASS_MEMORY_NEW(Boolean, pstate, true);
+        return immortal_boolean(true);
       }
       // normalize into main units
       n1->normalize(); n2->normalize();
       Units &lhs_unit = *n1, &rhs_unit = *n2;
       bool is_comparable = (lhs_unit == rhs_unit);
-      return SASS_MEMORY_NEW(Boolean, pstate, is_comparable);
+      return immortal_boolean(is_comparable);
     }
 
   }
@@ -8,7 +8,7 @@ namespace Sass {
   namespace Functions {
 
     // return a number object (copied since we want to have reduced units)
-    #define ARGN(argname) get_arg_n(argname, env, sig, pstate, traces) // Number copy
+    #define ARGN(argname) get_arg_n(ARGNAME(argname), env, sig, pstate, traces) // Number copy
 
     extern Signature percentage_sig;
     extern Signature round_sig;
@@ -36,14 +36,14 @@ namespace Sass {
           str->quote_mark(0);
         }
         sass::string exp_src = exp->to_string(ctx.c_options);
-        ItplFile* source = SASS_MEMORY_NEW(ItplFile, exp_src.c_str(), exp->pstate());
+        ItplFile* source = SASS_MEMORY_NEW(ItplFile, std::move(exp_src), exp->pstate());
         SelectorListObj sel = Parser::parse_selector(source, ctx, traces);
         parsedSelectors.push_back(sel);
       }
 
       // Nothing to do
       if( parsedSelectors.empty() ) {
-        return SASS_MEMORY_NEW(Null, pstate);
+        return immortal_null();
       }
 
       // Set the first element as the `result`, keep
@@ -91,7 +91,7 @@ namespace Sass {
           str->quote_mark(0);
         }
         sass::string exp_src = exp->to_string();
-        ItplFile* source = SASS_MEMORY_NEW(ItplFile, exp_src.c_str(), exp->pstate());
+        ItplFile* source = SASS_MEMORY_NEW(ItplFile, std::move(exp_src), exp->pstate());
         SelectorListObj sel = Parser::parse_selector(source, ctx, traces, true);
 
         for (auto& complex : sel->elements()) {
@@ -133,7 +133,7 @@ namespace Sass {
 
       // Nothing to do
       if( parsedSelectors.empty() ) {
-        return SASS_MEMORY_NEW(Null, pstate);
+        return immortal_null();
       }
 
       return Cast<Value>(Listize::perform(parsedSelectors.back()));
@@ -197,7 +197,7 @@ namespace Sass {
       SelectorListObj sel_sup = ARGSELS("$super");
       SelectorListObj sel_sub = ARGSELS("$sub");
       bool result = sel_sup->isSuperselectorOf(sel_sub);
-      return SASS_MEMORY_NEW(Boolean, pstate, result);
+      return immortal_boolean(result);
     }
 
   }
@@ -7,8 +7,8 @@ namespace Sass {
 
   namespace Functions {
 
-    #define ARGSEL(argname) get_arg_sel(argname, env, sig, pstate, traces, ctx)
-    #define ARGSELS(argname) get_arg_sels(argname, env, sig, pstate, traces, ctx)
+    #define ARGSEL(argname) get_arg_sel(ARGNAME(argname), env, sig, pstate, traces, ctx)
+    #define ARGSELS(argname) get_arg_sels(ARGNAME(argname), env, sig, pstate, traces, ctx)
 
     BUILT_IN(selector_nest);
     BUILT_IN(selector_append);
@@ -39,7 +39,7 @@ namespace Sass {
     Signature unquote_sig = "unquote($string)";
     BUILT_IN(sass_unquote)
     {
-      AST_Node_Obj arg = env["$string"];
+      AST_Node_Obj arg = env[ARGNAME("$string")];
       if (String_Quoted* string_quoted = Cast<String_Quoted>(arg)) {
         String_Constant* result = SASS_MEMORY_NEW(String_Constant, pstate, string_quoted->value());
         // remember if the string was quoted (color tokens)
@@ -86,7 +86,7 @@ namespace Sass {
       // other errors will be re-thrown
       catch (...) { handle_utf8_error(pstate, traces); }
       // return something even if we had an error (-1)
-      return SASS_MEMORY_NEW(Number, pstate, (double)len);
+      return make_number(pstate, (double)len);
     }
 
     Signature str_insert_sig = "str-insert($string, $insert, $index)";
@@ -151,7 +151,7 @@ namespace Sass {
 
         size_t c_index = str.find(substr);
         if(c_index == sass::string::npos) {
-          return SASS_MEMORY_NEW(Null, pstate);
+          return immortal_null();
         }
         index = UTF_8::code_point_count(str, 0, c_index) + 1;
       }
@@ -159,7 +159,7 @@ namespace Sass {
       // other errors will be re-thrown
       catch (...) { handle_utf8_error(pstate, traces); }
       // return something even if we had an error (-1)
-      return SASS_MEMORY_NEW(Number, pstate, (double)index);
+      return make_number(pstate, (double)index);
     }
 
     Signature str_slice_sig = "str-slice($string, $start-at, $end-at:-1)";
@@ -185,7 +185,7 @@ namespace Sass {
 
         size_t size = utf8::distance(str.begin(), str.end());
 
-        if (!Cast<Number>(env["$end-at"])) {
+        if (!Cast<Number>(env[ARGNAME("$end-at")])) {
           end_at = -1;
         }
 
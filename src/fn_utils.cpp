@@ -10,7 +10,11 @@ namespace Sass {
 
   Definition* make_native_function(Signature sig, Native_Function func, Context& ctx)
   {
-    SourceFile* source = SASS_MEMORY_NEW(SourceFile, "[built-in function]", sig, std::string::npos);
+    // signatures are static, no need to copy them
+    SourceFile* source = SASS_MEMORY_NEW(SourceFile, "[built-in function]",
+      SourceBuffer(sig, std::strlen(sig)), std::string::npos);
+    // shared by all compilations (see `built_in_functions`)
+    source->makeImmortal();
     Parser sig_parser(source, ctx, ctx.traces);
     sig_parser.lex<Prelexer::identifier>();
     sass::string name(Util::normalize_underscores(sig_parser.lexed));
@@ -28,7 +32,7 @@ namespace Sass {
   {
     using namespace Prelexer;
     const char* sig = sass_function_get_signature(c_func);
-    SourceFile* source = SASS_MEMORY_NEW(SourceFile, "[c function]", sig, std::string::npos);
+    SourceFile* source = SASS_MEMORY_NEW(SourceFile, "[c function]", sass::string(sig), std::string::npos);
     Parser sig_parser(source, ctx, ctx.traces);
     // allow to overload generic callback plus @warn, @error and @debug with custom functions
     sig_parser.lex < alternatives < identifier, exactly <'*'>,
@@ -54,7 +58,7 @@ namespace Sass {
       return str.substr(0, str.find('('));
     }
 
-    Map* get_arg_m(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    Map* get_arg_m(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
     {
       AST_Node* value = env[argname];
       if (Map* map = Cast<Map>(value)) return map;
@@ -65,7 +69,7 @@ namespace Sass {
       return get_arg<Map>(argname, env, sig, pstate, traces);
     }
 
-    double get_arg_r(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, double lo, double hi)
+    double get_arg_r(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, double lo, double hi)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -73,14 +77,14 @@ namespace Sass {
       double v = tmpnr.value();
       if (!(lo <= v && v <= hi)) {
         sass::ostream msg;
-        msg << "argument `" << argname << "` of `" << sig << "` must be between ";
+        msg << "argument `" << argname.c_str() << "` of `" << sig << "` must be between ";
         msg << lo << " and " << hi;
         error(msg.str(), pstate, traces);
       }
       return v;
     }
 
-    Number* get_arg_n(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    Number* get_arg_n(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       val = SASS_MEMORY_COPY(val);
@@ -88,7 +92,7 @@ namespace Sass {
       return val;
     }
 
-    double get_arg_val(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    double get_arg_val(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -96,7 +100,7 @@ namespace Sass {
       return tmpnr.value();
     }
 
-    double color_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    double color_num(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -108,7 +112,7 @@ namespace Sass {
       }
     }
 
-    double alpha_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces) {
+    double alpha_num(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces) {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
       tmpnr.reduce();
@@ -119,11 +123,11 @@ namespace Sass {
       }
     }
 
-    SelectorListObj get_arg_sels(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
-      ExpressionObj exp = ARG(argname, Expression);
+    SelectorListObj get_arg_sels(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
+      ExpressionObj exp = get_arg<Expression>(argname, env, sig, pstate, traces);
       if (exp->concrete_type() == Expression::NULL_VAL) {
         sass::ostream msg;
-        msg << argname << ": null is not a valid selector: it must be a string,\n";
+        msg << argname.c_str() << ": null is not a valid selector: it must be a string,\n";
         msg << "a list of strings, or a list of lists of strings for `" << function_name(sig) << "'";
         error(msg.str(), exp->pstate(), traces);
       }
@@ -131,23 +135,21 @@ namespace Sass {
         str->quote_mark(0);
       }
       sass::string exp_src = exp->to_string(ctx.c_options);
-      ItplFile* source = SASS_MEMORY_NEW(ItplFile, exp_src.c_str(), exp->pstate());
-      return Parser::parse_selector(source, ctx, traces, false);
+      return ctx.parse_selector(std::move(exp_src), exp->pstate(), traces, false, false);
     }
 
-    CompoundSelectorObj get_arg_sel(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
-      ExpressionObj exp = ARG(argname, Expression);
+    CompoundSelectorObj get_arg_sel(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
+      ExpressionObj exp = get_arg<Expression>(argname, env, sig, pstate, traces);
       if (exp->concrete_type() == Expression::NULL_VAL) {
         sass::ostream msg;
-        msg << argname << ": null is not a string for `" << function_name(sig) << "'";
+        msg << argname.c_str() << ": null is not a string for `" << function_name(sig) << "'";
         error(msg.str(), exp->pstate(), traces);
       }
       if (String_Constant* str = Cast<String_Constant>(exp)) {
         str->quote_mark(0);
       }
       sass::string exp_src = exp->to_string(ctx.c_options);
-      ItplFile* source = SASS_MEMORY_NEW(ItplFile, exp_src.c_str(), exp->pstate());
-      SelectorListObj sel_list = Parser::parse_selector(source, ctx, traces, false);
+      SelectorListObj sel_list = ctx.parse_selector(std::move(exp_src), exp->pstate(), traces, false, false);
       if (sel_list->length() == 0) return {};
       return sel_list->first()->first();
     }
@@ -27,9 +27,12 @@ namespace Sass {
   typedef PreValue* (*Native_Function)(FN_PROTOTYPE);
   #define BUILT_IN(name) PreValue* name(FN_PROTOTYPE)
 
-  #define ARG(argname, argtype) get_arg<argtype>(argname, env, sig, pstate, traces)
+  // Interns the (literal) name of an argument once per call site
+  #define ARGNAME(argname) ([]() -> const Symbol& { static const Symbol name(argname); return name; })()
+
+  #define ARG(argname, argtype) get_arg<argtype>(ARGNAME(argname), env, sig, pstate, traces)
   // special function for weird hsla percent (10px == 10% == 10 != 0.1)
-  #define ARGVAL(argname) get_arg_val(argname, env, sig, pstate, traces) // double
+  #define ARGVAL(argname) get_arg_val(ARGNAME(argname), env, sig, pstate, traces) // double
 
   Definition* make_native_function(Signature, Native_Function, Context& ctx);
   Definition* make_c_function(Sass_Function_Entry c_func, Context& ctx);
@@ -37,23 +40,23 @@ namespace Sass {
   namespace Functions {
 
     template <typename T>
-    T* get_arg(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    T* get_arg(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
     {
       T* val = Cast<T>(env[argname]);
       if (!val) {
-        error("argument `" + argname + "` of `" + sig + "` must be a " + T::type_name(), pstate, traces);
+        error("argument `" + argname.to_string() + "` of `" + sig + "` must be a " + T::type_name(), pstate, traces);
       }
       return val;
     }
 
-    Map* get_arg_m(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // maps only
-    Number* get_arg_n(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // numbers only
-    double alpha_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // colors only
-    double color_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // colors only
-    double get_arg_r(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, double lo, double hi); // colors only
-    double get_arg_val(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // shared
-    SelectorListObj get_arg_sels(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx); // selectors only
-    CompoundSelectorObj get_arg_sel(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx); // selectors only
+    Map* get_arg_m(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // maps only
+    Number* get_arg_n(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // numbers only
+    double alpha_num(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // colors only
+    double color_num(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // colors only
+    double get_arg_r(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, double lo, double hi); // colors only
+    double get_arg_val(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces); // shared
+    SelectorListObj get_arg_sels(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx); // selectors only
+    CompoundSelectorObj get_arg_sel(const Symbol& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx); // selectors only
 
   }
 
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <iomanip>
 #include "lexer.hpp"
+#include "scanner.hpp"
 #include "constants.hpp"
 #include "util_string.hpp"
 
@@ -75,13 +76,13 @@ namespace Sass {
     const char* escapable_character(const char* src) { return is_escapable_character(*src) ? src + 1 : 0; }
 
     // Match multiple ctype characters.
-    const char* spaces(const char* src) { return one_plus<space>(src); }
+    const char* spaces(const char* src) { const char* p = Scanner::skip_spaces(src); return p == src ? 0 : p; }
     const char* digits(const char* src) { return one_plus<digit>(src); }
     const char* hyphens(const char* src) { return one_plus<hyphen>(src); }
 
     // Whitespace handling.
     const char* no_spaces(const char* src) { return negate< space >(src); }
-    const char* optional_spaces(const char* src) { return zero_plus< space >(src); }
+    const char* optional_spaces(const char* src) { return Scanner::skip_spaces(src); }
 
     // Match any single character.
     const char* any_char(const char* src) { return *src ? src + 1 : src; }
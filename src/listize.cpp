@@ -31,7 +31,7 @@ namespace Sass {
       l->append(sel->at(i)->perform(this));
     }
     if (l->length()) return l.detach();
-    return SASS_MEMORY_NEW(Null, l->pstate());
+    return immortal_null();
   }
 
   Expression* Listize::operator()(CompoundSelector* sel)
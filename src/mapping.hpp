@@ -6,12 +6,21 @@
 
 namespace Sass {
 
+  // The original position is kept as a byte offset into its
+  // source and only resolved to line and column on serializing,
+  // since most compilations never render their source-map.
   struct Mapping {
-    Position original_position;
+    SourceDataObj source;
+    size_t original_file;
+    size_t original_offset;
     Position generated_position;
 
-    Mapping(const Position& original_position, const Position& generated_position)
-    : original_position(original_position), generated_position(generated_position) { }
+    Mapping(const SourceDataObj& source, size_t original_file, size_t original_offset, const Position& generated_position)
+    : source(source), original_file(original_file), original_offset(original_offset), generated_position(generated_position) { }
+
+    Offset original_position() const {
+      return source->getLineColumn(original_offset);
+    }
   };
 
 }
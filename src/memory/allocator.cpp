@@ -2,47 +2,296 @@
 #include "allocator.hpp"
 #include "memory_pool.hpp"
 
-#if defined (_MSC_VER) // Visual studio
+#include <mutex>
+
+#if defined (_MSC_VER) && _MSC_VER < 1900 // Visual studio 2013
 #define thread_local __declspec( thread )
+#define SASS_NO_THREAD_EXIT
 #elif defined (__GCC__) // GCC
 #define thread_local __thread
 #endif
 
 namespace Sass {
 
+  // Budget of the compilation running on this thread
+  static thread_local MemoryBudget* budget;
+
+  MemoryBudgetScope::MemoryBudgetScope(MemoryBudget* next) :
+    previous(budget)
+  {
+    budget = next && next->limit ? next : nullptr;
+  }
+
+  MemoryBudgetScope::~MemoryBudgetScope()
+  {
+    budget = previous;
+  }
+
 #ifdef SASS_CUSTOM_ALLOCATOR
 
   // Only use PODs for thread_local
   // Objects get unpredictable init order
   static thread_local MemoryPool* pool;
-  static thread_local size_t allocations;
+  // Set once the thread is shutting down
+  static thread_local bool exited;
 
-  void* allocateMem(size_t size)
+  // Region of the compilation running on this thread
+  static thread_local MemoryPool* region;
+  // Number of regions released on this thread
+  static thread_local size_t releasing;
+
+  // Pools of exited threads. They may still hold slices
+  // that are alive on other threads, so we never delete
+  // them. Instead the next new thread will adopt them.
+  // Note: must not use our allocator, to avoid recursion.
+  static std::mutex orphansMutex;
+  static std::vector<MemoryPool*>* orphans;
+
+  // Hand our pool over to the next thread
+  static void orphanPool(MemoryPool* orphan)
+  {
+    std::lock_guard<std::mutex> lock(orphansMutex);
+    if (orphans == nullptr) {
+      orphans = new std::vector<MemoryPool*>();
+    }
+    orphans->push_back(orphan);
+    pool = nullptr;
+  }
+
+  // Adopt an orphaned pool or create a new one
+  static MemoryPool* adoptPool()
+  {
+    std::lock_guard<std::mutex> lock(orphansMutex);
+    if (orphans == nullptr || orphans->empty()) {
+      return new MemoryPool();
+    }
+    MemoryPool* adopted = orphans->back();
+    orphans->pop_back();
+    return adopted;
+  }
+
+  #ifndef SASS_NO_THREAD_EXIT
+  // Orphans the pool once the thread exits
+  struct ThreadPoolGuard {
+    ~ThreadPoolGuard() {
+      exited = true;
+      if (pool) orphanPool(pool);
+    }
+  };
+  #endif
+
+  // Get the pool of the current thread
+  static MemoryPool* getThreadPool()
   {
     if (pool == nullptr) {
-      pool = new MemoryPool();
+      MemoryPool* adopted = adoptPool();
+      #ifndef SASS_NO_THREAD_EXIT
+      if (!exited) {
+        // Registers the destructor on first use
+        static thread_local ThreadPoolGuard guard;
+        (void)guard;
+      }
+      #endif
+      pool = adopted;
     }
-    allocations++;
-    return pool->allocate(size);
+    return pool;
   }
 
-  void deallocateMem(void* ptr, size_t size)
+  // Unused arenas kept for reuse. Taken and given back by all
+  // threads, but only once per arena, so a lock is good enough.
+  // Note: must not use our allocator, to avoid recursion.
+  static std::mutex retainedMutex;
+  static std::vector<void*>* retained;
+  static size_t retainLimit = SassAllocatorRetainedArenas;
+
+  // Get a new arena from the system
+  static void* systemArena()
+  {
+    #ifdef _WIN32
+    return _aligned_malloc(SassAllocatorArenaSize, SassAllocatorArenaSize);
+    #else
+    void* arena = nullptr;
+    if (posix_memalign(&arena, SassAllocatorArenaSize, SassAllocatorArenaSize)) {
+      return nullptr;
+    }
+    return arena;
+    #endif
+  }
+
+  // Give an arena back to the system
+  static void systemFree(void* arena)
+  {
+    #ifdef _WIN32
+    _aligned_free(arena);
+    #else
+    free(arena);
+    #endif
+  }
+
+  void* allocateArena()
+  {
+    {
+      std::lock_guard<std::mutex> lock(retainedMutex);
+      if (retained != nullptr && !retained->empty()) {
+        void* arena = retained->back();
+        retained->pop_back();
+        return arena;
+      }
+    }
+    return systemArena();
+  }
+
+  void freeArena(void* arena)
+  {
+    {
+      std::lock_guard<std::mutex> lock(retainedMutex);
+      if (retained == nullptr) {
+        retained = new std::vector<void*>();
+      }
+      if (retained->size() < retainLimit) {
+        retained->push_back(arena);
+        return;
+      }
+    }
+    systemFree(arena);
+  }
+
+  // Give back arenas above the limit (must hold the lock)
+  static size_t trimRetained(size_t limit)
+  {
+    size_t released = 0;
+    if (retained == nullptr) return released;
+    while (retained->size() > limit) {
+      systemFree(retained->back());
+      retained->pop_back();
+      released += SassAllocatorArenaSize;
+    }
+    return released;
+  }
+
+  void setArenaRetention(size_t limit)
+  {
+    std::lock_guard<std::mutex> lock(retainedMutex);
+    retainLimit = limit;
+    trimRetained(limit);
+  }
+
+  size_t getArenaRetention()
   {
+    std::lock_guard<std::mutex> lock(retainedMutex);
+    return retainLimit;
+  }
+
+  size_t retainedArenas()
+  {
+    std::lock_guard<std::mutex> lock(retainedMutex);
+    return retained ? retained->size() : 0;
+  }
 
-    // It seems thread_local variable might be discharged!?
-    // But the destructors of e.g. static strings is still
-    // called, although their memory was discharged too.
-    // Fine with me as long as address sanitizer is happy.
-    if (pool == nullptr || allocations == 0) { return; }
+  size_t trimArenas()
+  {
+    std::lock_guard<std::mutex> lock(retainedMutex);
+    return trimRetained(0);
+  }
 
-    pool->deallocate(ptr);
-    if (--allocations == 0) {
-      delete pool;
-      pool = nullptr;
+  void* allocateMem(size_t size)
+  {
+    void* ptr = region != nullptr ? region->allocate(size)
+      : getThreadPool()->allocate(size);
+    if (budget != nullptr) {
+      budget->charge(MemoryPool::sliceSize(ptr));
     }
+    return ptr;
+  }
 
+  void deallocateMem(void* ptr, size_t size)
+  {
+    // Find the pool that owns the memory. Pools are
+    // never deleted while slices could still be alive.
+    MemoryPool* owner = MemoryPool::getOwner(ptr);
+    if (budget != nullptr) {
+      budget->refund(MemoryPool::sliceSize(ptr));
+    }
+    // Regions are only used by one thread at a time
+    if (owner == pool || owner->isRegion()) {
+      owner->deallocate(ptr);
+    }
+    // Give slice back to the owning thread
+    else {
+      owner->deallocateRemote(ptr);
+    }
+  }
+
+  bool isReleasedMem(void* ptr)
+  {
+    if (releasing == 0) return false;
+    return MemoryPool::getOwner(ptr)->isReleased();
+  }
+
+  MemoryRegion::MemoryRegion(bool enabled) :
+    pool(enabled ? new MemoryPool(true) : nullptr)
+  {
+  }
+
+  MemoryRegion::~MemoryRegion()
+  {
+    if (pool == nullptr) return;
+    if (pool->isReleased()) --releasing;
+    delete pool;
   }
 
+  void MemoryRegion::release()
+  {
+    if (pool == nullptr) return;
+    if (pool->isReleased()) return;
+    pool->release();
+    ++releasing;
+  }
+
+  MemoryRegionScope::MemoryRegionScope(MemoryRegion* next) :
+    previous(region)
+  {
+    region = next ? next->pool : nullptr;
+  }
+
+  MemoryRegionScope::~MemoryRegionScope()
+  {
+    region = previous;
+  }
+
+  void sampleMemory(const MemoryRegion& region, MemoryStats& stats)
+  {
+    MemoryPool* sampled = region.pool;
+    if (sampled == nullptr) sampled = getThreadPool();
+    sampled->collectStats(stats);
+  }
+
+#else
+
+  void* allocateMem(size_t size)
+  {
+    if (budget != nullptr) budget->charge(size);
+    return ::operator new(size);
+  }
+
+  void deallocateMem(void* ptr, size_t size)
+  {
+    if (budget != nullptr) budget->refund(size);
+    ::operator delete(ptr);
+  }
+
+  // Regions need our custom allocator
+  MemoryRegion::MemoryRegion(bool) : pool(nullptr) {}
+  MemoryRegion::~MemoryRegion() {}
+  void MemoryRegion::release() {}
+  MemoryRegionScope::MemoryRegionScope(MemoryRegion*) : previous(nullptr) {}
+  MemoryRegionScope::~MemoryRegionScope() {}
+  void sampleMemory(const MemoryRegion&, MemoryStats&) {}
+  void setArenaRetention(size_t) {}
+  size_t getArenaRetention() { return 0; }
+  size_t retainedArenas() { return 0; }
+  size_t trimArenas() { return 0; }
+
 #endif
 
 }
@@ -13,16 +13,21 @@
 
 namespace Sass {
 
+  // Allocate memory and charge the active `MemoryBudget`.
+  // Without `SASS_CUSTOM_ALLOCATOR` this forwards to the
+  // global operators and only serves the shared objects.
+  void* allocateMem(size_t size);
+
+  // Size is only needed without `SASS_CUSTOM_ALLOCATOR`,
+  // as our pools know the size of their own slices.
+  void deallocateMem(void* ptr, size_t size = 1);
+
 #ifndef SASS_CUSTOM_ALLOCATOR
 
   template <typename T> using Allocator = std::allocator<T>;
 
 #else
 
-  void* allocateMem(size_t size);
-
-  void deallocateMem(void* ptr, size_t size = 1);
-
   template<typename T>
   class Allocator
   {
@@ -104,6 +109,139 @@ namespace Sass {
     return !(left == right);
   }
 
+#endif
+
+  // Forward declaration
+  class MemoryPool;
+  struct MemoryStats;
+
+  // A memory region owned by a single compilation (`Context`).
+  // While a `MemoryRegionScope` for it is active on the current
+  // thread, all allocations are served from the region. Once the
+  // compilation is done, everything is given back in one step
+  // without destroying the remaining objects one by one.
+  // Only has an effect with `SASS_CUSTOM_ALLOCATOR`.
+  class MemoryRegion {
+  private:
+    // Pool serving the region (null if disabled)
+    MemoryPool* pool;
+  public:
+    MemoryRegion(bool enabled);
+    ~MemoryRegion();
+    // Give up all remaining objects at once
+    void release();
+    // Check if the region was enabled
+    bool enabled() const { return pool != nullptr; }
+    friend class MemoryRegionScope;
+    friend void sampleMemory(const MemoryRegion&, MemoryStats&);
+  private:
+    // Regions are not copyable
+    MemoryRegion(const MemoryRegion&) = delete;
+    MemoryRegion& operator=(const MemoryRegion&) = delete;
+  };
+
+  // RAII helper to activate a region on the current thread.
+  // Passing a null pointer suspends any active region, which
+  // is needed for objects that must outlive the compilation.
+  class MemoryRegionScope {
+  private:
+    // Region active before us
+    MemoryPool* previous;
+  public:
+    MemoryRegionScope(MemoryRegion* region);
+    ~MemoryRegionScope();
+  };
+
+  // Bytes a compilation may hold before it is aborted. While a
+  // `MemoryBudgetScope` for it is active on the current thread,
+  // every allocation is charged and every deallocation refunded.
+  // Allocations can't throw without leaving the compiler in a
+  // bad state, so the compiler checks `exceeded` at safe points.
+  // Without `SASS_CUSTOM_ALLOCATOR` only shared objects (nodes
+  // and values) are charged, strings and containers are not.
+  class MemoryBudget {
+  public:
+    // Maximum bytes (zero means unlimited)
+    const size_t limit;
+    // Bytes currently charged
+    size_t used;
+  public:
+    MemoryBudget(size_t limit) : limit(limit), used(0) {}
+    // Check if we went over the limit
+    bool exceeded() const { return limit && used > limit; }
+    void charge(size_t bytes) { used += bytes; }
+    // Memory may be freed under another budget
+    void refund(size_t bytes) { used -= std::min(used, bytes); }
+  private:
+    // Budgets are not copyable
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+  };
+
+  // RAII helper to activate a budget on the current thread.
+  // Unlimited budgets are not activated to save the charges.
+  class MemoryBudgetScope {
+  private:
+    // Budget active before us
+    MemoryBudget* previous;
+  public:
+    MemoryBudgetScope(MemoryBudget* budget);
+    ~MemoryBudgetScope();
+  };
+
+  // Snapshot of the counters of the memory pool serving
+  // a compilation. Only filled with `SASS_CUSTOM_ALLOCATOR`.
+  // Uses the standard allocator to not disturb the numbers.
+  struct MemoryStats {
+    struct Bucket {
+      // Bytes per slice (including book-keeping)
+      size_t size;
+      // Slices currently in use
+      size_t objects;
+      // Slices waiting on the free-list
+      size_t free;
+    };
+    // Buckets with any slices
+    std::vector<Bucket> buckets;
+    // Arenas allocated from the system
+    size_t arenas = 0;
+    // Slices too big for our buckets
+    size_t largeObjects = 0;
+    size_t largeBytes = 0;
+    // Bytes held by the pool
+    size_t resident = 0;
+    // Highest resident bytes so far
+    size_t peak = 0;
+  };
+
+  // Get counters of the given region, or of the pool
+  // of the current thread if the region is disabled.
+  void sampleMemory(const MemoryRegion& region, MemoryStats& stats);
+
+  // Set how many unused arenas are kept for reuse.
+  // Lowering the limit gives back the surplus.
+  void setArenaRetention(size_t limit);
+
+  // Get the current retention limit
+  size_t getArenaRetention();
+
+  // Number of unused arenas currently kept
+  size_t retainedArenas();
+
+  // Give back all unused arenas to the system.
+  // Returns the number of bytes released.
+  size_t trimArenas();
+
+#ifdef SASS_CUSTOM_ALLOCATOR
+
+  // Check if the given memory belongs to a region that is
+  // currently being released (must point to an allocation).
+  bool isReleasedMem(void* ptr);
+
+#else
+
+  inline bool isReleasedMem(void* ptr) { return false; }
+
 #endif
 
   namespace sass {
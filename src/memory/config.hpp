@@ -13,8 +13,9 @@
 // deallocations, or if it should go directly to the `free` call.
 #define SassAllocatorBookSize sizeof(unsigned int)
 
-// Bytes reserve for book-keeping on the arenas
-// Currently unused and for later optimization
-#define SassAllocatorArenaHeadSize 0
+// Bytes reserve for book-keeping on the arenas. Arenas are
+// aligned to their size, so we can find the arena header
+// (and with it the owning pool) from any slice address.
+#define SassAllocatorArenaHeadSize sizeof(void*)
 
 #endif
\ No newline at end of file
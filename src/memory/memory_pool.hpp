@@ -5,7 +5,16 @@
 #include <iostream>
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <atomic>
 #include <vector>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "allocator.hpp"
 
 namespace Sass {
 
@@ -34,15 +43,53 @@ namespace Sass {
   // and return it to the caller. Otherwise we have to take out
   // a new slice from the current `arena` and increase `offset`.
 
-  // Note that this is not thread safe. This is on purpose as we
-  // want to use the memory pool in a thread local usage. In order
-  // to get this thread safe you need to only allocate one pool
-  // per thread. This can be achieved by using thread local PODs.
-  // Simply create a pool on the first allocation and dispose
-  // it once all allocations have been returned. E.g. by using:
-  // static thread_local size_t allocations;
+  // Note that allocations are not thread safe. This is on purpose
+  // as we want to use the memory pool in a thread local usage. In
+  // order to get this thread safe you need to only allocate one pool
+  // per thread. This can be achieved by using thread local PODs:
   // static thread_local MemoryPool* pool;
 
+  // Arenas of destroyed pools (e.g. regions of finished compilations)
+  // are not given back to the system right away. Up to a configurable
+  // number of them are kept for reuse by the next pool that needs one,
+  // so a process that runs many compilations stays warm. They can be
+  // given back to the system explicitly via `trimArenas`.
+
+  // Slices may be freed by any thread though. Only the owning thread
+  // may call `deallocate`, all other threads must use `deallocateRemote`.
+  // This pushes the slice on a lock-free stack (`remoteFree`), which is
+  // moved to the regular free-lists by the owner once it runs dry.
+
+  // Arenas are aligned to their own size. Every arena starts with
+  // a pointer to the pool that owns it, so we can find the owner
+  // of any slice by masking its address (see `getOwner`). Slices
+  // that are too big for our buckets store the owner right before
+  // their book-keeping header instead.
+
+  // Every pool keeps a few counters (live slices per bucket, big
+  // slices and peak resident bytes) which can be inspected via
+  // `collectStats`. Slices freed by other threads are only seen
+  // by these counters once the owner has collected them.
+
+  // A pool can also be created as a memory region. A region is owned
+  // by one compilation (see `MemoryRegion`) and all its memory is given
+  // back in one step once the compilation is done. After `release` has
+  // been called, single deallocations are ignored and `isReleased` tells
+  // the shared pointers to skip the destructors of the remaining objects.
+
+  // Make sure we can derive the arena from a slice address
+  static_assert((SassAllocatorArenaSize & (SassAllocatorArenaSize - 1)) == 0,
+    "SassAllocatorArenaSize must be a power of two");
+
+  // Get an arena that is aligned to its size. Unused arenas
+  // are shared by all pools (see `setArenaRetention`), so we only
+  // go back to the system if none is waiting for reuse.
+  void* allocateArena();
+
+  // Give back an arena got via `allocateArena`. It is kept
+  // for reuse until the retention limit is reached.
+  void freeArena(void* arena);
+
   class MemoryPool {
 
     // Current arena we fill up
@@ -60,33 +107,174 @@ namespace Sass {
     #endif
     void* freeList[SassAllocatorBuckets]{};
 
+    // Slices served via malloc (only tracked
+    // for regions to free them in bulk)
+    std::unordered_set<char*> large;
+
+    // Pool is owned by a single compilation
+    bool region;
+
+    // Region memory has been given up
+    bool released;
+
+    // Live slices for every bucket (zero init)
+    #ifdef _MSC_VER
+    #pragma warning (suppress:4351)
+    #endif
+    size_t slices[SassAllocatorBuckets]{};
+
+    // Live slices served via malloc
+    // May be freed by other threads
+    std::atomic<size_t> largeCount;
+    std::atomic<size_t> largeBytes;
+
+    // Highest resident bytes seen
+    size_t peak;
+
+    // Slices freed by other threads
+    std::atomic<void*> remoteFree;
+
+    // Move slices freed by other threads to our free-lists
+    // We take the whole stack at once, so there is no ABA issue
+    void collectRemote()
+    {
+      void* item = remoteFree.exchange(nullptr, std::memory_order_acquire);
+      while (item != nullptr) {
+        void* next = ((void**)item)[0];
+        // Get the bucket index stored in the header
+        unsigned int bucket = ((unsigned int*)
+          ((char*)item - SassAllocatorBookSize))[0];
+        // Put the item on the regular free-list
+        ((void**)item)[0] = freeList[bucket];
+        freeList[bucket] = item;
+        --slices[bucket];
+        item = next;
+      }
+    }
+
     // Increase the address until it sits on a
     // memory aligned address (maybe use `aligned`).
     inline static size_t alignMemAddr(size_t addr) {
       return (addr + SASS_MEM_ALIGN - 1) & ~(SASS_MEM_ALIGN - 1);
     }
 
+    // Big slices store the owner and their size in front
+    static const size_t largeHeadSize = sizeof(void*) + sizeof(size_t);
+
+    // Remember the highest resident bytes
+    void updatePeak()
+    {
+      peak = std::max(peak, resident());
+    }
+
   public:
 
     // Default ctor
-    MemoryPool() :
+    MemoryPool(bool region = false) :
       // Wait for first allocation
       arena(nullptr),
       // Set to maximum value in order to
       // make an allocation on the first run
-      offset(std::string::npos)
+      offset(std::string::npos),
+      region(region),
+      released(false),
+      largeCount(0),
+      largeBytes(0),
+      peak(0),
+      remoteFree(nullptr)
     {
     }
 
+    // Pools are not copyable
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
     // Destructor
     ~MemoryPool() {
       // Delete full arenas
       for (auto area : arenas) {
-        free(area);
+        freeArena(area);
       }
       // Delete current arena
-      free(arena);
+      if (arena) freeArena(arena);
+      // Delete big slices still alive
+      for (char* buffer : large) {
+        free(buffer);
+      }
+    }
+
+    // Give up all memory at once (regions only)
+    void release() { released = true; }
 
+    // Check if memory was given up
+    bool isReleased() const { return released; }
+
+    // Check if pool belongs to a compilation
+    bool isRegion() const { return region; }
+
+    // Number of arenas allocated from the system
+    size_t arenaCount() const
+    {
+      return arenas.size() + (arena ? 1 : 0);
+    }
+
+    // Bytes currently held by us
+    size_t resident() const
+    {
+      return arenaCount() * SassAllocatorArenaSize
+        + largeBytes.load(std::memory_order_relaxed);
+    }
+
+    // Add our counters to the statistics
+    // Must be called by the owning thread
+    void collectStats(MemoryStats& stats) const
+    {
+      for (size_t bucket = 0; bucket < SassAllocatorBuckets; bucket++) {
+        size_t length = 0;
+        void* item = freeList[bucket];
+        while (item != nullptr) {
+          item = ((void**)item)[0];
+          ++length;
+        }
+        if (slices[bucket] == 0 && length == 0) continue;
+        stats.buckets.push_back({ bucket * SASS_MEM_ALIGN, slices[bucket], length });
+      }
+      stats.arenas += arenaCount();
+      stats.largeObjects += largeCount.load(std::memory_order_relaxed);
+      stats.largeBytes += largeBytes.load(std::memory_order_relaxed);
+      stats.resident += resident();
+      stats.peak += std::max(peak, resident());
+    }
+
+    // Get the pool that handed out the given slice
+    static MemoryPool* getOwner(void* ptr)
+    {
+      // Rewind buffer from pointer
+      char* buffer = (char*)ptr -
+        SassAllocatorBookSize;
+      // Big slices store the owner before the header
+      if (((unsigned int*)buffer)[0] == UINT_MAX) {
+        return ((MemoryPool**)(buffer - largeHeadSize))[0];
+      }
+      // Otherwise mask address to get the arena header
+      return ((MemoryPool**)((uintptr_t)ptr &
+        ~(uintptr_t)(SassAllocatorArenaSize - 1)))[0];
+    }
+
+    // Get the bytes taken by the given slice
+    static size_t sliceSize(void* ptr)
+    {
+      // Rewind buffer from pointer
+      char* buffer = (char*)ptr -
+        SassAllocatorBookSize;
+      // Get the bucket index stored in the header
+      unsigned int bucket = ((unsigned int*)buffer)[0];
+      // Big slices store their size before the header
+      if (bucket == UINT_MAX) {
+        buffer -= largeHeadSize - sizeof(void*);
+        return ((size_t*)buffer)[0];
+      }
+      return bucket * SASS_MEM_ALIGN;
     }
 
     // Allocate a slice of the memory pool
@@ -108,10 +296,20 @@ namespace Sass {
       // Everything bigger is allocated via malloc
       // Malloc is optimized for exactly this case
       if (bucket >= SassAllocatorBuckets) {
-        char* buffer = (char*)malloc(size);
+        char* buffer = (char*)malloc(size + largeHeadSize);
         if (buffer == nullptr) {
           throw std::bad_alloc();
         }
+        // Remember big slices owned by a region
+        if (region) large.insert(buffer);
+        // Store the owning pool and size in front
+        ((MemoryPool**)buffer)[0] = this;
+        ((size_t*)(buffer + sizeof(void*)))[0] = size;
+        buffer += largeHeadSize;
+        // Update our statistics
+        largeBytes.fetch_add(size, std::memory_order_relaxed);
+        largeCount.fetch_add(1, std::memory_order_relaxed);
+        updatePeak();
         // Mark it for deallocation via free
         ((unsigned int*)buffer)[0] = UINT_MAX;
         // Return pointer after our book-keeping space
@@ -127,17 +325,32 @@ namespace Sass {
           void* ptr = free;
           // Update free list pointer
           free = ((void**)ptr)[0];
+          ++slices[bucket];
           // Return popped item
           return ptr;
         }
+        // Check slices freed by other threads
+        if (remoteFree.load(std::memory_order_relaxed)) {
+          collectRemote();
+          // Try again with updated free-list
+          if (free != nullptr) {
+            void* ptr = free;
+            free = ((void**)ptr)[0];
+            ++slices[bucket];
+            return ptr;
+          }
+        }
       }
 
       // Make sure we have enough space in the arena
       if (!arena || offset > SassAllocatorArenaSize - size) {
         if (arena) arenas.emplace_back(arena);
-        arena = (char*)malloc(SassAllocatorArenaSize);
+        arena = (char*)allocateArena();
         if (arena == nullptr) throw std::bad_alloc();
+        // Let the arena point back to us
+        ((MemoryPool**)arena)[0] = this;
         offset = SassAllocatorArenaHeadSize;
+        updatePeak();
       }
 
       // Get pointer into the arena
@@ -147,6 +360,7 @@ namespace Sass {
 
       // Set the bucket index for this slice
       ((unsigned int*)buffer)[0] = (unsigned int)bucket;
+      ++slices[bucket];
 
       // Return pointer after our book-keeping space
       return (void*)(buffer + SassAllocatorBookSize);
@@ -157,6 +371,9 @@ namespace Sass {
     void deallocate(void* ptr)
     {
 
+      // Released in bulk later
+      if (released) return;
+
       // Rewind buffer from pointer
       char* buffer = (char*)ptr -
         SassAllocatorBookSize;
@@ -170,15 +387,52 @@ namespace Sass {
         ((void**)ptr)[0] = freeList[bucket];
         // Free list now points to our memory
         freeList[bucket] = (void*)ptr;
+        --slices[bucket];
       }
       else {
+        // Rewind to owner pointer
+        buffer -= largeHeadSize;
+        // Forget big slice of region
+        if (region) large.erase(buffer);
         // Release memory
-        free(buffer);
+        freeLarge(buffer);
       }
 
     }
     // EO deallocate
 
+    // Free a big slice (points to our header)
+    void freeLarge(char* buffer)
+    {
+      size_t size = ((size_t*)(buffer + sizeof(void*)))[0];
+      largeBytes.fetch_sub(size, std::memory_order_relaxed);
+      largeCount.fetch_sub(1, std::memory_order_relaxed);
+      free(buffer);
+    }
+
+    // Deallocate a slice from a thread that does not own us
+    void deallocateRemote(void* ptr)
+    {
+
+      // Rewind buffer from pointer
+      char* buffer = (char*)ptr -
+        SassAllocatorBookSize;
+
+      // Big slices can be freed by anyone
+      if (((unsigned int*)buffer)[0] == UINT_MAX) {
+        freeLarge(buffer - largeHeadSize);
+        return;
+      }
+
+      // Push slice on the lock-free stack
+      void* head = remoteFree.load(std::memory_order_relaxed);
+      do { ((void**)ptr)[0] = head; }
+      while (!remoteFree.compare_exchange_weak(head, ptr,
+        std::memory_order_release, std::memory_order_relaxed));
+
+    }
+    // EO deallocateRemote
+
   };
 
 }
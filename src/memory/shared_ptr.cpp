@@ -1,6 +1,12 @@
 #include "../sass.hpp"
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
 
 #include "shared_ptr.hpp"
 #include "../ast_fwd_decl.hpp"
@@ -30,4 +36,110 @@ namespace Sass {
   #endif
 
   bool SharedObj::taint = false;
+
+  // Census active on the current thread
+  static thread_local ObjectCensus* current = nullptr;
+
+  std::atomic<size_t> ObjectCensus::active(0);
+
+  ObjectCensus::Scope::Scope(ObjectCensus* census) :
+    previous(current)
+  {
+    if (census) ++active;
+    current = census;
+  }
+
+  ObjectCensus::Scope::~Scope()
+  {
+    if (current) --active;
+    current = previous;
+  }
+
+  // Census of every id, to find the one that counted an object.
+  // Never destroyed, counted objects may be freed at exit.
+  struct CensusRegistry {
+    std::mutex mutex;
+    std::unordered_map<uint32_t, ObjectCensus*> censuses;
+    uint32_t last_id = 0;
+  };
+
+  static CensusRegistry& census_registry()
+  {
+    static CensusRegistry* registry = new CensusRegistry();
+    return *registry;
+  }
+
+  static uint32_t register_census(ObjectCensus* census)
+  {
+    CensusRegistry& registry(census_registry());
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // zero means not counted
+    if (++registry.last_id == 0) ++registry.last_id;
+    registry.censuses[registry.last_id] = census;
+    return registry.last_id;
+  }
+
+  ObjectCensus::ObjectCensus() :
+    id(register_census(this))
+  {
+  }
+
+  ObjectCensus::~ObjectCensus()
+  {
+    CensusRegistry& registry(census_registry());
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.censuses.erase(id);
+  }
+
+  void ObjectCensus::count(SharedObj* obj)
+  {
+    ObjectCensus* census = current;
+    if (census == nullptr) return;
+    std::lock_guard<std::mutex> lock(census->mutex);
+    census->live[typeid(*obj)] += 1;
+    obj->census = census->id;
+  }
+
+  void ObjectCensus::remove(SharedObj* obj)
+  {
+    CensusRegistry& registry(census_registry());
+    // keeps the census alive while we update it
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto census = registry.censuses.find(obj->census);
+    obj->census = 0;
+    if (census == registry.censuses.end()) return;
+    std::lock_guard<std::mutex> counts(census->second->mutex);
+    auto it = census->second->live.find(typeid(*obj));
+    if (it != census->second->live.end() && it->second > 0) {
+      it->second -= 1;
+    }
+  }
+
+  // Strip compiler specific decorations from the type name
+  static std::string demangle(const char* name)
+  {
+    std::string demangled(name);
+    #if defined(__GNUC__) || defined(__clang__)
+    int status = 0;
+    char* real = abi::__cxa_demangle(name, 0, 0, &status);
+    if (status == 0 && real) demangled = real;
+    free(real);
+    #else
+    if (demangled.compare(0, 6, "class ") == 0) demangled.erase(0, 6);
+    #endif
+    if (demangled.compare(0, 6, "Sass::") == 0) demangled.erase(0, 6);
+    return demangled;
+  }
+
+  std::vector<std::pair<std::string, size_t>> ObjectCensus::counts() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::pair<std::string, size_t>> result;
+    for (auto& entry : live) {
+      if (entry.second == 0) continue;
+      result.emplace_back(demangle(entry.first.name()), entry.second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
 }
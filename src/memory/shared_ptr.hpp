@@ -5,10 +5,15 @@
 
 #include "../sass.hpp"
 #include "allocator.hpp"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 // https://lokiastari.com/blog/2014/12/30/c-plus-plus-by-example-smart-pointer/index.html
@@ -28,7 +33,7 @@ namespace Sass {
   #ifdef DEBUG_SHARED_PTR
 
     #define SASS_MEMORY_NEW(Class, ...) \
-      ((Class*)(new Class(__VA_ARGS__))->trace(__FILE__, __LINE__)) \
+      ((Class*)Sass::ObjectCensus::add(new Class(__VA_ARGS__))->trace(__FILE__, __LINE__)) \
 
     #define SASS_MEMORY_COPY(obj) \
       ((obj)->copy(__FILE__, __LINE__)) \
@@ -39,7 +44,7 @@ namespace Sass {
   #else
 
     #define SASS_MEMORY_NEW(Class, ...) \
-      new Class(__VA_ARGS__) \
+      Sass::ObjectCensus::add(new Class(__VA_ARGS__)) \
 
     #define SASS_MEMORY_COPY(obj) \
       ((obj)->copy()) \
@@ -61,7 +66,7 @@ namespace Sass {
   // object are allocated in one continuous memory block via one single call).
   class SharedObj {
    public:
-    SharedObj() : refcount(0), detached(false) {
+    SharedObj() : refcount(0), census(0), detached(false), immortal(false) {
       #ifdef DEBUG_SHARED_PTR
       if (taint) all.push_back(this);
       #endif
@@ -92,21 +97,30 @@ namespace Sass {
 
     static void setTaint(bool val) { taint = val; }
 
-    #ifdef SASS_CUSTOM_ALLOCATOR
+    // Immortal objects are never refcounted nor deleted. They
+    // must be created outside of any memory region and are only
+    // safe to share between threads if they are not mutated.
+    void makeImmortal();
+    bool isImmortal() const { return immortal; }
+
     inline void* operator new(size_t nbytes) {
       return allocateMem(nbytes);
     }
-    inline void operator delete(void* ptr) {
-      return deallocateMem(ptr);
+    inline void operator delete(void* ptr, size_t nbytes) {
+      return deallocateMem(ptr, nbytes);
     }
-    #endif
 
     virtual sass::string to_string() const = 0;
    protected:
     friend class SharedPtr;
     friend class Memory_Manager;
+    friend class ObjectCensus;
     size_t refcount;
+    // Id of the `ObjectCensus` that counted it
+    uint32_t census;
     bool detached;
+    // Ignored by all `SharedPtr`
+    bool immortal;
     static bool taint;
     #ifdef DEBUG_SHARED_PTR
     sass::string file;
@@ -116,6 +130,56 @@ namespace Sass {
     #endif
   };
 
+  // Counts live shared objects by their dynamic class. Objects are
+  // counted when they are created via `SASS_MEMORY_NEW` while the
+  // census is active on the current thread (see `ObjectCensus::Scope`),
+  // and uncounted by the same census when they get deleted via their
+  // last reference, on any thread and even if another census is active.
+  // Objects outliving their census are no longer counted anywhere.
+  // Uses the standard allocator to not disturb memory statistics.
+  class ObjectCensus {
+   public:
+    ObjectCensus();
+    ~ObjectCensus();
+    ObjectCensus(const ObjectCensus&) = delete;
+    ObjectCensus& operator=(const ObjectCensus&) = delete;
+    // Live objects for every class seen
+    std::vector<std::pair<std::string, size_t>> counts() const;
+    // Called for every object created by `SASS_MEMORY_NEW`. Only
+    // looks for the census of the thread while any is active.
+    template <class T> static T* add(T* obj) {
+      if (active.load(std::memory_order_relaxed)) count(obj);
+      return obj;
+    }
+    // Called before a counted object is deleted
+    static void remove(SharedObj* obj);
+    // RAII helper to activate a census on the current
+    // thread. Passing a null pointer suspends counting.
+    class Scope {
+     public:
+      Scope(ObjectCensus* census);
+      ~Scope();
+     private:
+      ObjectCensus* previous;
+    };
+   private:
+    // Scopes activating a census on any thread
+    static std::atomic<size_t> active;
+    static void count(SharedObj* obj);
+    // never reused, objects may outlive us
+    const uint32_t id;
+    // objects may be freed on other threads
+    mutable std::mutex mutex;
+    std::unordered_map<std::type_index, size_t> live;
+  };
+
+  // Immortals may be created lazily while a census is
+  // active, but they are never counted once shared.
+  inline void SharedObj::makeImmortal() {
+    if (census) ObjectCensus::remove(this);
+    immortal = true;
+  }
+
   // SharedPtr is a intermediate (template-less) base class for SharedImpl.
   // ToDo: there should be a way to include this in SharedImpl and to get
   // ToDo: rid of all the static_cast that are now needed in SharedImpl.
@@ -135,7 +199,7 @@ namespace Sass {
         decRefCount();
         node = other_node;
         incRefCount();
-      } else if (node != nullptr) {
+      } else if (node != nullptr && !node->immortal) {
         node->detached = false;
       }
       return *this;
@@ -147,7 +211,7 @@ namespace Sass {
 
     // Prevents all SharedPtrs from freeing this node until it is assigned to another SharedPtr.
     SharedObj* detach() {
-      if (node != nullptr) node->detached = true;
+      if (node != nullptr && !node->immortal) node->detached = true;
       #ifdef DEBUG_SHARED_PTR
       if (node->dbg) {
         std::cerr << "DETACHING NODE\n";
@@ -164,15 +228,21 @@ namespace Sass {
    protected:
     SharedObj* node;
     void decRefCount() {
-      if (node == nullptr) return;
+      if (node == nullptr || node->immortal) return;
       --node->refcount;
       #ifdef DEBUG_SHARED_PTR
       if (node->dbg) std::cerr << "- " << node << " X " << node->refcount << " (" << this << ") " << "\n";
       #endif
       if (node->refcount == 0 && !node->detached) {
+        #ifdef SASS_CUSTOM_ALLOCATOR
+        // Memory regions are given back in bulk, no need to
+        // run the destructors for everything left in them.
+        if (isReleasedMem(dynamic_cast<void*>(node))) return;
+        #endif
         #ifdef DEBUG_SHARED_PTR
         if (node->dbg) std::cerr << "DELETE NODE " << node << "\n";
         #endif
+        if (node->census) ObjectCensus::remove(node);
         delete node;
       }
       else if (node->refcount == 0) {
@@ -182,7 +252,7 @@ namespace Sass {
       }
     }
     void incRefCount() {
-      if (node == nullptr) return;
+      if (node == nullptr || node->immortal) return;
       node->detached = false;
       ++node->refcount;
       #ifdef DEBUG_SHARED_PTR
@@ -50,6 +50,9 @@ namespace Sass {
   {
 
     Emitter emitter(opt);
+    for (auto& shared : wbuf.smap.shared_ids) {
+      emitter.add_shared_source(shared.first, shared.second);
+    }
     Inspect inspect(emitter);
 
     size_t size_nodes = top_nodes.size();
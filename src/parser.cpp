@@ -2,7 +2,10 @@
 // __EXTENSIONS__ fix on Solaris.
 #include "sass.hpp"
 
+#include <cstring>
+
 #include "parser.hpp"
+#include "prefetch.hpp"
 #include "color_maps.hpp"
 #include "util_string.hpp"
 
@@ -31,13 +34,26 @@ namespace Sass {
     begin(source->begin()),
     position(source->begin()),
     end(source->end()),
-    before_token(0, 0),
-    after_token(0, 0),
     pstate(source->getSourceSpan()),
     traces(traces),
     indentation(0),
     nestings(0),
-    allow_parent(allow_parent)
+    allow_parent(allow_parent),
+    deferred_imports(nullptr),
+    requested_urls(nullptr),
+    requested_until(nullptr),
+    indented_syntax(false),
+    statements(),
+    statements_end(nullptr),
+    terminated(nullptr),
+    terminator(0),
+    statement_start(nullptr),
+    statement_next(nullptr),
+    statement_indent(0),
+    statement_children(false),
+    statement_block(false),
+    statement_property(false),
+    warnings(0)
   {
     Block_Obj root = SASS_MEMORY_NEW(Block, pstate);
     stack.push_back(Scope::Root);
@@ -49,8 +65,7 @@ namespace Sass {
       lex < css_comments >(false);
       // advance to position
       pstate.position += pstate.offset;
-      pstate.offset.column = 0;
-      pstate.offset.line = 0;
+      pstate.offset = 0;
     }
 
   SelectorListObj Parser::parse_selector(SourceData* source, Context& ctx, Backtraces traces, bool allow_parent)
@@ -70,6 +85,12 @@ namespace Sass {
   Block_Obj Parser::parse()
   {
 
+    // read the statements from a copy we may write into
+    if (indented_syntax) copy_statements();
+
+    // let the scanners compare whole chunks
+    Scanner::Buffer buffer(begin, end);
+
     // consume unicode BOM
     read_bom();
 
@@ -78,7 +99,7 @@ namespace Sass {
 
     // report invalid utf8
     if (it != end) {
-      pstate.position += Offset::init(position, it);
+      pstate.position = it - begin;
       traces.push_back(Backtrace(pstate));
       throw Exception::InvalidSass(pstate, traces, "Invalid UTF-8 sequence");
     }
@@ -87,14 +108,20 @@ namespace Sass {
     Block_Obj root = SASS_MEMORY_NEW(Block, pstate, 0, true);
 
     // check seems a bit esoteric but works
-    if (ctx.resources.size() == 1) {
+    // (no headers are used with deferred imports)
+    if (!deferred_imports && ctx.resources.size() == 1) {
       // apply headers only on very first include
       ctx.apply_custom_headers(root, getPath(), pstate);
     }
 
     // parse children nodes
     block_stack.push_back(root);
-    parse_block_nodes(true);
+    if (indented_syntax) {
+      parse_indented_nodes(0, true);
+    }
+    else {
+      parse_block_nodes(true);
+    }
     block_stack.pop_back();
 
     // update final position
@@ -114,6 +141,12 @@ namespace Sass {
   Block_Obj Parser::parse_css_block(bool is_root)
   {
 
+    // nested lines instead of braces (unless the
+    // whole block is on the line of the statement)
+    if (indented_syntax && !peek_css< exactly<'{'> >()) {
+      return parse_indented_block(is_root);
+    }
+
     // parse comments before block
     // lex < optional_css_comments >();
 
@@ -168,6 +201,7 @@ namespace Sass {
       if (peek < end_of_file >()) return true;
       if (peek < exactly<'}'> >()) return true;
 
+      MEMORY_GUARD(ctx.budget, pstate);
       if (parse_block_node(is_root)) continue;
 
       parse_block_comments();
@@ -183,6 +217,99 @@ namespace Sass {
     return true;
   }
 
+  // Perfect hash of the at-rules known by `parse_block_node`. The
+  // slot of a name is given by its length and some of its chars and
+  // every name has its own slot, so a lookup needs one comparison.
+  // The names are stored without the `@`.
+  struct DirectiveName {
+    const char* name;
+    size_t length;
+    Parser::Directive directive;
+  };
+
+  #define SASS_DIRECTIVE(name, directive) \
+    { name, sizeof(name) - 1, Parser::Directive::directive }
+  #define SASS_NO_DIRECTIVE \
+    { "", 0, Parser::Directive::Unknown }
+
+  constexpr size_t directive_slots = 32;
+
+  // names must have at least two chars
+  constexpr size_t directive_slot(const char* name, size_t length)
+  {
+    return (size_t((unsigned char) name[0]) + size_t((unsigned char) name[1]) +
+      4 * size_t((unsigned char) name[length - 1]) + 3 * length) % directive_slots;
+  }
+
+  constexpr DirectiveName directive_names[directive_slots] = {
+    SASS_DIRECTIVE("include", Include), SASS_DIRECTIVE("return", Return),
+    SASS_DIRECTIVE("while", While), SASS_NO_DIRECTIVE,
+    SASS_NO_DIRECTIVE, SASS_DIRECTIVE("media", Media),
+    SASS_DIRECTIVE("for", For), SASS_NO_DIRECTIVE,
+    SASS_NO_DIRECTIVE, SASS_NO_DIRECTIVE,
+    SASS_NO_DIRECTIVE, SASS_DIRECTIVE("function", Function),
+    SASS_DIRECTIVE("supports", Supports), SASS_DIRECTIVE("if", If),
+    SASS_DIRECTIVE("error", Error), SASS_NO_DIRECTIVE,
+    SASS_DIRECTIVE("charset", Charset), SASS_DIRECTIVE("else", Else),
+    SASS_DIRECTIVE("each", Each), SASS_NO_DIRECTIVE,
+    SASS_DIRECTIVE("debug", Debug), SASS_NO_DIRECTIVE,
+    SASS_NO_DIRECTIVE, SASS_DIRECTIVE("content", Content),
+    SASS_DIRECTIVE("import", Import), SASS_NO_DIRECTIVE,
+    SASS_DIRECTIVE("at-root", AtRoot), SASS_NO_DIRECTIVE,
+    SASS_DIRECTIVE("warn", Warn), SASS_DIRECTIVE("mixin", Mixin),
+    SASS_NO_DIRECTIVE, SASS_DIRECTIVE("extend", Extend),
+  };
+
+  #undef SASS_DIRECTIVE
+  #undef SASS_NO_DIRECTIVE
+
+  // every name must be stored in its own slot
+  constexpr bool directives_hashed(size_t slot = 0)
+  {
+    return slot == directive_slots || (
+      (directive_names[slot].length == 0 || directive_slot(
+        directive_names[slot].name, directive_names[slot].length) == slot
+      ) && directives_hashed(slot + 1));
+  }
+
+  static_assert(directives_hashed(), "directive names are not in their slot");
+
+  // Lex the at-rule if it has its own parser. The token is the same
+  // as if lexed with its `kwd_*` prelexer, otherwise nothing is lexed.
+  Parser::Directive Parser::lex_directive()
+  {
+    // skip over spaces, tabs and line comments
+    const char* it_before_token = sneak < at_keyword >(position);
+    // shorthands of the indented syntax at the start of a statement
+    if (it_before_token == statement_start && (*it_before_token == '=' || (*it_before_token == '+' &&
+      it_before_token[1] != ' ' && it_before_token[1] != '\t' && it_before_token[1] != 0))) {
+      lexed = Token(position, it_before_token, it_before_token + 1);
+      pstate = SourceSpan(source, it_before_token - begin, 1);
+      position = it_before_token + 1;
+      return *it_before_token == '=' ? Directive::Mixin : Directive::Include;
+    }
+    if (*it_before_token != '@') return Directive::Unknown;
+    // all known names are made of letters and hyphens
+    const char* name = it_before_token + 1;
+    const char* it_after_token = name;
+    while (Util::ascii_isalpha(static_cast<unsigned char>(*it_after_token)) || *it_after_token == '-') {
+      ++ it_after_token;
+    }
+    size_t length = it_after_token - name;
+    if (length < 2 || it_after_token > end) return Directive::Unknown;
+    const DirectiveName& known = directive_names[directive_slot(name, length)];
+    if (known.length != length || std::memcmp(known.name, name, length) != 0) return Directive::Unknown;
+    // `@else` is matched without a word boundary
+    if (known.directive != Directive::Else && !word_boundary(it_after_token)) return Directive::Unknown;
+    // create new lexed token object (holds the parse results)
+    lexed = Token(position, it_before_token, it_after_token);
+    // span of the current token (without whitespace before)
+    pstate = SourceSpan(source, it_before_token - begin, it_after_token - it_before_token);
+    // advance internal char iterator
+    position = it_after_token;
+    return known.directive;
+  }
+
   // parser for a single node in a block
   // semicolons must be lexed beforehand
   bool Parser::parse_block_node(bool is_root) {
@@ -196,63 +323,92 @@ namespace Sass {
     lex < css_whitespace >();
 
     Lookahead lookahead_result;
+    Directive directive;
 
     // also parse block comments
 
     // first parse everything that is allowed in functions
     if (lex < variable >(true)) { block->append(parse_assignment()); }
-    else if (lex < kwd_err >(true)) { block->append(parse_error()); }
-    else if (lex < kwd_dbg >(true)) { block->append(parse_debug()); }
-    else if (lex < kwd_warn >(true)) { block->append(parse_warning()); }
-    else if (lex < kwd_if_directive >(true)) { block->append(parse_if_directive()); }
-    else if (lex < kwd_for_directive >(true)) { block->append(parse_for_directive()); }
-    else if (lex < kwd_each_directive >(true)) { block->append(parse_each_directive()); }
-    else if (lex < kwd_while_directive >(true)) { block->append(parse_while_directive()); }
-    else if (lex < kwd_return_directive >(true)) { block->append(parse_return_directive()); }
-
-    // parse imports to process later
-    else if (lex < kwd_import >(true)) {
-      Scope parent = stack.empty() ? Scope::Rules : stack.back();
-      if (parent != Scope::Function && parent != Scope::Root && parent != Scope::Rules && parent != Scope::Media) {
-        if (! peek_css< uri_prefix >(position)) { // this seems to go in ruby sass 3.4.20
-          error("Import directives may not be used within control directives or mixins.");
+
+    // at-rules with their own parser, a selector never starts with `@`
+    else if ((directive = lex_directive()) != Directive::Unknown) {
+      switch (directive) {
+        case Directive::Error: block->append(parse_error()); break;
+        case Directive::Debug: block->append(parse_debug()); break;
+        case Directive::Warn: block->append(parse_warning()); break;
+        case Directive::If: block->append(parse_if_directive()); break;
+        case Directive::For: block->append(parse_for_directive()); break;
+        case Directive::Each: block->append(parse_each_directive()); break;
+        case Directive::While: block->append(parse_while_directive()); break;
+        case Directive::Return: block->append(parse_return_directive()); break;
+
+        // parse imports to process later
+        case Directive::Import: {
+          Scope parent = stack.empty() ? Scope::Rules : stack.back();
+          if (parent != Scope::Function && parent != Scope::Root && parent != Scope::Rules && parent != Scope::Media) {
+            if (! peek_css< uri_prefix >(position)) { // this seems to go in ruby sass 3.4.20
+              error("Import directives may not be used within control directives or mixins.");
+            }
+          }
+          // let asynchronous importers work on all of them
+          if (position >= requested_until && ctx.has_async_importer()) request_imports();
+          // this puts the parsed doc into sheets
+          // import stub will fetch this in expand
+          Import_Obj imp = parse_import();
+          // if it is a url, we only add the statement
+          if (!imp->urls().empty()) block->append(imp);
+          // process all resources now (add Import_Stub nodes)
+          for (size_t i = 0, S = imp->incs().size(); i < S; ++i) {
+            Import_Stub* stub = SASS_MEMORY_NEW(Import_Stub, pstate, imp->incs()[i]);
+            if (deferred_imports) deferred_stubs.push_back(stub);
+            block->append(stub);
+          }
+          break;
         }
-      }
-      // this puts the parsed doc into sheets
-      // import stub will fetch this in expand
-      Import_Obj imp = parse_import();
-      // if it is a url, we only add the statement
-      if (!imp->urls().empty()) block->append(imp);
-      // process all resources now (add Import_Stub nodes)
-      for (size_t i = 0, S = imp->incs().size(); i < S; ++i) {
-        block->append(SASS_MEMORY_NEW(Import_Stub, pstate, imp->incs()[i]));
-      }
-    }
 
-    else if (lex < kwd_extend >(true)) {
-      Lookahead lookahead = lookahead_for_include(position);
-      if (!lookahead.found) css_error("Invalid CSS", " after ", ": expected selector, was ");
-      SelectorListObj target;
-      if (!lookahead.has_interpolants) {
-        LOCAL_FLAG(allow_parent, false);
-        auto selector = parseSelectorList(true);
-        auto extender = SASS_MEMORY_NEW(ExtendRule, pstate, selector);
-        extender->isOptional(selector && selector->is_optional());
-        block->append(extender);
-      }
-      else {
-        LOCAL_FLAG(allow_parent, false);
-        auto selector = parse_selector_schema(lookahead.found, true);
-        auto extender = SASS_MEMORY_NEW(ExtendRule, pstate, selector);
-        // A schema is not optional yet, check once it is evaluated
-        // extender->isOptional(selector && selector->is_optional());
-        block->append(extender);
-      }
+        case Directive::Extend: {
+          Lookahead lookahead = lookahead_for_include(position);
+          if (!lookahead.found) css_error("Invalid CSS", " after ", ": expected selector, was ");
+          SelectorListObj target;
+          if (!lookahead.has_interpolants) {
+            LOCAL_FLAG(allow_parent, false);
+            auto selector = parseSelectorList(true);
+            auto extender = SASS_MEMORY_NEW(ExtendRule, pstate, selector);
+            extender->isOptional(selector && selector->is_optional());
+            block->append(extender);
+          }
+          else {
+            LOCAL_FLAG(allow_parent, false);
+            auto selector = parse_selector_schema(lookahead.found, true);
+            auto extender = SASS_MEMORY_NEW(ExtendRule, pstate, selector);
+            // A schema is not optional yet, check once it is evaluated
+            // extender->isOptional(selector && selector->is_optional());
+            block->append(extender);
+          }
+          break;
+        }
+
+        // parse multiple specific keyword directives
+        case Directive::Media: block->append(parseMediaRule()); break;
+        case Directive::AtRoot: block->append(parse_at_root_block()); break;
+        case Directive::Include: block->append(parse_include_directive()); break;
+        case Directive::Content: block->append(parse_content_directive()); break;
+        case Directive::Supports: block->append(parse_supports_directive()); break;
+        case Directive::Mixin: block->append(parse_definition(Definition::MIXIN)); break;
+        case Directive::Function: block->append(parse_definition(Definition::FUNCTION)); break;
 
+        // ignore the @charset directive for now
+        case Directive::Charset: parse_charset_directive(); break;
+
+        case Directive::Else: error("Invalid CSS: @else must come after @if"); break;
+
+        case Directive::Unknown: break;
+      }
     }
 
     // selector may contain interpolations which need delayed evaluation
-    else if (
+    // (never for properties in the `:name value` syntax)
+    else if (!statement_property &&
       !(lookahead_result = lookahead_for_selector(position)).error &&
       !lookahead_result.is_custom_property
     )
@@ -260,18 +416,7 @@ namespace Sass {
       block->append(parse_ruleset(lookahead_result));
     }
 
-    // parse multiple specific keyword directives
-    else if (lex < kwd_media >(true)) { block->append(parseMediaRule()); }
-    else if (lex < kwd_at_root >(true)) { block->append(parse_at_root_block()); }
-    else if (lex < kwd_include_directive >(true)) { block->append(parse_include_directive()); }
-    else if (lex < kwd_content_directive >(true)) { block->append(parse_content_directive()); }
-    else if (lex < kwd_supports_directive >(true)) { block->append(parse_supports_directive()); }
-    else if (lex < kwd_mixin >(true)) { block->append(parse_definition(Definition::MIXIN)); }
-    else if (lex < kwd_function >(true)) { block->append(parse_definition(Definition::FUNCTION)); }
-
-    // ignore the @charset directive for now
-    else if (lex< kwd_charset_directive >(true)) { parse_charset_directive(); }
-
+    // `@else` is also an error if not followed by a word boundary
     else if (lex < exactly < else_kwd >>(true)) { error("Invalid CSS: @else must come after @if"); }
 
     // generic at keyword (keep last)
@@ -291,7 +436,7 @@ namespace Sass {
       decl->tabs(indentation);
       block->append(decl);
       // maybe we have a "sub-block"
-      if (peek< exactly<'{'> >()) {
+      if (peek< exactly<'{'> >() || peek_indented_block()) {
         if (decl->is_indented()) ++ indentation;
         // parse a propset that rides on the declaration's property
         stack.push_back(Scope::Properties);
@@ -337,6 +482,12 @@ namespace Sass {
         if (!lex< exactly<')'> >()) error("URI is missing ')'");
         to_import.push_back(std::pair<sass::string, Function_Call_Obj>("", result));
       }
+      // the indented syntax also takes unquoted urls
+      else if (indented_syntax && lex< re_indented_import >()) {
+        sass::string url(lexed);
+        url.erase(url.find_last_not_of(" \t\n\v\f\r") + 1);
+        to_import.push_back(std::pair<sass::string,Function_Call_Obj>("\"" + url + "\"", {}));
+      }
       else {
         if (first) error("@import directive requires a url or quoted path");
         else error("expecting another url or quoted path in @import list");
@@ -353,19 +504,51 @@ namespace Sass {
       if (location.second) {
         imp->urls().push_back(location.second);
       }
+      else if (requested_urls) {
+        requested_urls->push_back(unquote(location.first));
+      }
       // check if custom importers want to take over the handling
-      else if (!ctx.call_importers(unquote(location.first), getPath(), pstate, imp)) {
+      // (never the case if the file imports are deferred)
+      else if (deferred_imports || !ctx.call_importers(unquote(location.first), getPath(), pstate, imp)) {
         // nobody wants it, so we do our import
-        ctx.import_url(imp, location.first, getPath());
+        ctx.import_url(imp, location.first, getPath(), deferred_imports);
       }
     }
 
     return imp;
   }
 
+  // Collect the urls of the import statement and of the ones right
+  // after it (called after `@import` was lexed) and request them from
+  // the custom importers at once. The indented syntax only requests the
+  // urls of one statement, since its statements are parsed in place.
+  void Parser::request_imports()
+  {
+    sass::vector<sass::string> urls;
+    // errors are reported by the normal parse
+    Parser p(source, ctx, {});
+    p.requested_urls = &urls;
+    // the copy of an indented source up to the end of the statement
+    p.begin = begin;
+    p.end = end;
+    p.position = position;
+    p.pstate = pstate;
+    p.indented_syntax = indented_syntax;
+    try {
+      do {
+        p.parse_import();
+        if (indented_syntax || !p.lex_css< exactly<';'> >()) break;
+        p.lex< css_comments >(false);
+      } while (p.lex_directive() == Directive::Import);
+    }
+    catch (...) {}
+    requested_until = p.position;
+    ctx.request_imports(urls, getPath());
+  }
+
   Definition_Obj Parser::parse_definition(Definition::Type which_type)
   {
-    sass::string which_str(lexed);
+    sass::string which_str(which_type == Definition::MIXIN ? "@mixin" : "@function");
     if (!lex< identifier >()) error("invalid name in " + which_str + " definition");
     sass::string name(Util::normalize_underscores(lexed));
     if (which_type == Definition::FUNCTION && (name == "and" || name == "or" || name == "not"))
@@ -552,9 +735,8 @@ namespace Sass {
         // accumulate the preceding segment if the position has advanced
         if (i < p) {
           sass::string parsed(i, p);
+          pstate = SourceSpan(source, i - begin, p - i);
           String_Constant_Obj str = SASS_MEMORY_NEW(String_Constant, pstate, parsed);
-          pstate.position += Offset(parsed);
-          str->update_pstate(pstate);
           schema->append(str);
         }
 
@@ -575,7 +757,7 @@ namespace Sass {
         // add to the string schema
         schema->append(interpolant);
         // advance parser state
-        pstate.position.add(p+2, j);
+        pstate = SourceSpan(source, p - begin, j - p);
         // advance position
         i = j;
       }
@@ -585,9 +767,8 @@ namespace Sass {
         // make sure to add the last bits of the string up to the end (if any)
         if (i < end_of_selector) {
           sass::string parsed(i, end_of_selector);
+          pstate = SourceSpan(source, i - begin, end_of_selector - i);
           String_Constant_Obj str = SASS_MEMORY_NEW(String_Constant, pstate, parsed);
-          pstate.position += Offset(parsed);
-          str->update_pstate(pstate);
           i = end_of_selector;
           schema->append(str);
         }
@@ -603,8 +784,6 @@ namespace Sass {
     selector_schema->update_pstate(pstate);
     schema->update_pstate(pstate);
 
-    after_token = before_token = pstate.position;
-
     // return parsed result
     return selector_schema.detach();
   }
@@ -612,6 +791,8 @@ namespace Sass {
 
   void Parser::parse_charset_directive()
   {
+    // ends with the statement in the indented syntax
+    if (indented_syntax && lex < sequence < quoted_string, optional_spaces, end_of_file > >()) return;
     lex <
       sequence <
         quoted_string,
@@ -644,7 +825,7 @@ namespace Sass {
     if (has_parameters) call->block_parameters(parse_parameters());
 
     // parse optional block
-    if (peek < exactly <'{'> >()) {
+    if (peek < exactly <'{'> >() || peek_indented_block()) {
       call->block(parse_block());
     }
     else if (has_parameters)  {
@@ -860,6 +1041,12 @@ namespace Sass {
   Declaration_Obj Parser::parse_declaration() {
     String_Obj prop;
     bool is_custom_property = false;
+    // the indented syntax also has `:name value`
+    bool colon_first = statement_property;
+    if (colon_first) {
+      statement_property = false;
+      lex< exactly<':'> >();
+    }
     if (lex< sequence< optional< exactly<'*'> >, identifier_schema > >()) {
       const sass::string property(lexed);
       is_custom_property = property.compare(0, 2, "--") == 0;
@@ -875,14 +1062,14 @@ namespace Sass {
     }
     bool is_indented = true;
     const sass::string property(lexed);
-    if (!lex_css< one_plus< exactly<':'> > >()) error("property \"" + escape_string(property)  + "\" must be followed by a ':'");
+    if (!colon_first && !lex_css< one_plus< exactly<':'> > >()) error("property \"" + escape_string(property)  + "\" must be followed by a ':'");
     if (!is_custom_property && match< sequence< optional_css_comments, exactly<';'> > >()) error("style declaration must contain a value");
-    if (match< sequence< optional_css_comments, exactly<'{'> > >()) is_indented = false; // don't indent if value is empty
+    if (match< sequence< optional_css_comments, exactly<'{'> > >() || peek_indented_block()) is_indented = false; // don't indent if value is empty
     if (is_custom_property) {
       return SASS_MEMORY_NEW(Declaration, prop->pstate(), prop, parse_css_variable_value(), false, true);
     }
     lex < css_comments >(false);
-    if (peek_css< static_value >()) {
+    if (peek_css< static_value >() || (indented_syntax && !statement_block && peek_css< indented_static_value >())) {
       return SASS_MEMORY_NEW(Declaration, prop->pstate(), prop, parse_static_value()/*, lex<kwd_important>()*/);
     }
     else {
@@ -898,7 +1085,7 @@ namespace Sass {
       else {
         value = parse_list(DELAYED);
         if (List* list = Cast<List>(value)) {
-          if (!list->is_bracketed() && list->length() == 0 && !peek< exactly <'{'> >()) {
+          if (!list->is_bracketed() && list->length() == 0 && !peek< exactly <'{'> >() && !peek_indented_block()) {
             css_error("Invalid CSS", " after ", ": expected expression (e.g. 1px, bold), was ");
           }
         }
@@ -1462,6 +1649,8 @@ namespace Sass {
     if (lex< ampersand >())
     {
       if (match< ampersand >()) {
+        // must be reported in order
+        if (deferred_imports) throw ImportPrefetcher::Retry();
         warning("In Sass, \"&&\" means two copies of the parent selector. You probably want to use \"and\" instead.", pstate);
       }
       return SASS_MEMORY_NEW(Parent_Reference, pstate); }
@@ -1565,10 +1754,13 @@ namespace Sass {
         }
         const char* j = skip_over_scopes< exactly<hash_lbrace>, exactly<rbrace> >(p + 2, chunk.end); // find the closing brace
         if (j) { --j;
-          // parse the interpolant and accumulate it
+          // parse the interpolant and accumulate it,
+          // but keep the span of the chunk for the caller
+          SourceSpan chunk_pstate(pstate);
           LocalOption<const char*> partEnd(end, j);
           LocalOption<const char*> partBeg(position, p + 2);
           ExpressionObj interp_node = parse_list();
+          pstate = chunk_pstate;
           interp_node->is_interpolant(true);
           schema->append(interp_node);
           i = j;
@@ -1650,12 +1842,16 @@ namespace Sass {
 
   ValueObj Parser::parse_static_value()
   {
+    // without an end delimiter at the end of an indented statement
+    if (indented_syntax && lex< indented_static_value >()) {
+      Token str(lexed);
+      return color_or_string(str.time_wspace());
+    }
     lex< static_value >();
     Token str(lexed);
     // static values always have trailing white-
     // space and end delimiter (\s*[;]$) included
-    --pstate.offset.column;
-    --after_token.column;
+    --pstate.offset;
     --str.end;
     --position;
 
@@ -1690,10 +1886,13 @@ namespace Sass {
         }
         const char* j = skip_over_scopes< exactly<hash_lbrace>, exactly<rbrace> >(p+2, str.end); // find the closing brace
         if (j) {
-          // parse the interpolant and accumulate it
+          // parse the interpolant and accumulate it,
+          // but keep the span of the chunk for the caller
+          SourceSpan chunk_pstate(pstate);
           LocalOption<const char*> partEnd(end, j);
           LocalOption<const char*> partBeg(position, p + 2);
           ExpressionObj interp_node = parse_list();
+          pstate = chunk_pstate;
           interp_node->is_interpolant(true);
           schema->append(interp_node);
           i = j;
@@ -1736,8 +1935,12 @@ namespace Sass {
 
   String_Schema_Obj Parser::parse_value_schema(const char* stop)
   {
+    // the schema spans from its first token up to the stop
+    const char* start = position;
+    while (start < stop && Util::ascii_isspace(static_cast<unsigned char>(*start))) ++start;
     // initialize the string schema object to add tokens
-    String_Schema_Obj schema = SASS_MEMORY_NEW(String_Schema, pstate);
+    String_Schema_Obj schema = SASS_MEMORY_NEW(String_Schema,
+      SourceSpan(source, start - begin, stop - start));
 
     if (peek<exactly<'}'>>()) {
       css_error("Invalid CSS", " after ", ": expected expression (e.g. 1px, bold), was ");
@@ -1870,10 +2073,13 @@ namespace Sass {
         }
         const char* j = skip_over_scopes< exactly<hash_lbrace>, exactly<rbrace> >(p+2, id.end); // find the closing brace
         if (j) {
-          // parse the interpolant and accumulate it
+          // parse the interpolant and accumulate it,
+          // but keep the span of the chunk for the caller
+          SourceSpan chunk_pstate(pstate);
           LocalOption<const char*> partEnd(end, j);
           LocalOption<const char*> partBeg(position, p + 2);
           ExpressionObj interp_node = parse_list(DELAYED);
+          pstate = chunk_pstate;
           interp_node->is_interpolant(true);
           schema->append(interp_node);
           // schema->has_interpolants(true);
@@ -2015,6 +2221,7 @@ namespace Sass {
     ExpressionObj predicate = parse_list();
     Block_Obj block = parse_block(root);
     Block_Obj alternative;
+    if (indented_syntax) lex_indented_else();
 
     // only throw away comment if we parse a case
     // we want all other comments to be parsed
@@ -2222,7 +2429,7 @@ namespace Sass {
   {
     advanceToNextToken();
     List_Obj queries = SASS_MEMORY_NEW(List, pstate, 0, SASS_COMMA);
-    if (!peek_css < exactly <'{'> >()) queries->append(parse_media_query());
+    if (!peek_css < exactly <'{'> >() && !peek_indented_block()) queries->append(parse_media_query());
     while (lex_css < exactly <','> >()) queries->append(parse_media_query());
     queries->update_pstate(pstate);
     return queries.detach();
@@ -2395,7 +2602,7 @@ namespace Sass {
     if (lex_css< exactly<'('> >()) {
       expr = parse_at_root_query();
     }
-    if (peek_css < exactly<'{'> >()) {
+    if (peek_css < exactly<'{'> >() || peek_indented_block()) {
       lex <optional_spaces>();
       body = parse_block(true);
     }
@@ -2442,7 +2649,7 @@ namespace Sass {
     String_Schema_Obj val = parse_almost_any_value();
     // strip left and right if they are of type string
     directive->value(val);
-    if (peek< exactly<'{'> >()) {
+    if (peek< exactly<'{'> >() || peek_indented_block()) {
       directive->block(parse_block());
     }
     return directive;
@@ -2649,7 +2856,9 @@ namespace Sass {
       else if (peek < exactly<'('> >(q)) rv.found = q;
       // else if (peek < exactly<';'> >(q)) rv.found = q;
       // else if (peek < exactly<'}'> >(q)) rv.found = q;
-      if (rv.found || *p == 0) rv.error = 0;
+      // statements of the indented syntax end with a null char
+      else if (peek_indented_block(q)) rv.found = q;
+      if (rv.found || (*p == 0 && !indented_syntax)) rv.error = 0;
     }
 
     rv.parsable = ! rv.has_interpolants;
@@ -2671,12 +2880,67 @@ namespace Sass {
       // check for additional abort condition
       if (peek < exactly<';'> >(p)) rv.found = p;
       else if (peek < exactly<'}'> >(p)) rv.found = p;
+      else if (indented_syntax && peek < end_of_file >(p)) rv.found = p;
     }
     // return result
     return rv;
   }
   // EO lookahead_for_include
 
+  // tokens of a value with interpolations up to its end
+  template <prelexer value_end>
+  static const char* value_tokens(const char* src)
+  {
+    return non_greedy <
+      alternatives <
+        // consume whitespace
+        block_comment, // spaces,
+        // main tokens
+        sequence <
+          interpolant,
+          optional <
+            quoted_string
+          >
+        >,
+        identifier,
+        variable,
+        // issue #442
+        sequence <
+          parenthese_scope,
+          interpolant,
+          optional <
+            quoted_string
+          >
+        >
+      >,
+      value_end
+    >(src);
+  }
+
+  static const char* value_end(const char* src)
+  {
+    return sequence <
+      // optional_spaces,
+      alternatives <
+        // end_of_file,
+        exactly<'{'>,
+        exactly<'}'>,
+        exactly<';'>
+      >
+    >(src);
+  }
+
+  // statements of the indented syntax end with a null char
+  static const char* indented_value_end(const char* src)
+  {
+    return alternatives <
+      end_of_file,
+      exactly<'{'>,
+      exactly<'}'>,
+      exactly<';'>
+    >(src);
+  }
+
   // look ahead for a token with interpolation in it
   // we mostly use the result if there is an interpolation
   // everything that passes here gets parsed as one schema
@@ -2688,41 +2952,9 @@ namespace Sass {
     // get start position
     const char* p = start ? start : position;
     // match in one big "regex"
-    if (const char* q =
-      peek <
-        non_greedy <
-          alternatives <
-            // consume whitespace
-            block_comment, // spaces,
-            // main tokens
-            sequence <
-              interpolant,
-              optional <
-                quoted_string
-              >
-            >,
-            identifier,
-            variable,
-            // issue #442
-            sequence <
-              parenthese_scope,
-              interpolant,
-              optional <
-                quoted_string
-              >
-            >
-          >,
-          sequence <
-            // optional_spaces,
-            alternatives <
-              // end_of_file,
-              exactly<'{'>,
-              exactly<'}'>,
-              exactly<';'>
-            >
-          >
-        >
-      >(p)
+    if (const char* q = indented_syntax ?
+      peek < value_tokens < indented_value_end > >(p) :
+      peek < value_tokens < value_end > >(p)
     ) {
       if (p == q) return rv;
       while (p < q) {
@@ -2741,6 +2973,7 @@ namespace Sass {
       if (peek < exactly<'{'> >(q)) rv.found = q;
       else if (peek < exactly<';'> >(q)) rv.found = q;
       else if (peek < exactly<'}'> >(q)) rv.found = q;
+      else if (indented_syntax && peek < end_of_file >(q)) rv.found = q;
     }
 
     // return result
@@ -2893,6 +3126,12 @@ namespace Sass {
     throw Exception::InvalidSass(pstate, traces, msg);
   }
 
+  void Parser::warning(sass::string msg, SourceSpan pstate)
+  {
+    ++warnings;
+    Sass::warning(msg, pstate);
+  }
+
   // print a css parsing error with actual context information from parsed source
   void Parser::css_error(const sass::string& msg, const sass::string& prefix, const sass::string& middle, const bool trim)
   {
@@ -40,6 +40,13 @@ namespace Sass {
 
     enum Scope { Root, Mixin, Function, Media, Control, Properties, Rules, AtRoot };
 
+    // at-rules with their own parser (see `lex_directive`)
+    enum class Directive {
+      Unknown, Error, Debug, Warn, If, Else, For, Each, While, Return,
+      Import, Extend, Media, AtRoot, Include, Content, Supports,
+      Mixin, Function, Charset
+    };
+
     Context& ctx;
     sass::vector<Block_Obj> block_stack;
     sass::vector<Scope> stack;
@@ -47,14 +54,47 @@ namespace Sass {
     const char* begin;
     const char* position;
     const char* end;
-    Offset before_token;
-    Offset after_token;
     SourceSpan pstate;
     Backtraces traces;
     size_t indentation;
     size_t nestings;
     bool allow_parent;
     Token lexed;
+    // only add file imports here instead of loading
+    // them, resolved later (see `ImportPrefetcher`)
+    sass::vector<CachedImport>* deferred_imports;
+    // stubs of the deferred imports in same order
+    sass::vector<Import_Stub_Obj> deferred_stubs;
+    // only collect the urls for the custom importers
+    // (see `request_imports`)
+    sass::vector<sass::string>* requested_urls;
+    // end of the imports requested ahead of time
+    const char* requested_until;
+    // parse the indented syntax (see `parser_indented.cpp`)
+    bool indented_syntax;
+    // copy of the indented source the statements are terminated
+    // in, since the source may be shared or mapped read-only
+    sass::string statements;
+    // end of the copy (`end` is narrowed to the current statement)
+    const char* statements_end;
+    // null char written at the end of the current statement
+    // of the indented syntax and the char it replaced
+    char* terminated;
+    char terminator;
+    // first char of the current statement (for the shorthands)
+    const char* statement_start;
+    // start of the line after the current statement
+    const char* statement_next;
+    // indentation of the current statement
+    size_t statement_indent;
+    // lines are nested beneath the current statement
+    bool statement_children;
+    // the current statement takes a block (nested lines or selectors)
+    bool statement_block;
+    // the current statement is a property in the `:name value` syntax
+    bool statement_property;
+    // number of warnings we printed
+    size_t warnings;
 
     Parser(SourceData* source, Context& ctx, Backtraces, bool allow_parent = true);
 
@@ -173,14 +213,9 @@ namespace Sass {
       // create new lexed token object (holds the parse results)
       lexed = Token(position, it_before_token, it_after_token);
 
-      // advance position (add whitespace before current token)
-      before_token = after_token.add(position, it_before_token);
-
-      // update after_token position for current token
-      after_token.add(it_before_token, it_after_token);
-
-      // ToDo: could probably do this incremental on original object (API wants offset?)
-      pstate = SourceSpan(source, before_token, after_token - before_token);
+      // span of the current token (without whitespace before)
+      pstate = SourceSpan(source, it_before_token - begin,
+        it_after_token ? it_after_token - it_before_token : 0);
 
       // advance internal char iterator
       return position = it_after_token;
@@ -197,8 +232,6 @@ namespace Sass {
       Token prev = lexed;
       // store previous pointer
       const char* oldpos = position;
-      Offset bt = before_token;
-      Offset at = after_token;
       SourceSpan op = pstate;
       // throw away comments
       // update srcmap position
@@ -210,8 +243,6 @@ namespace Sass {
         pstate = op;
         lexed = prev;
         position = oldpos;
-        after_token = at;
-        before_token = bt;
       }
       // return match
       return pos;
@@ -232,6 +263,7 @@ namespace Sass {
 #endif
 
     void error(sass::string msg);
+    void warning(sass::string msg, SourceSpan pstate);
     // generate message with given and expected sample
     // text before and in the middle are configurable
     void css_error(const sass::string& msg,
@@ -242,6 +274,7 @@ namespace Sass {
 
     Block_Obj parse();
     Import_Obj parse_import();
+    void request_imports();
     Definition_Obj parse_definition(Definition::Type which_type);
     Parameters_Obj parse_parameters();
     Parameter_Obj parse_parameter();
@@ -263,6 +296,18 @@ namespace Sass {
     Block_Obj parse_css_block(bool is_root = false);
     bool parse_block_nodes(bool is_root = false);
     bool parse_block_node(bool is_root = false);
+    Directive lex_directive();
+
+    // the indented syntax
+    void parse_indented_nodes(size_t indent, bool is_root = false);
+    Block_Obj parse_indented_block(bool is_root = false);
+    void parse_indented_comment(const char* start, size_t indent);
+    void lex_indented_else();
+    bool peek_indented_block(const char* start = 0);
+    void copy_statements();
+    void terminate_statement(const char* start, size_t indent);
+    void terminate(const char* stop);
+    void release_statement();
 
     Declaration_Obj parse_declaration();
     ExpressionObj parse_map();
@@ -385,6 +430,7 @@ namespace Sass {
 
     static const char* re_attr_sensitive_close(const char* src);
     static const char* re_attr_insensitive_close(const char* src);
+    static const char* re_indented_import(const char* src);
 
   };
 
@@ -0,0 +1,420 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include "parser.hpp"
+
+// Parser for the indented syntax (`.sass` files). Statements end at
+// the line break instead of a `;` and the lines nested beneath them
+// form their block instead of braces. Every statement is parsed by
+// the scss parser, with `end` narrowed to the line break at its end
+// and a null char written over it while it is parsed, so it stops
+// there like at the end of the source (in a copy of the source, see
+// `copy_statements`). Where a `{` is expected, `peek_indented_block`
+// tells if the statement takes a block, a block in braces on the line
+// itself is parsed like in scss. The rules for what a line means are
+// the same as for the former conversion to scss in `sass2scss`.
+
+namespace Sass {
+
+  using namespace Prelexer;
+  using namespace Constants;
+
+  static bool is_indent(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+  }
+
+  static bool is_linefeed(char c)
+  {
+    return c == '\n' || c == '\r';
+  }
+
+  static bool starts_with(const char* src, const char* prefix)
+  {
+    return std::strncmp(src, prefix, std::strlen(prefix)) == 0;
+  }
+
+  // the line break of the line (or the end of the source)
+  static const char* line_end(const char* line)
+  {
+    while (*line != 0 && !is_linefeed(*line)) ++ line;
+    return line;
+  }
+
+  // start of the line after the line break
+  static const char* next_line(const char* end)
+  {
+    if (*end == '\r') ++ end;
+    if (*end == '\n') ++ end;
+    return end;
+  }
+
+  static size_t line_indent(const char* line)
+  {
+    size_t indent = 0;
+    while (is_indent(line[indent])) ++ indent;
+    return indent;
+  }
+
+  static bool is_blank(const char* line)
+  {
+    const char* it = line + line_indent(line);
+    return *it == 0 || is_linefeed(*it);
+  }
+
+  static const char* skip_blank_lines(const char* line)
+  {
+    while (*line != 0 && is_blank(line)) line = next_line(line_end(line));
+    return line;
+  }
+
+  static bool is_comment(const char* start)
+  {
+    return starts_with(start, "//") || starts_with(start, "/*");
+  }
+
+  // The `//` comment at the end of the line, which is not in a string,
+  // parentheses or a block comment (or the end if there is none).
+  static const char* line_comment(const char* line, const char* end)
+  {
+    bool quoted = false, apoed = false, comment = false;
+    size_t brackets = 0;
+    for (const char* it = line; it < end; ++ it) {
+      switch (*it) {
+        case '(': if (!quoted && !apoed) ++ brackets; break;
+        case ')': if (!quoted && !apoed) -- brackets; break;
+        case '"': if (!apoed && !comment) quoted = !quoted; break;
+        case '\'': if (!quoted && !comment) apoed = !apoed; break;
+        case '\\': if (quoted || apoed) ++ it; break;
+        case '*':
+          if (it > line && it[-1] == '/' && !quoted && !apoed) comment = true;
+          break;
+        case '/':
+          if (it > line && it[-1] == '*') comment = false;
+          else if (it > line && it[-1] == '/') {
+            if (!quoted && !apoed && !comment && brackets == 0) return it - 1;
+          }
+          break;
+      }
+    }
+    return end;
+  }
+
+  // end of the code on the line (without the comment and whitespace)
+  static const char* code_end(const char* line)
+  {
+    const char* end = line_comment(line, line_end(line));
+    while (end > line && Util::ascii_isspace(static_cast<unsigned char>(end[-1]))) -- end;
+    return end;
+  }
+
+  // the name of the `:name` line is a pseudo class
+  static bool is_pseudo_class(const char* name, const char* end)
+  {
+    static const char* pseudo_classes[] = {
+      "link", "visited", "active", "lang", "first-child", "hover",
+      "focus", "first", "target", "root", "nth-child", "nth-last-of-child",
+      "nth-of-type", "nth-last-of-type", "last-child", "first-of-type",
+      "last-of-type", "only-child", "only-of-type", "empty", "not",
+      "default", "valid", "invalid", "in-range", "out-of-range",
+      "required", "optional", "read-only", "read-write", "dir",
+      "enabled", "disabled", "checked", "indeterminate", "nth-last-child",
+      "any-link", "local-link", "scope", "active-drop-target",
+      "valid-drop-target", "invalid-drop-target", "current", "past",
+      "future", "placeholder-shown", "user-error", "blank", "nth-match",
+      "nth-last-match", "nth-column", "nth-last-column", "matches",
+      "fullscreen"
+    };
+    sass::string pseudo;
+    while (name < end && (Util::ascii_isalpha(static_cast<unsigned char>(*name)) || *name == '-')) {
+      pseudo += Util::ascii_tolower(*name ++);
+    }
+    for (const char* pseudo_class : pseudo_classes) {
+      if (pseudo == pseudo_class) return true;
+    }
+    return false;
+  }
+
+  // the value of the `:name value` line (or the end if there is none)
+  static const char* colon_value(const char* start, const char* end, const char*& name_end)
+  {
+    name_end = start;
+    while (name_end < end && !Util::ascii_isspace(static_cast<unsigned char>(*name_end))) ++ name_end;
+    const char* value = name_end;
+    while (value < end && Util::ascii_isspace(static_cast<unsigned char>(*value))) ++ value;
+    return value;
+  }
+
+  // A `:name value` line is a selector if it's a pseudo class or the
+  // value starts with a colon.
+  static bool is_colon_selector(const char* start, const char* end)
+  {
+    const char* name_end;
+    const char* value = colon_value(start, end, name_end);
+    if (value == end) return false;
+    return *value == ':' || is_pseudo_class(start + 1, name_end);
+  }
+
+  // Otherwise it's a property, or a namespace for nested properties
+  // if there is no value.
+  static bool is_colon_namespace(const char* start, const char* end)
+  {
+    const char* name_end;
+    return colon_value(start, end, name_end) == end;
+  }
+
+  // A line without nested lines still takes an empty block if it
+  // looks like a selector, which is told from a declaration by a
+  // colon followed by whitespace.
+  static bool takes_block(const char* start, const char* end)
+  {
+    if (starts_with(start, "@warn") || starts_with(start, "@debug") ||
+        starts_with(start, "@error") || starts_with(start, "@value") ||
+        starts_with(start, "@charset") || starts_with(start, "@namespace") ||
+        starts_with(start, "@import") || starts_with(start, "@return") ||
+        starts_with(start, "@extend") || starts_with(start, "@include") ||
+        starts_with(start, "@content") || *start == '=' || *start == '+') {
+      return false;
+    }
+    const char* colon = std::find(start, end, ':');
+    if (colon == end) return true;
+    // whitespace at the end of the line does not count
+    if (colon + 1 == end) {
+      const char* after = end;
+      while (is_indent(*after)) ++ after;
+      if (*after == 0 || is_linefeed(*after)) return true;
+    }
+    return colon[1] != ' ' && colon[1] != '\t';
+  }
+
+  // The lines of the comment at `start`, which is continued by the
+  // lines indented deeper than the comment. Returns the end of the
+  // last line. A `/*` comment also ends at a line ending with `*/`.
+  static const char* comment_end(const char* start, size_t indent, bool& closed)
+  {
+    bool loud = start[1] == '*';
+    const char* end = line_end(start);
+    while (true) {
+      const char* code = end;
+      while (code > start && Util::ascii_isspace(static_cast<unsigned char>(code[-1]))) -- code;
+      closed = loud && code - start >= 3 && code[-2] == '*' && code[-1] == '/';
+      if (closed) break;
+      const char* line = skip_blank_lines(next_line(end));
+      if (*line == 0 || line_indent(line) <= indent) break;
+      // another comment starts here
+      if (is_comment(line + line_indent(line))) break;
+      start = line;
+      end = line_end(line);
+    }
+    return end;
+  }
+
+  // The url of an `@import` up to the next comma, which is quoted
+  // for the scss parser. It must not start with a quote.
+  const char* Parser::re_indented_import(const char* src)
+  {
+    if (*src == '"' || *src == '\'') return 0;
+    char quote = 0;
+    for (; *src != 0; ++ src) {
+      if (*src == '\\' && src[1] != 0) ++ src;
+      else if (quote) { if (*src == quote) quote = 0; }
+      else if (*src == '"' || *src == '\'') quote = *src;
+      else if (*src == ',') break;
+    }
+    return src;
+  }
+
+  // parses the lines of a block, which ends at the first line that is
+  // indented less than the block
+  void Parser::parse_indented_nodes(size_t block_indent, bool is_root)
+  {
+    while (true) {
+      const char* line = skip_blank_lines(position);
+      if (*line == 0) { position = line; break; }
+      size_t indent = line_indent(line);
+      if (indent < block_indent) { position = line; break; }
+      const char* start = line + indent;
+      if (is_comment(start)) {
+        parse_indented_comment(start, indent);
+        continue;
+      }
+      terminate_statement(start, indent);
+      if (!parse_block_nodes(is_root) || !peek_css< end_of_file >()) {
+        css_error("Invalid CSS", " after ", ": expected newline, was ");
+      }
+      if (statement_children) {
+        const char* child = skip_blank_lines(statement_next);
+        pstate = SourceSpan(source, child + line_indent(child) - begin, 0);
+        error("Illegal nesting: Nothing may be nested beneath this statement.");
+      }
+      release_statement();
+      position = statement_next;
+    }
+  }
+
+  // parses the lines nested beneath the statement, called instead of
+  // `parse_css_block`, the statement ends after the block afterwards
+  Block_Obj Parser::parse_indented_block(bool is_root)
+  {
+    if (!peek_indented_block()) {
+      css_error("Invalid CSS", " after ", ": expected \"{\", was ");
+    }
+    size_t indent = statement_indent;
+    bool children = statement_children;
+    release_statement();
+    statement_block = false;
+    statement_children = false;
+    position = statement_next;
+
+    Block_Obj block = SASS_MEMORY_NEW(Block, pstate, 0, is_root);
+    block_stack.push_back(block);
+    if (children) parse_indented_nodes(line_indent(skip_blank_lines(position)), is_root);
+    block_stack.pop_back();
+
+    pstate = SourceSpan(source, position - begin, 0);
+    statement_indent = indent;
+    statement_next = position;
+    terminate(position);
+    return block;
+  }
+
+  // Parses the comment and skips the lines of silent comments. The
+  // text of the comment must be joined without trailing whitespace
+  // and closed if it's not already, the result is parsed on its own.
+  void Parser::parse_indented_comment(const char* start, size_t indent)
+  {
+    bool closed = false;
+    const char* end = comment_end(start, indent, closed);
+    const char* next = next_line(end);
+    if (start[1] == '/') {
+      position = next;
+      return;
+    }
+    sass::string text;
+    for (const char* line = start; line < end; line = next_line(line_end(line))) {
+      const char* line_stop = line_end(line);
+      while (line_stop > line && Util::ascii_isspace(static_cast<unsigned char>(line_stop[-1]))) -- line_stop;
+      if (line != start) text += "\n";
+      text.append(line, line_stop);
+    }
+    if (!closed) text += " */";
+    // parse the comment in the source if possible
+    if (text.size() == size_t(end - start) && block_comment(start) == end &&
+        std::equal(text.begin(), text.end(), start)) {
+      position = start;
+      parse_block_comments();
+    }
+    else {
+      SourceSpan span(source, start - begin, end - start);
+      Parser p(SASS_MEMORY_NEW(ItplFile, std::move(text), span), ctx, traces);
+      p.parse_block_comments();
+      if (!p.peek_css< end_of_file >()) {
+        p.css_error("Invalid CSS", " after ", ": expected newline, was ");
+      }
+      for (const Statement_Obj& comment : p.block_stack.back()->elements()) {
+        block_stack.back()->append(comment);
+      }
+    }
+    position = next;
+  }
+
+  // An `@else` continues the `@if` if it's on the next line with the
+  // same indentation (only comments may be in between).
+  void Parser::lex_indented_else()
+  {
+    release_statement();
+    const char* line = statement_next;
+    while (true) {
+      line = skip_blank_lines(line);
+      if (*line == 0 || line_indent(line) != statement_indent) break;
+      const char* start = line + statement_indent;
+      if (is_comment(start)) {
+        bool closed = false;
+        line = next_line(comment_end(start, statement_indent, closed));
+      }
+      else if (starts_with(start, "@else")) {
+        position = start;
+        terminate_statement(start, statement_indent);
+        return;
+      }
+      else break;
+    }
+    terminate(statement_next);
+  }
+
+  // the statement ends here and takes a block (`peek_css` would
+  // start at the current position if no comment is at `start`)
+  bool Parser::peek_indented_block(const char* start)
+  {
+    if (!statement_block) return false;
+    return peek< end_of_file >(peek< optional_css_comments >(start)) != 0;
+  }
+
+  // Find the end of the statement at `start` and terminate it there.
+  // Lines ending with a comma are continued by the next line with the
+  // same indentation.
+  void Parser::terminate_statement(const char* start, size_t indent)
+  {
+    const char* line = start;
+    const char* stop = code_end(line);
+    const char* next = next_line(line_end(line));
+    while (stop > line && stop[-1] == ',') {
+      const char* following = skip_blank_lines(next);
+      // skip silent comments in between
+      while (*following != 0 && line_indent(following) == indent && starts_with(following + indent, "//")) {
+        following = skip_blank_lines(next_line(line_end(following)));
+      }
+      if (*following == 0 || line_indent(following) != indent) break;
+      line = following + indent;
+      stop = code_end(line);
+      next = next_line(line_end(line));
+    }
+    const char* following = skip_blank_lines(next);
+    statement_children = *following != 0 && line_indent(following) > indent;
+    statement_property = *start == ':' && start[1] != ':' &&
+      !is_colon_selector(start, code_end(start));
+    statement_block = statement_children || (statement_property
+      ? is_colon_namespace(start, code_end(start))
+      : takes_block(line, stop));
+    statement_start = start;
+    statement_next = next;
+    statement_indent = indent;
+    terminate(stop);
+    // only tells to parse the line as a selector
+    position = *start == '\\' ? start + 1 : start;
+  }
+
+  // The source may be shared or mapped read-only, so the parser
+  // reads a copy instead, where the statements can be terminated.
+  // The offsets into the copy are the same as into the source.
+  void Parser::copy_statements()
+  {
+    statements.assign(begin, end);
+    position = &statements[0] + (position - begin);
+    begin = &statements[0];
+    end = statements_end = begin + statements.size();
+  }
+
+  // the statement ends at `stop` until it is released
+  void Parser::terminate(const char* stop)
+  {
+    if (*stop == 0) return;
+    terminated = &statements[stop - begin];
+    terminator = *stop;
+    *terminated = 0;
+    end = stop;
+  }
+
+  // restore the char at the end of the statement
+  void Parser::release_statement()
+  {
+    if (terminated == nullptr) return;
+    *terminated = terminator;
+    terminated = nullptr;
+    end = statements_end;
+  }
+
+}
@@ -117,11 +117,33 @@ namespace Sass {
 
 
   SourceSpan::SourceSpan(const char* path)
-  : source(SASS_MEMORY_NEW(SynthFile, path)), position(0, 0), offset(0, 0) { }
+  : source(SASS_MEMORY_NEW(SynthFile, path)), position(0), offset(0) { }
 
-  SourceSpan::SourceSpan(SourceDataObj source, const Offset& position, const Offset& offset)
+  SourceSpan::SourceSpan(SourceDataObj source, size_t position, size_t offset)
     : source(source), position(position), offset(offset) { }
 
+  Offset SourceSpan::getPosition() const
+  {
+    if (source.isNull()) return Offset(0, 0);
+    return source->getLineColumn(position);
+  }
+
+  Offset SourceSpan::getEndPosition() const
+  {
+    if (source.isNull()) return Offset(0, 0);
+    return source->getLineColumn(position + offset);
+  }
+
+  SourceSpan SourceSpan::immortal(const char* path)
+  {
+    // Must not live in the region or budget of a compilation
+    MemoryRegionScope suspend_region(nullptr);
+    MemoryBudgetScope suspend_budget(nullptr);
+    SynthFile* source = new SynthFile(path);
+    source->makeImmortal();
+    return SourceSpan(source);
+  }
+
   Position Position::add(const char* begin, const char* end)
   {
     Offset::add(begin, end);
@@ -100,6 +100,9 @@ namespace Sass {
     bool operator==(Token t)  { return to_string() == t.to_string(); }
   };
 
+  // Spans only store byte offsets into their source. Lines and
+  // columns are resolved via the line index of the source, which
+  // is only built once an error or a source-map actually needs it.
   class SourceSpan {
 
     public:
@@ -107,8 +110,11 @@ namespace Sass {
       SourceSpan(const char* path);
 
       SourceSpan(SourceDataObj source,
-        const Offset& position = Offset(0, 0),
-        const Offset& offset = Offset(0, 0));
+        size_t position = 0, size_t offset = 0);
+
+      // Span on an immortal synthetic source,
+      // safe to be shared between threads
+      static SourceSpan immortal(const char* path);
 
       const char* getPath() const {
         return source->getPath();
@@ -118,16 +124,18 @@ namespace Sass {
         return source->getRawData();
       }
 
-      Offset getPosition() const {
-        return position;
-      }
+      // Line and column of the start
+      Offset getPosition() const;
+
+      // Line and column of the end
+      Offset getEndPosition() const;
 
       size_t getLine() const {
-        return position.line + 1;
+        return getPosition().line + 1;
       }
 
       size_t getColumn() const {
-        return position.column + 1;
+        return getPosition().column + 1;
       }
 
       size_t getSrcId() const {
@@ -137,8 +145,10 @@ namespace Sass {
       }
 
       SourceDataObj source;
-      Offset position;
-      Offset offset;
+      // Byte offset of the start
+      size_t position;
+      // Length in bytes
+      size_t offset;
 
   };
 
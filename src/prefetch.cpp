@@ -0,0 +1,173 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include "prefetch.hpp"
+#include "context.hpp"
+#include "parser.hpp"
+#include "source.hpp"
+
+namespace Sass {
+
+  // Workers only load plain files and can't charge the memory
+  // budget. The other ways to avoid parsing are not thread safe.
+  static size_t prefetch_threads(const Context& ctx)
+  {
+    const Sass_Options& options = ctx.c_options;
+    if (!ctx.c_importers.empty() || !ctx.c_headers.empty()) return 0;
+    if (ctx.cache || options.memory_limit) return 0;
+    if (options.load_precompiled || options.write_precompiled) return 0;
+    return options.import_prefetch;
+  }
+
+  ImportPrefetcher::ImportPrefetcher(Context& ctx) :
+    ctx(ctx),
+    stopping(false)
+  {
+    size_t threads = prefetch_threads(ctx);
+    if (threads == 0) return;
+    for (size_t i = 0; i < threads; ++i) {
+      workers.push_back(std::thread(&ImportPrefetcher::work, this));
+    }
+    ctx.prefetch = this;
+  }
+
+  ImportPrefetcher::~ImportPrefetcher()
+  {
+    if (workers.empty()) return;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    queued.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    // parsers of the workers used it
+    ctx.prefetch = nullptr;
+  }
+
+  ImportPrefetcher::Key ImportPrefetcher::key(const Importer& importer)
+  {
+    return { File::rel2abs(importer.base_path), importer.imp_path };
+  }
+
+  sass::vector<Include> ImportPrefetcher::find_includes(const Importer& importer)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = lookups.insert({ key(importer), { Lookup::QUEUED, {} } }).first;
+    Lookup& lookup(it->second);
+    if (lookup.state == Lookup::QUEUED) {
+      lookup.state = Lookup::RESOLVING;
+      lock.unlock();
+      sass::vector<Include> includes(ctx.find_includes(importer));
+      lock.lock();
+      lookup.includes = includes;
+      lookup.state = Lookup::RESOLVED;
+      finished.notify_all();
+    }
+    finished.wait(lock, [&lookup] { return lookup.state == Lookup::RESOLVED; });
+    return lookup.includes;
+  }
+
+  Include ImportPrefetcher::defer(const Importer& importer, const SourceSpan& pstate,
+    sass::vector<CachedImport>& imports)
+  {
+    imports.push_back({ importer, "", pstate });
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lookups.insert({ key(importer), { Lookup::QUEUED, {} } }).second) {
+      queue.push_back(importer);
+      queued.notify_one();
+    }
+    return { importer, "" };
+  }
+
+  Block_Obj ImportPrefetcher::parse(SourceData* source, bool indented, sass::vector<CachedImport>& imports)
+  {
+    try {
+      // errors are reported by the normal parse
+      Parser p(source, ctx, {});
+      p.deferred_imports = &imports;
+      p.indented_syntax = indented;
+      Block_Obj root = p.parse();
+      if (p.deferred_stubs.size() != imports.size()) throw Retry();
+      // resolved by the workers meanwhile
+      for (size_t i = 0; i < imports.size(); ++i) {
+        const sass::vector<Include> includes(find_includes(imports[i].importer));
+        if (includes.size() != 1) throw Retry();
+        imports[i].abs_path = includes[0].abs_path;
+        p.deferred_stubs[i]->resource(includes[0]);
+      }
+      return root;
+    }
+    catch (...) {
+      imports.clear();
+      return {};
+    }
+  }
+
+  CachedStyleSheetObj ImportPrefetcher::take(const sass::string& abs_path)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // workers will not start to load it anymore
+    Job& job(jobs.insert({ abs_path, { Job::DONE, {} } }).first->second);
+    finished.wait(lock, [&job] { return job.state == Job::DONE; });
+    CachedStyleSheetObj sheet(job.sheet);
+    job.sheet = {};
+    return sheet;
+  }
+
+  void ImportPrefetcher::work()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      queued.wait(lock, [this] { return stopping || !queue.empty(); });
+      if (stopping) return;
+      Importer importer(queue.front());
+      queue.pop_front();
+      // otherwise already resolved by a parser
+      Lookup& lookup(lookups.at(key(importer)));
+      if (lookup.state != Lookup::QUEUED) continue;
+      lookup.state = Lookup::RESOLVING;
+      lock.unlock();
+      sass::vector<Include> includes(ctx.find_includes(importer));
+      lock.lock();
+      lookup.includes = includes;
+      lookup.state = Lookup::RESOLVED;
+      finished.notify_all();
+      // ambiguous imports are reported in order
+      if (includes.size() != 1) continue;
+      // only load every file once
+      auto it = jobs.insert({ includes[0].abs_path, { Job::LOADING, {} } });
+      if (!it.second) continue;
+      Job& job(it.first->second);
+      lock.unlock();
+      CachedStyleSheetObj sheet;
+      try { sheet = load(includes[0]); }
+      catch (...) { /* loaded again in order */ }
+      lock.lock();
+      // must not touch it after we unlock
+      job.sheet = sheet;
+      sheet = {};
+      job.state = Job::DONE;
+      finished.notify_all();
+    }
+  }
+
+  CachedStyleSheetObj ImportPrefetcher::load(const Include& include)
+  {
+    Resource res(File::read_resource(include.abs_path, ctx.c_options.map_files));
+    if (!res.contents) return {};
+    SourceFileObj source = SASS_MEMORY_NEW(SourceFile, include.abs_path.c_str(),
+      SourceBuffer(res.contents, res.length), sass::string::npos);
+    sass::vector<CachedImport> imports;
+    Block_Obj root(parse(source, res.indented, imports));
+    if (root.isNull()) {
+      source = {};
+      res.release();
+      return {};
+    }
+    // owns the resource from now on
+    return SASS_MEMORY_NEW(CachedStyleSheet, FileStamp(),
+      StyleSheet(res, source, root, std::move(imports)));
+  }
+
+}
@@ -0,0 +1,111 @@
+#ifndef SASS_PREFETCH_H
+#define SASS_PREFETCH_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "file.hpp"
+#include "stylesheet.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // Resolves, reads and parses the imported files of a compilation
+  // on worker threads ahead of time. Sheets are parsed with deferred
+  // imports (see `Parser::deferred_imports`), which are only queued
+  // for the workers and resolved after the sheet is parsed, so they
+  // never touch the compilation. The compilation still registers all
+  // sheets in the same order as before and only takes over finished
+  // trees. The order of the resources and source maps and the import
+  // loop detection are therefore not affected. Anything unusual like
+  // errors, warnings or ambiguous imports makes the sheet get parsed
+  // again in order.
+  class ImportPrefetcher {
+
+    public:
+
+      // Thrown by parsers with deferred imports
+      // if the sheet must be parsed normally
+      class Retry {};
+
+    private:
+
+      // an import requested by a parser
+      struct Lookup {
+        enum State { QUEUED, RESOLVING, RESOLVED };
+        State state;
+        sass::vector<Include> includes;
+      };
+
+      // a file found by a lookup
+      struct Job {
+        enum State { LOADING, DONE };
+        State state;
+        // the finished sheet (null on errors)
+        CachedStyleSheetObj sheet;
+      };
+
+      typedef std::pair<sass::string, sass::string> Key;
+
+      Context& ctx;
+      std::mutex mutex;
+      // signaled for new imports to resolve
+      std::condition_variable queued;
+      // signaled for every finished lookup or job
+      std::condition_variable finished;
+      // imports waiting for a worker
+      std::deque<Importer> queue;
+      // imports by base and import path
+      std::map<Key, Lookup> lookups;
+      // every found file by absolute path
+      std::map<const sass::string, Job> jobs;
+      // set to let the workers exit
+      bool stopping;
+      std::vector<std::thread> workers;
+
+    public:
+
+      // Starts the workers if the compilation may use them and
+      // makes itself available to the compilation while alive
+      ImportPrefetcher(Context& ctx);
+      // Waits for the workers to finish their current import
+      ~ImportPrefetcher();
+
+      // Same as `Context::find_includes`, but every import is only
+      // resolved once. Resolves it right away if no worker did yet.
+      sass::vector<Include> find_includes(const Importer& importer);
+
+      // Queue the import for the workers and add it to the imports
+      // (called by parsers with deferred imports). The include is
+      // not resolved yet (see `parse`).
+      Include defer(const Importer& importer, const SourceSpan& pstate,
+        sass::vector<CachedImport>& imports);
+
+      // Parse the source with deferred imports, which are added in
+      // parse order and resolved. Returns null if it must be parsed
+      // normally (e.g. if an import doesn't resolve to one file).
+      Block_Obj parse(SourceData* source, bool indented, sass::vector<CachedImport>& imports);
+
+      // Take over the sheet loaded for the file, waits if a worker
+      // is still busy with it. Returns null if no worker started to
+      // load it yet or if it could not be parsed.
+      CachedStyleSheetObj take(const sass::string& abs_path);
+
+    private:
+
+      void work();
+      CachedStyleSheetObj load(const Include& include);
+      static Key key(const Importer& importer);
+
+  };
+
+}
+
+#endif
@@ -266,27 +266,19 @@ namespace Sass {
     // Match a line comment (/.*?(?=\n|\r\n?|\f|\Z)/.
     const char* line_comment(const char* src)
     {
-      return sequence<
-               exactly <
-                 slash_slash
-               >,
-               non_greedy<
-                 any_char,
-                 end_of_line
-               >
-             >(src);
+      src = exactly < slash_slash >(src);
+      // scan up to the line end
+      return src ? Scanner::find_line_end(src) : 0;
     }
 
     // Match a block comment.
     const char* block_comment(const char* src)
     {
-      return sequence<
-               delimited_by<
-                 slash_star,
-                 star_slash,
-                 false
-               >
-             >(src);
+      src = exactly < slash_star >(src);
+      if (!src) return 0;
+      // scan up to the closing delimiter
+      src = Scanner::find_comment_end(src);
+      return *src ? src + 2 : 0;
     }
     /* not use anymore - remove?
     const char* block_comment_prefix(const char* src) {
@@ -299,18 +291,30 @@ namespace Sass {
     */
 
     // Match zero plus white-space or line_comments
+    // Hand-rolled since this runs before most tokens
     const char* optional_css_whitespace(const char* src) {
-      return zero_plus< alternatives<spaces, line_comment> >(src);
+      while (true) {
+        src = Scanner::skip_spaces(src);
+        if (const char* pos = line_comment(src)) src = pos;
+        else return src;
+      }
     }
     const char* css_whitespace(const char* src) {
-      return one_plus< alternatives<spaces, line_comment> >(src);
+      const char* pos = optional_css_whitespace(src);
+      return pos == src ? 0 : pos;
     }
     // Match optional_css_whitepace plus block_comments
     const char* optional_css_comments(const char* src) {
-      return zero_plus< alternatives<spaces, line_comment, block_comment> >(src);
+      while (true) {
+        src = Scanner::skip_spaces(src);
+        if (const char* pos = line_comment(src)) src = pos;
+        else if (const char* pos = block_comment(src)) src = pos;
+        else return src;
+      }
     }
     const char* css_comments(const char* src) {
-      return one_plus< alternatives<spaces, line_comment, block_comment> >(src);
+      const char* pos = optional_css_comments(src);
+      return pos == src ? 0 : pos;
     }
 
     // Match one backslash escaped char /\\./
@@ -510,26 +514,37 @@ namespace Sass {
       return recursive_scopes< exactly<hash_lbrace>, exactly<rbrace> >(src);
     }
 
+    // Match the body of a quoted string. Plain chars are
+    // skipped in bulk, the rest is handled like in the regex
+    // $re_body = /(?:$re_itplnt|\\.|[^$quote])*/
+    template <char quote>
+    const char* quoted_string_body(const char* src) {
+      while (true) {
+        src = Scanner::find_string_special(src, quote);
+        if (*src == quote || *src == 0) return src;
+        const char* pos = alternatives <
+          // skip escapes
+          sequence <
+            exactly < '\\' >,
+            re_linebreak
+          >,
+          escape_seq,
+          // skip interpolants
+          interpolant,
+          // skip non delimiters
+          any_char_but < quote >
+        >(src);
+        if (!pos) return src;
+        src = pos;
+      }
+    }
+
     // $re_squote = /'(?:$re_itplnt|\\.|[^'])*'/
     const char* single_quoted_string(const char* src) {
       // match a single quoted string, while skipping interpolants
       return sequence <
         exactly <'\''>,
-        zero_plus <
-          alternatives <
-            // skip escapes
-            sequence <
-              exactly < '\\' >,
-              re_linebreak
-            >,
-            escape_seq,
-            unicode_seq,
-            // skip interpolants
-            interpolant,
-            // skip non delimiters
-            any_char_but < '\'' >
-          >
-        >,
+        quoted_string_body <'\''>,
         exactly <'\''>
       >(src);
     }
@@ -539,21 +554,7 @@ namespace Sass {
       // match a single quoted string, while skipping interpolants
       return sequence <
         exactly <'"'>,
-        zero_plus <
-          alternatives <
-            // skip escapes
-            sequence <
-              exactly < '\\' >,
-              re_linebreak
-            >,
-            escape_seq,
-            unicode_seq,
-            // skip interpolants
-            interpolant,
-            // skip non delimiters
-            any_char_but < '"' >
-          >
-        >,
+        quoted_string_body <'"'>,
         exactly <'"'>
       >(src);
     }
@@ -1574,7 +1575,9 @@ namespace Sass {
         >(src);
     }
 
-    const char* static_value(const char* src) {
+    // A static value up to the given end (included)
+    template <prelexer value_end>
+    static const char* static_value_until(const char* src) {
       return sequence< sequence<
                          static_component,
                          zero_plus< identifier >
@@ -1591,10 +1594,19 @@ namespace Sass {
                                      static_component
                        > >,
                        zero_plus < spaces >,
-                       alternatives< exactly<';'>, exactly<'}'> >
+                       value_end
                       >(src);
     }
 
+    const char* static_value(const char* src) {
+      return static_value_until< alternatives< exactly<';'>, exactly<'}'> > >(src);
+    }
+
+    // statements of the indented syntax end with a null char
+    const char* indented_static_value(const char* src) {
+      return static_value_until< end_of_file >(src);
+    }
+
     extern const char css_variable_url_negates[] = "()[]{}\"'#/";
     const char* css_variable_value(const char* src) {
       return sequence<
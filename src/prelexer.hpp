@@ -3,6 +3,7 @@
 
 #include <cstring>
 #include "lexer.hpp"
+#include "scanner.hpp"
 
 namespace Sass {
   // using namespace Lexer;
@@ -46,12 +47,12 @@ namespace Sass {
     const char* delimited_by(const char* src) {
       src = exactly<beg>(src);
       if (!src) return 0;
-      const char* stop;
       while (true) {
+        // jump to the next candidate
+        src = Scanner::find_char(src, end);
         if (!*src) return 0;
-        stop = exactly<end>(src);
-        if (stop && (!esc || *(src - 1) != '\\')) return stop;
-        src = stop ? stop : src + 1;
+        if (!esc || *(src - 1) != '\\') return src + 1;
+        src = src + 1;
       }
     }
 
@@ -83,6 +84,8 @@ namespace Sass {
         }
         else if (in_dquote || in_squote) {
           // take everything literally
+          // jump to the next quote or escape
+          src = Scanner::find_quote_or_escape(src + 1, end) - 1;
         }
 
         // find another opener inside?
@@ -140,6 +143,8 @@ namespace Sass {
       if (!src) return 0;
       const char* stop;
       while (true) {
+        // jump to the next candidate
+        src = Scanner::find_char(src, *end);
         if (!*src) return 0;
         stop = exactly<end>(src);
         if (stop && (!esc || *(src - 1) != '\\')) return stop;
@@ -379,6 +384,7 @@ namespace Sass {
     const char* static_component(const char* src);
     const char* static_property(const char* src);
     const char* static_value(const char* src);
+    const char* indented_static_value(const char* src);
 
     const char* css_variable_value(const char* src);
     const char* css_variable_top_level_value(const char* src);
@@ -59,6 +59,28 @@ extern "C" {
     if (ptr) free (ptr);
   }
 
+  // Configure how many unused arenas we keep
+  void ADDCALL sass_memory_set_arena_retention(size_t arenas)
+  {
+    setArenaRetention(arenas);
+  }
+
+  size_t ADDCALL sass_memory_get_arena_retention(void)
+  {
+    return getArenaRetention();
+  }
+
+  size_t ADDCALL sass_memory_get_retained_bytes(void)
+  {
+    return retainedArenas() * SassAllocatorArenaSize;
+  }
+
+  // Give unused arenas back to the system
+  size_t ADDCALL sass_memory_trim(void)
+  {
+    return trimArenas();
+  }
+
   // caller must free the returned memory
   char* ADDCALL sass_string_quote (const char *str, const char quote_mark)
   {
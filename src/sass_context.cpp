@@ -5,6 +5,7 @@
 
 #include "sass_functions.hpp"
 #include "json.hpp"
+#include "watcher.hpp"
 
 #define LFEED "\n"
 
@@ -75,11 +76,9 @@ namespace Sass {
       }
 
       // now create the code trace (ToDo: maybe have util functions?)
-      if (e.pstate.position.line != sass::string::npos &&
-          e.pstate.position.column != sass::string::npos &&
-          e.pstate.getRawData() != nullptr &&
+      if (e.pstate.getRawData() != nullptr &&
           e.pstate.source != nullptr) {
-        Offset offset(e.pstate.position);
+        Offset offset(e.pstate.getPosition());
         size_t lines = offset.line;
         // scan through src until target line
         // move line_beg pointer to line start
@@ -164,6 +163,12 @@ namespace Sass {
     // The cpp context must be set by now
     Context* cpp_ctx = compiler->cpp_ctx;
     Sass_Context* c_ctx = compiler->c_ctx;
+    // Allocate from the region of the context
+    MemoryRegionScope scope(&cpp_ctx->region);
+    // Charge allocations to the memory budget
+    MemoryBudgetScope budget(&cpp_ctx->budget);
+    // Count objects if statistics are enabled
+    ObjectCensus::Scope census(c_ctx->memory_stats ? &cpp_ctx->census : nullptr);
     // We will take care to wire up the rest
     compiler->cpp_ctx->c_compiler = compiler;
     compiler->state = SASS_COMPILER_PARSED;
@@ -423,6 +428,44 @@ extern "C" {
     return sass_compile_context(file_ctx, cpp_ctx);
   }
 
+  int ADDCALL sass_precompile_file_context(Sass_File_Context* file_ctx)
+  {
+    if (file_ctx == 0) return 1;
+    if (file_ctx->error_status)
+      return file_ctx->error_status;
+    try {
+      if (file_ctx->input_path == 0) { throw(std::runtime_error("File context has no input path")); }
+      if (*file_ctx->input_path == 0) { throw(std::runtime_error("File context has empty input path")); }
+      if (file_ctx->c_importers || file_ctx->c_headers) { throw(std::runtime_error("Files of custom importers can't be precompiled")); }
+    }
+    catch (...) { return handle_errors(file_ctx) | 1; }
+    // parse all files again, shared trees may have been
+    // changed by compilations (and are written below)
+    Sass_StyleSheet_Cache* cache = file_ctx->stylesheet_cache;
+    const bool load = file_ctx->load_precompiled;
+    const bool write = file_ctx->write_precompiled;
+    file_ctx->stylesheet_cache = nullptr;
+    file_ctx->load_precompiled = false;
+    file_ctx->write_precompiled = false;
+    File_Context* cpp_ctx = new File_Context(*file_ctx);
+    Sass_Compiler* compiler = sass_prepare_context(file_ctx, cpp_ctx);
+    if (compiler) {
+      MemoryRegionScope scope(&cpp_ctx->region);
+      MemoryBudgetScope budget(&cpp_ctx->budget);
+      try {
+        for (const sass::string& path : cpp_ctx->precompile()) {
+          throw(std::runtime_error("Can't store the precompiled tree of " + path));
+        }
+      }
+      catch (...) { handle_errors(file_ctx); }
+    }
+    sass_delete_compiler(compiler);
+    file_ctx->stylesheet_cache = cache;
+    file_ctx->load_precompiled = load;
+    file_ctx->write_precompiled = write;
+    return file_ctx->error_status;
+  }
+
   int ADDCALL sass_compiler_parse(struct Sass_Compiler* compiler)
   {
     if (compiler == 0) return 1;
@@ -450,6 +493,9 @@ extern "C" {
       return compiler->c_ctx->error_status;
     compiler->state = SASS_COMPILER_EXECUTED;
     Context* cpp_ctx = compiler->cpp_ctx;
+    MemoryRegionScope scope(&cpp_ctx->region);
+    MemoryBudgetScope budget(&cpp_ctx->budget);
+    ObjectCensus::Scope census(compiler->c_ctx->memory_stats ? &cpp_ctx->census : nullptr);
     Block_Obj root = compiler->root;
     // compile the parsed root block
     try { compiler->c_ctx->output_string = cpp_ctx->render(root); }
@@ -569,10 +615,12 @@ extern "C" {
       return;
     }
     Context* cpp_ctx = compiler->cpp_ctx;
+    // root may live in the memory region
+    if (cpp_ctx) cpp_ctx->region.release();
+    compiler->root = {};
     if (cpp_ctx) delete(cpp_ctx);
     compiler->cpp_ctx = NULL;
     compiler->c_ctx = NULL;
-    compiler->root = {};
     free(compiler);
   }
 
@@ -597,6 +645,84 @@ extern "C" {
     sass_clear_context(ctx); free(ctx);
   }
 
+  // Create a stylesheet cache to share between compilations
+  struct Sass_StyleSheet_Cache* ADDCALL sass_make_stylesheet_cache(void)
+  {
+    return new Sass_StyleSheet_Cache();
+  }
+
+  // Deallocate the cache (must not be in use by any compiler)
+  void ADDCALL sass_delete_stylesheet_cache(struct Sass_StyleSheet_Cache* cache)
+  {
+    delete cache;
+  }
+
+  void ADDCALL sass_stylesheet_cache_clear(struct Sass_StyleSheet_Cache* cache) { cache->clear(); }
+  size_t ADDCALL sass_stylesheet_cache_get_size(struct Sass_StyleSheet_Cache* cache) { return cache->size(); }
+
+  // Create a directory cache to share between compilations
+  struct Sass_Directory_Cache* ADDCALL sass_make_directory_cache(void)
+  {
+    return new Sass_Directory_Cache();
+  }
+
+  // Deallocate the cache (must not be in use by any compiler)
+  void ADDCALL sass_delete_directory_cache(struct Sass_Directory_Cache* cache)
+  {
+    delete cache;
+  }
+
+  void ADDCALL sass_directory_cache_invalidate(struct Sass_Directory_Cache* cache, const char* path) { cache->invalidate(path); }
+  void ADDCALL sass_directory_cache_clear(struct Sass_Directory_Cache* cache) { cache->clear(); }
+  size_t ADDCALL sass_directory_cache_get_size(struct Sass_Directory_Cache* cache) { return cache->size(); }
+
+  // Create a dependency graph for many entry points
+  struct Sass_Dependency_Graph* ADDCALL sass_make_dependency_graph(void)
+  {
+    return new Sass_Dependency_Graph();
+  }
+
+  void ADDCALL sass_delete_dependency_graph(struct Sass_Dependency_Graph* graph)
+  {
+    delete graph;
+  }
+
+  void ADDCALL sass_dependency_graph_add_compiler(struct Sass_Dependency_Graph* graph, struct Sass_Compiler* compiler)
+  {
+    // only parsed compilers know their imports
+    if (compiler->state == SASS_COMPILER_CREATED) return;
+    if (compiler->c_ctx->error_status) return;
+    graph->add(*compiler->cpp_ctx);
+  }
+
+  size_t ADDCALL sass_dependency_graph_find_affected(struct Sass_Dependency_Graph* graph, const char** paths, size_t count)
+  {
+    sass::vector<sass::string> changed;
+    for (size_t i = 0; i < count; ++i) changed.push_back(paths[i]);
+    return graph->find_affected(changed).size();
+  }
+
+  void ADDCALL sass_dependency_graph_remove_entry(struct Sass_Dependency_Graph* graph, const char* entry) { graph->remove(entry); }
+  size_t ADDCALL sass_dependency_graph_get_size(struct Sass_Dependency_Graph* graph) { return graph->size(); }
+  const char* ADDCALL sass_dependency_graph_get_affected(struct Sass_Dependency_Graph* graph, size_t idx) { return graph->get_affected()[idx].c_str(); }
+
+  // Create a watcher (null if not supported)
+  struct Sass_Watcher* ADDCALL sass_make_watcher(Sass_Watch_Options_Fn options, Sass_Watch_Result_Fn result, void* cookie)
+  {
+    Sass_Watcher* watcher = new Sass_Watcher(options, result, cookie);
+    if (watcher->valid()) return watcher;
+    delete watcher;
+    return 0;
+  }
+
+  void ADDCALL sass_delete_watcher(struct Sass_Watcher* watcher)
+  {
+    delete watcher;
+  }
+
+  void ADDCALL sass_watcher_add_file(struct Sass_Watcher* watcher, const char* input_path) { watcher->add(input_path); }
+  int ADDCALL sass_watcher_poll(struct Sass_Watcher* watcher, int timeout) { return watcher->poll(timeout); }
+
   // Getters for sass context from specific implementations
   struct Sass_Context* ADDCALL sass_file_context_get_context(struct Sass_File_Context* ctx) { return ctx; }
   struct Sass_Context* ADDCALL sass_data_context_get_context(struct Sass_Data_Context* ctx) { return ctx; }
@@ -620,6 +746,35 @@ extern "C" {
   size_t ADDCALL sass_compiler_get_callee_stack_size(struct Sass_Compiler* compiler) { return compiler->cpp_ctx->callee_stack.size(); }
   Sass_Callee_Entry ADDCALL sass_compiler_get_last_callee(struct Sass_Compiler* compiler) { return &compiler->cpp_ctx->callee_stack.back(); }
   Sass_Callee_Entry ADDCALL sass_compiler_get_callee_entry(struct Sass_Compiler* compiler, size_t idx) { return &compiler->cpp_ctx->callee_stack[idx]; }
+  size_t ADDCALL sass_compiler_get_memory_stats_size(struct Sass_Compiler* compiler) { return compiler->cpp_ctx ? compiler->cpp_ctx->memory_stats.size() : 0; }
+  Sass_Memory_Stats_Entry ADDCALL sass_compiler_get_memory_stats_entry(struct Sass_Compiler* compiler, size_t idx) { return &compiler->cpp_ctx->memory_stats[idx]; }
+  // Getters for Sass_Compiler options (query import graph)
+  size_t ADDCALL sass_compiler_get_import_edges_size(struct Sass_Compiler* compiler) { return compiler->cpp_ctx ? compiler->cpp_ctx->get_import_graph().size() : 0; }
+  Sass_Import_Edge_Entry ADDCALL sass_compiler_get_import_edge(struct Sass_Compiler* compiler, size_t idx) { return &compiler->cpp_ctx->get_import_graph()[idx]; }
+
+  // Getters for import graph edges
+  const char* ADDCALL sass_import_edge_get_importer(Sass_Import_Edge_Entry edge) { return edge->importer.c_str(); }
+  const char* ADDCALL sass_import_edge_get_imported(Sass_Import_Edge_Entry edge) { return edge->imported.c_str(); }
+  const char* ADDCALL sass_import_edge_get_imp_path(Sass_Import_Edge_Entry edge) { return edge->imp_path.c_str(); }
+  size_t ADDCALL sass_import_edge_get_line(Sass_Import_Edge_Entry edge) { return edge->line; }
+  size_t ADDCALL sass_import_edge_get_column(Sass_Import_Edge_Entry edge) { return edge->column; }
+  size_t ADDCALL sass_import_edge_get_hash(Sass_Import_Edge_Entry edge) { return edge->hash; }
+
+  // Getters for memory statistics
+  enum Sass_Memory_Phase ADDCALL sass_memory_stats_get_phase(Sass_Memory_Stats_Entry stats) { return stats->phase; }
+  size_t ADDCALL sass_memory_stats_get_arenas(Sass_Memory_Stats_Entry stats) { return stats->memory.arenas; }
+  size_t ADDCALL sass_memory_stats_get_resident_bytes(Sass_Memory_Stats_Entry stats) { return stats->memory.resident; }
+  size_t ADDCALL sass_memory_stats_get_peak_bytes(Sass_Memory_Stats_Entry stats) { return stats->memory.peak; }
+  size_t ADDCALL sass_memory_stats_get_large_objects(Sass_Memory_Stats_Entry stats) { return stats->memory.largeObjects; }
+  size_t ADDCALL sass_memory_stats_get_large_bytes(Sass_Memory_Stats_Entry stats) { return stats->memory.largeBytes; }
+  size_t ADDCALL sass_memory_stats_get_bucket_count(Sass_Memory_Stats_Entry stats) { return stats->memory.buckets.size(); }
+  size_t ADDCALL sass_memory_stats_get_bucket_size(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->memory.buckets[idx].size; }
+  size_t ADDCALL sass_memory_stats_get_bucket_objects(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->memory.buckets[idx].objects; }
+  size_t ADDCALL sass_memory_stats_get_bucket_bytes(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->memory.buckets[idx].objects * stats->memory.buckets[idx].size; }
+  size_t ADDCALL sass_memory_stats_get_bucket_free(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->memory.buckets[idx].free; }
+  size_t ADDCALL sass_memory_stats_get_class_count(Sass_Memory_Stats_Entry stats) { return stats->classes.size(); }
+  const char* ADDCALL sass_memory_stats_get_class_name(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->classes[idx].first.c_str(); }
+  size_t ADDCALL sass_memory_stats_get_class_objects(Sass_Memory_Stats_Entry stats, size_t idx) { return stats->classes[idx].second; }
 
   // Calculate the size of the stored null terminated array
   size_t ADDCALL sass_context_get_included_files_size (struct Sass_Context* ctx)
@@ -634,6 +789,15 @@ extern "C" {
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, source_map_file_urls);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, omit_source_map_url);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, is_indented_syntax_src);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, memory_region);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, memory_stats);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, memory_limit);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, map_files);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(struct Sass_StyleSheet_Cache*, stylesheet_cache);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(struct Sass_Directory_Cache*, directory_cache);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, load_precompiled);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, write_precompiled);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, import_prefetch);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Function_List, c_functions);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_importers);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_headers);
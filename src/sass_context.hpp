@@ -23,6 +23,42 @@ struct Sass_Options : Sass_Output_Options {
   // Treat source_string as sass (as opposed to scss)
   bool is_indented_syntax_src;
 
+  // Allocate all nodes from a region owned by
+  // the compilation and release it in one step
+  bool memory_region;
+
+  // Sample allocator and object counters
+  // after every phase of the compilation
+  bool memory_stats;
+
+  // Abort the compilation once it holds more
+  // than this many bytes (zero means unlimited)
+  size_t memory_limit;
+
+  // Memory map big imported files instead of
+  // reading them (they must not be truncated)
+  bool map_files;
+
+  // Reuse parsed stylesheets of imported files
+  // from other compilations (not owned by us)
+  struct Sass_StyleSheet_Cache* stylesheet_cache;
+
+  // Directory listings to resolve imports
+  // shared with other compilations (not owned by us)
+  struct Sass_Directory_Cache* directory_cache;
+
+  // Load imported files from precompiled trees
+  // stored next to them if still up to date
+  bool load_precompiled;
+
+  // Store the tree of every parsed import
+  // next to the file for later compilations
+  bool write_precompiled;
+
+  // Threads to load imported files ahead
+  // of time (zero disables the prefetching)
+  size_t import_prefetch;
+
   // The input path is used for source map
   // generation. It can be used to define
   // something with string compilation or to
@@ -114,6 +150,16 @@ struct Sass_Data_Context : Sass_Context {
 
 };
 
+// memory statistics of one phase
+struct Sass_Memory_Stats {
+  // phase after which it was sampled
+  Sass_Memory_Phase phase;
+  // counters of the memory pool
+  Sass::MemoryStats memory;
+  // live shared objects per class
+  std::vector<std::pair<std::string, size_t>> classes;
+};
+
 // link c and cpp context
 struct Sass_Compiler {
   // progress status
@@ -63,7 +63,18 @@ extern "C" {
     return cb;
   }
 
+  Sass_Importer_Entry ADDCALL sass_make_async_importer(Sass_Async_Importer_Fn importer, double priority, void* cookie)
+  {
+    Sass_Importer_Entry cb = (Sass_Importer_Entry) calloc(1, sizeof(Sass_Importer));
+    if (cb == 0) return 0;
+    cb->async_importer = importer;
+    cb->priority = priority;
+    cb->cookie = cookie;
+    return cb;
+  }
+
   Sass_Importer_Fn ADDCALL sass_importer_get_function(Sass_Importer_Entry cb) { return cb->importer; }
+  Sass_Async_Importer_Fn ADDCALL sass_importer_get_async_function(Sass_Importer_Entry cb) { return cb->async_importer; }
   double ADDCALL sass_importer_get_priority (Sass_Importer_Entry cb) { return cb->priority; }
   void* ADDCALL sass_importer_get_cookie(Sass_Importer_Entry cb) { return cb->cookie; }
 
@@ -113,6 +124,8 @@ extern "C" {
     v->error = 0;
     v->line = -1;
     v->column = -1;
+    v->cache_key = 0;
+    v->cache_version = 0;
     return v;
   }
 
@@ -133,10 +146,39 @@ extern "C" {
     return import;
   }
 
+  // Mark the import entry as cacheable under the key (at the given version)
+  Sass_Import_Entry ADDCALL sass_import_set_cache_key(Sass_Import_Entry import, const char* key, const char* version)
+  {
+    if (import == 0) return 0;
+    free(import->cache_key);
+    free(import->cache_version);
+    import->cache_key = key ? sass_copy_c_string(key) : 0;
+    import->cache_version = version ? sass_copy_c_string(version) : 0;
+    return import;
+  }
+
   // Setters and getters for entries on the import list
   void ADDCALL sass_import_set_list_entry(Sass_Import_List list, size_t idx, Sass_Import_Entry entry) { list[idx] = entry; }
   Sass_Import_Entry ADDCALL sass_import_get_list_entry(Sass_Import_List list, size_t idx) { return list[idx]; }
 
+  // Created by asynchronous importers, freed by the compiler
+  Sass_Pending_Import_Entry ADDCALL sass_make_pending_import(void)
+  {
+    Sass_Pending_Import_Entry pending = new Sass_Pending_Import;
+    pending->resolved = false;
+    pending->list = 0;
+    return pending;
+  }
+
+  // The waiting compiler can only free it once we unlock
+  void ADDCALL sass_pending_import_resolve(Sass_Pending_Import_Entry pending, Sass_Import_List list)
+  {
+    std::lock_guard<std::mutex> lock(pending->mutex);
+    pending->list = list;
+    pending->resolved = true;
+    pending->done.notify_one();
+  }
+
   // Deallocator for the allocated memory
   void ADDCALL sass_delete_import_list(Sass_Import_List list)
   {
@@ -157,38 +199,40 @@ extern "C" {
     free(import->source);
     free(import->srcmap);
     free(import->error);
+    free(import->cache_key);
+    free(import->cache_version);
     free(import);
   }
 
   // Getter for callee entry
   const char* ADDCALL sass_callee_get_name(Sass_Callee_Entry entry) { return entry->name; }
-  const char* ADDCALL sass_callee_get_path(Sass_Callee_Entry entry) { return entry->path; }
-  size_t ADDCALL sass_callee_get_line(Sass_Callee_Entry entry) { return entry->line; }
-  size_t ADDCALL sass_callee_get_column(Sass_Callee_Entry entry) { return entry->column; }
+  const char* ADDCALL sass_callee_get_path(Sass_Callee_Entry entry) { return entry->pstate.getPath(); }
+  size_t ADDCALL sass_callee_get_line(Sass_Callee_Entry entry) { return entry->pstate.getLine(); }
+  size_t ADDCALL sass_callee_get_column(Sass_Callee_Entry entry) { return entry->pstate.getColumn(); }
   enum Sass_Callee_Type ADDCALL sass_callee_get_type(Sass_Callee_Entry entry) { return entry->type; }
   Sass_Env_Frame ADDCALL sass_callee_get_env (Sass_Callee_Entry entry) { return &entry->env; }
 
   // Getters and Setters for environments (lexical, local and global)
   union Sass_Value* ADDCALL sass_env_get_lexical (Sass_Env_Frame env, const char* name) {
-    Expression* ex = Cast<Expression>((*env->frame)[name]);
+    Expression* ex = Cast<Expression>((*env->frame)[Symbol(name)]);
     return ex != NULL ? ast_node_to_sass_value(ex) : NULL;
   }
   void ADDCALL sass_env_set_lexical (Sass_Env_Frame env, const char* name, union Sass_Value* val) {
-    (*env->frame)[name] = sass_value_to_ast_node(val);
+    (*env->frame)[Symbol(name)] = sass_value_to_ast_node(val);
   }
   union Sass_Value* ADDCALL sass_env_get_local (Sass_Env_Frame env, const char* name) {
-    Expression* ex = Cast<Expression>(env->frame->get_local(name));
+    Expression* ex = Cast<Expression>(env->frame->get_local(Symbol(name)));
     return ex != NULL ? ast_node_to_sass_value(ex) : NULL;
   }
   void ADDCALL sass_env_set_local (Sass_Env_Frame env, const char* name, union Sass_Value* val) {
-    env->frame->set_local(name, sass_value_to_ast_node(val));
+    env->frame->set_local(Symbol(name), sass_value_to_ast_node(val));
   }
   union Sass_Value* ADDCALL sass_env_get_global (Sass_Env_Frame env, const char* name) {
-    Expression* ex = Cast<Expression>(env->frame->get_global(name));
+    Expression* ex = Cast<Expression>(env->frame->get_global(Symbol(name)));
     return ex != NULL ? ast_node_to_sass_value(ex) : NULL;
   }
   void ADDCALL sass_env_set_global (Sass_Env_Frame env, const char* name, union Sass_Value* val) {
-    env->frame->set_global(name, sass_value_to_ast_node(val));
+    env->frame->set_global(Symbol(name), sass_value_to_ast_node(val));
   }
 
   // Getter for import entry
@@ -201,6 +245,8 @@ extern "C" {
   size_t ADDCALL sass_import_get_error_line(Sass_Import_Entry entry) { return entry->line; }
   size_t ADDCALL sass_import_get_error_column(Sass_Import_Entry entry) { return entry->column; }
   const char* ADDCALL sass_import_get_error_message(Sass_Import_Entry entry) { return entry->error; }
+  const char* ADDCALL sass_import_get_cache_key(Sass_Import_Entry entry) { return entry->cache_key; }
+  const char* ADDCALL sass_import_get_cache_version(Sass_Import_Entry entry) { return entry->cache_version; }
 
   // Explicit functions to take ownership of the memory
   // Resets our own property since we do not know if it is still alive
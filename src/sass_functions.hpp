@@ -2,6 +2,9 @@
 #define SASS_SASS_FUNCTIONS_H
 
 #include "sass.h"
+#include <mutex>
+#include <condition_variable>
+#include "position.hpp"
 #include "environment.hpp"
 #include "fn_utils.hpp"
 
@@ -22,6 +25,10 @@ struct Sass_Import {
   char* error;
   size_t line;
   size_t column;
+  // reuse the result for the same key
+  // as long as the version is the same
+  char* cache_key;
+  char* cache_version;
 };
 
 // External environments
@@ -33,16 +40,26 @@ struct Sass_Env {
 // External call entry
 struct Sass_Callee {
   const char* name;
-  const char* path;
-  size_t line;
-  size_t column;
+  // line and column are resolved when asked for
+  Sass::SourceSpan pstate;
   enum Sass_Callee_Type type;
   struct Sass_Env env;
 };
 
+// Result of an asynchronous importer
+struct Sass_Pending_Import {
+  std::mutex mutex;
+  // signaled once resolved
+  std::condition_variable done;
+  bool resolved;
+  Sass_Import_List list;
+};
+
 // Struct to hold importer callback
 struct Sass_Importer {
   Sass_Importer_Fn importer;
+  // set instead of the importer
+  Sass_Async_Importer_Fn async_importer;
   double           priority;
   void*            cookie;
 };
@@ -0,0 +1,191 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include "scanner.hpp"
+
+#if !defined(SASS_NO_SIMD) && defined(__AVX2__)
+  #define SASS_SIMD_AVX2
+  #include <immintrin.h>
+#elif !defined(SASS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define SASS_SIMD_SSE2
+  #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(SASS_SIMD_AVX2) || defined(SASS_SIMD_SSE2))
+  #include <intrin.h>
+#endif
+
+namespace Sass {
+  namespace Scanner {
+
+    #if defined(SASS_SIMD_AVX2)
+
+    typedef __m256i Vec;
+    static const size_t VecSize = 32;
+    static const uint32_t VecBits = 0xFFFFFFFF;
+    static inline Vec vec_load(const char* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static inline Vec vec_set(char chr) { return _mm256_set1_epi8(chr); }
+    static inline Vec vec_eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+    static inline Vec vec_or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static inline Vec vec_min(Vec a, Vec b) { return _mm256_min_epu8(a, b); }
+    static inline Vec vec_sub(Vec a, Vec b) { return _mm256_sub_epi8(a, b); }
+    static inline uint32_t vec_bits(Vec a) { return (uint32_t)_mm256_movemask_epi8(a); }
+
+    #elif defined(SASS_SIMD_SSE2)
+
+    typedef __m128i Vec;
+    static const size_t VecSize = 16;
+    static const uint32_t VecBits = 0xFFFF;
+    static inline Vec vec_load(const char* p) { return _mm_loadu_si128((const __m128i*)p); }
+    static inline Vec vec_set(char chr) { return _mm_set1_epi8(chr); }
+    static inline Vec vec_eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+    static inline Vec vec_or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static inline Vec vec_min(Vec a, Vec b) { return _mm_min_epu8(a, b); }
+    static inline Vec vec_sub(Vec a, Vec b) { return _mm_sub_epi8(a, b); }
+    static inline uint32_t vec_bits(Vec a) { return (uint32_t)_mm_movemask_epi8(a); }
+
+    #endif
+
+    #if defined(SASS_SIMD_AVX2) || defined(SASS_SIMD_SSE2)
+
+    // Index of the lowest bit set (must not be zero)
+    static inline size_t lowest_bit(uint32_t bits)
+    {
+      #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return index;
+      #else
+        return __builtin_ctz(bits);
+      #endif
+    }
+
+    #endif
+
+    // Return the first position where the matcher signals a stop,
+    // or `end` if there is none before it. Only whole chunks before
+    // `end` are loaded, the tail is checked byte by byte.
+    template <typename Matcher>
+    static const char* scan(const char* src, const char* end, const Matcher& stop)
+    {
+      #if defined(SASS_SIMD_AVX2) || defined(SASS_SIMD_SSE2)
+      if (end != nullptr) {
+        while (end - src >= (ptrdiff_t)VecSize) {
+          uint32_t bits = stop(vec_load(src));
+          if (bits) return src + lowest_bit(bits);
+          src += VecSize;
+        }
+      }
+      #endif
+      while (src != end && !stop((unsigned char)*src)) ++src;
+      return src;
+    }
+
+    // Stops at any byte that is no white-space
+    // (the final null is no white-space either)
+    struct NotSpace {
+      #if defined(SASS_SIMD_AVX2) || defined(SASS_SIMD_SSE2)
+      const Vec tab = vec_set('\t');
+      const Vec range = vec_set('\r' - '\t');
+      const Vec space = vec_set(' ');
+      uint32_t operator()(Vec chunk) const {
+        // Chars from tab to carriage return
+        Vec diff = vec_sub(chunk, tab);
+        Vec ctrl = vec_eq(vec_min(diff, range), diff);
+        return vec_bits(vec_or(ctrl, vec_eq(chunk, space))) ^ VecBits;
+      }
+      #endif
+      bool operator()(unsigned char chr) const {
+        return chr != ' ' && (chr < '\t' || chr > '\r');
+      }
+    };
+
+    // Stops at any of the given chars or the final null
+    struct AnyOf {
+      const char a, b, c;
+      #if defined(SASS_SIMD_AVX2) || defined(SASS_SIMD_SSE2)
+      const Vec va = vec_set(a);
+      const Vec vb = vec_set(b);
+      const Vec vc = vec_set(c);
+      const Vec nul = vec_set(0);
+      uint32_t operator()(Vec chunk) const {
+        return vec_bits(vec_or(
+          vec_or(vec_eq(chunk, va), vec_eq(chunk, vb)),
+          vec_or(vec_eq(chunk, vc), vec_eq(chunk, nul))));
+      }
+      #endif
+      AnyOf(char a, char b, char c) : a(a), b(b), c(c) {}
+      bool operator()(unsigned char chr) const {
+        return chr == 0 || chr == (unsigned char)a ||
+          chr == (unsigned char)b || chr == (unsigned char)c;
+      }
+    };
+
+    // Range of the current `Buffer` on this thread
+    static thread_local const char* buffer_begin = nullptr;
+    static thread_local const char* buffer_end = nullptr;
+
+    Buffer::Buffer(const char* begin, const char* end) :
+      previous_begin(buffer_begin),
+      previous_end(buffer_end)
+    {
+      buffer_begin = begin;
+      buffer_end = end;
+    }
+
+    Buffer::~Buffer()
+    {
+      buffer_begin = previous_begin;
+      buffer_end = previous_end;
+    }
+
+    // The given end or the end of the buffer containing `src`
+    static inline const char* bound(const char* src, const char* end)
+    {
+      if (end != nullptr) return end;
+      if (src >= buffer_begin && src < buffer_end) return buffer_end;
+      return nullptr;
+    }
+
+    const char* skip_spaces(const char* src, const char* end)
+    {
+      return scan(src, bound(src, end), NotSpace());
+    }
+
+    const char* find_line_end(const char* src, const char* end)
+    {
+      return scan(src, bound(src, end), AnyOf('\n', '\r', '\f'));
+    }
+
+    const char* find_comment_end(const char* src, const char* end)
+    {
+      AnyOf star('*', '*', '*');
+      end = bound(src, end);
+      while (true) {
+        src = scan(src, end, star);
+        if (src == end || *src == 0) return src;
+        if (src + 1 != end && src[1] == '/') return src;
+        ++src;
+      }
+    }
+
+    const char* find_char(const char* src, char chr, const char* end)
+    {
+      return scan(src, bound(src, end), AnyOf(chr, chr, chr));
+    }
+
+    const char* find_quote_or_escape(const char* src, const char* end)
+    {
+      return scan(src, bound(src, end), AnyOf('"', '\'', '\\'));
+    }
+
+    const char* find_string_special(const char* src, char quote, const char* end)
+    {
+      return scan(src, bound(src, end), AnyOf(quote, '\\', '#'));
+    }
+
+  }
+}
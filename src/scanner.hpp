@@ -0,0 +1,53 @@
+#ifndef SASS_SCANNER_H
+#define SASS_SCANNER_H
+
+// Vectorized scanners for the hot loops of the prelexer. They
+// work on null-terminated buffers and stop at the first null.
+// Whole chunks are compared at once only up to `end` (exclusive),
+// the rest is scanned byte by byte, so we never read past the
+// buffer. Without an `end` we use the end of the current `Buffer`
+// if the scan starts inside it, otherwise only the plain loop.
+// We use AVX2 if the compiler targets it, otherwise SSE2 (always
+// available on x86-64) or plain loops elsewhere.
+// Define `SASS_NO_SIMD` to force the scalar implementation.
+
+namespace Sass {
+  namespace Scanner {
+
+    // Readable range for scans without an explicit end on this
+    // thread (`end` is exclusive). The parser installs its source
+    // once per parse; the previous range is restored on destruction.
+    class Buffer {
+      public:
+        Buffer(const char* begin, const char* end);
+        ~Buffer();
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+      private:
+        const char* previous_begin;
+        const char* previous_end;
+    };
+
+    // Skip over white-space (/[ \t\n\v\f\r]*/)
+    const char* skip_spaces(const char* src, const char* end = nullptr);
+
+    // Find the next line end (/[\n\r\f]|\z/)
+    const char* find_line_end(const char* src, const char* end = nullptr);
+
+    // Find the next `*/` or the final null
+    const char* find_comment_end(const char* src, const char* end = nullptr);
+
+    // Find the next given char or the final null
+    const char* find_char(const char* src, char chr, const char* end = nullptr);
+
+    // Find the next quote, backslash or the final null
+    const char* find_quote_or_escape(const char* src, const char* end = nullptr);
+
+    // Find the next char that may end a string body
+    // (the given quote, a backslash, a hash or null)
+    const char* find_string_special(const char* src, char quote, const char* end = nullptr);
+
+  }
+}
+
+#endif
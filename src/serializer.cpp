@@ -0,0 +1,1572 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <cstring>
+#include <cstdint>
+#include "serializer.hpp"
+#include "MurmurHash2.hpp"
+#include "context.hpp"
+#include "source.hpp"
+#include "file.hpp"
+
+namespace Sass {
+
+  // Magic bytes at the start of every file
+  static const char magic[4] = { 'S', 'A', 'S', 'C' };
+
+  // Seed for the checksums of the source and the data
+  static const uint32_t seed = 0x5A55C0DE;
+
+  // Limit for nested nodes while reading (trees of
+  // the parser are much flatter, see `MAX_NESTING`)
+  static const size_t max_depth = 4096;
+
+  // Type tag in front of every node
+  enum Tag : uint8_t {
+    TAG_NONE,
+    TAG_REF,
+    // statements
+    TAG_BLOCK,
+    TAG_STYLE_RULE,
+    TAG_SUPPORTS_RULE,
+    TAG_MEDIA_RULE,
+    TAG_CSS_MEDIA_RULE,
+    TAG_AT_ROOT_RULE,
+    TAG_AT_RULE,
+    TAG_KEYFRAME_RULE,
+    TAG_DECLARATION,
+    TAG_ASSIGNMENT,
+    TAG_IMPORT,
+    TAG_IMPORT_STUB,
+    TAG_WARNING,
+    TAG_ERROR,
+    TAG_DEBUG,
+    TAG_COMMENT,
+    TAG_IF,
+    TAG_FOR,
+    TAG_EACH,
+    TAG_WHILE,
+    TAG_RETURN,
+    TAG_CONTENT,
+    TAG_EXTEND,
+    TAG_DEFINITION,
+    TAG_MIXIN_CALL,
+    // expressions
+    TAG_NULL,
+    TAG_LIST,
+    TAG_MAP,
+    TAG_BINARY_EXPRESSION,
+    TAG_UNARY_EXPRESSION,
+    TAG_FUNCTION_CALL,
+    TAG_VARIABLE,
+    TAG_NUMBER,
+    TAG_COLOR_RGBA,
+    TAG_COLOR_HSLA,
+    TAG_BOOLEAN,
+    TAG_STRING_SCHEMA,
+    TAG_STRING_QUOTED,
+    TAG_STRING_CONSTANT,
+    TAG_SUPPORTS_CONDITION,
+    TAG_SUPPORTS_OPERATION,
+    TAG_SUPPORTS_NEGATION,
+    TAG_SUPPORTS_DECLARATION,
+    TAG_SUPPORTS_INTERPOLATION,
+    TAG_MEDIA_QUERY,
+    TAG_MEDIA_QUERY_EXPRESSION,
+    TAG_AT_ROOT_QUERY,
+    TAG_PARENT_REFERENCE,
+    TAG_ARGUMENT,
+    TAG_ARGUMENTS,
+    TAG_PLACEHOLDER_SELECTOR,
+    TAG_TYPE_SELECTOR,
+    TAG_CLASS_SELECTOR,
+    TAG_ID_SELECTOR,
+    TAG_ATTRIBUTE_SELECTOR,
+    TAG_PSEUDO_SELECTOR,
+    TAG_SELECTOR_COMBINATOR,
+    TAG_COMPOUND_SELECTOR,
+    TAG_COMPLEX_SELECTOR,
+    TAG_SELECTOR_LIST,
+    // other nodes
+    TAG_CSS_MEDIA_QUERY,
+    TAG_PARAMETER,
+    TAG_PARAMETERS,
+    TAG_SELECTOR_SCHEMA,
+  };
+
+  static bool is_statement(uint8_t tag)
+  {
+    return tag >= TAG_BLOCK && tag <= TAG_MIXIN_CALL;
+  }
+
+  static bool is_expression(uint8_t tag)
+  {
+    return tag >= TAG_NULL && tag <= TAG_SELECTOR_LIST;
+  }
+
+  static void put_u32(sass::string& out, uint32_t value)
+  {
+    for (size_t i = 0; i < 4; i++) {
+      out += (char)((value >> (i * 8)) & 0xFF);
+    }
+  }
+
+  static void put_varint(sass::string& out, uint64_t value)
+  {
+    while (value >= 0x80) {
+      out += (char)((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    out += (char)value;
+  }
+
+  // signed values as varints (small magnitudes stay small)
+  static uint64_t zigzag(int64_t value)
+  {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+  }
+
+  static int64_t unzigzag(uint64_t value)
+  {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+  }
+
+  static uint32_t checksum(const char* data, size_t size)
+  {
+    return MurmurHash2(data, (int)size, seed);
+  }
+
+  sass::string precompiled_path(const sass::string& abs_path)
+  {
+    return abs_path + "c";
+  }
+
+  /////////////////////////////////////////////////////////////////////////
+  // Writing
+  /////////////////////////////////////////////////////////////////////////
+
+  Serializer::Serializer(const SourceData* source, const sass::vector<CachedImport>& imports)
+  : source(source), imports(imports),
+    next_import(0), last_position(0),
+    nodes(), strings(), string_ids(), node_ids()
+  { }
+
+  sass::string Serializer::serialize(Block* root)
+  {
+    write(root);
+    if (next_import != imports.size()) {
+      throw std::runtime_error("imports do not match the tree");
+    }
+    sass::string data;
+    put_varint(data, strings.size());
+    for (const sass::string& str : strings) {
+      put_varint(data, str.size());
+      data += str;
+    }
+    data += nodes;
+    // header with everything needed to check if
+    // the data can still be used for the source
+    sass::string out(magic, sizeof(magic));
+    put_u32(out, SassPrecompiledFormat);
+    sass::string version(libsass_version());
+    put_varint(out, version.size());
+    out += version;
+    put_varint(out, source->size());
+    put_u32(out, checksum(source->begin(), source->size()));
+    put_u32(out, checksum(data.data(), data.size()));
+    return out + data;
+  }
+
+  void Serializer::write(AST_Node* node)
+  {
+    if (node == nullptr) {
+      nodes += (char)TAG_NONE;
+      return;
+    }
+    auto it = node_ids.find(node);
+    if (it != node_ids.end()) {
+      nodes += (char)TAG_REF;
+      write_size(it->second);
+      return;
+    }
+    size_t id = node_ids.size();
+    node_ids[node] = id;
+    node->perform(this);
+  }
+
+  void Serializer::write_size(size_t value)
+  {
+    put_varint(nodes, value);
+  }
+
+  void Serializer::write_bool(bool value)
+  {
+    nodes += (char)(value ? 1 : 0);
+  }
+
+  void Serializer::write_double(double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u32(nodes, (uint32_t)(bits & 0xFFFFFFFF));
+    put_u32(nodes, (uint32_t)(bits >> 32));
+  }
+
+  void Serializer::write_string(const sass::string& value)
+  {
+    auto it = string_ids.find(value);
+    if (it != string_ids.end()) {
+      write_size(it->second);
+      return;
+    }
+    size_t id = strings.size();
+    string_ids.insert(std::make_pair(value, id));
+    strings.push_back(value);
+    write_size(id);
+  }
+
+  void Serializer::write_strings(const sass::vector<sass::string>& values)
+  {
+    write_size(values.size());
+    for (const sass::string& value : values) {
+      write_string(value);
+    }
+  }
+
+  void Serializer::write_span(const SourceSpan& pstate)
+  {
+    if (pstate.source.ptr() != source) {
+      throw std::runtime_error("span outside of the source");
+    }
+    // store the distance to the previous span, since
+    // nodes are mostly written in source order
+    put_varint(nodes, zigzag((int64_t)pstate.position - (int64_t)last_position));
+    last_position = pstate.position;
+    write_size(pstate.offset);
+  }
+
+  void Serializer::write_node(uint8_t tag, AST_Node* node)
+  {
+    nodes += (char)tag;
+    write_span(node->pstate());
+  }
+
+  void Serializer::write_statement(uint8_t tag, Statement* node)
+  {
+    write_node(tag, node);
+    write_size(node->statement_type());
+    write_size(node->tabs());
+    write_bool(node->group_end());
+  }
+
+  void Serializer::write_expression(uint8_t tag, Expression* node)
+  {
+    write_node(tag, node);
+    write_size(node->concrete_type());
+    write_size((node->is_delayed() ? 1 : 0) |
+      (node->is_expanded() ? 2 : 0) | (node->is_interpolant() ? 4 : 0));
+  }
+
+  void Serializer::write_simple(uint8_t tag, SimpleSelector* node)
+  {
+    write_expression(tag, node);
+    write_string(node->ns());
+    write_string(node->name());
+    write_size(node->simple_type());
+    write_bool(node->has_ns());
+  }
+
+  void Serializer::operator()(Block* node)
+  {
+    write_statement(TAG_BLOCK, node);
+    write_bool(node->is_root());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(StyleRule* node)
+  {
+    write_statement(TAG_STYLE_RULE, node);
+    write(node->block());
+    write(node->selector());
+    write(node->schema());
+    write_bool(node->is_root());
+  }
+
+  void Serializer::operator()(SupportsRule* node)
+  {
+    write_statement(TAG_SUPPORTS_RULE, node);
+    write(node->block());
+    write(node->condition());
+  }
+
+  void Serializer::operator()(MediaRule* node)
+  {
+    write_statement(TAG_MEDIA_RULE, node);
+    write(node->block());
+    write(node->schema());
+  }
+
+  void Serializer::operator()(CssMediaRule* node)
+  {
+    write_statement(TAG_CSS_MEDIA_RULE, node);
+    write(node->block());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(CssMediaQuery* node)
+  {
+    write_node(TAG_CSS_MEDIA_QUERY, node);
+    write_string(node->modifier());
+    write_string(node->type());
+    write_strings(node->features());
+  }
+
+  void Serializer::operator()(AtRootRule* node)
+  {
+    write_statement(TAG_AT_ROOT_RULE, node);
+    write(node->block());
+    write(node->expression());
+  }
+
+  void Serializer::operator()(AtRule* node)
+  {
+    write_statement(TAG_AT_RULE, node);
+    write(node->block());
+    write_string(node->keyword());
+    write(node->selector());
+    write(node->value());
+  }
+
+  void Serializer::operator()(Keyframe_Rule* node)
+  {
+    write_statement(TAG_KEYFRAME_RULE, node);
+    write(node->block());
+    write(node->name());
+  }
+
+  void Serializer::operator()(Declaration* node)
+  {
+    write_statement(TAG_DECLARATION, node);
+    write(node->block());
+    write(node->property());
+    write(node->value());
+    write_bool(node->is_important());
+    write_bool(node->is_custom_property());
+    write_bool(node->is_indented());
+  }
+
+  void Serializer::operator()(Assignment* node)
+  {
+    write_statement(TAG_ASSIGNMENT, node);
+    write_string(node->variable());
+    write(node->value());
+    write_bool(node->is_default());
+    write_bool(node->is_global());
+  }
+
+  void Serializer::operator()(Import* node)
+  {
+    // file imports are stored via their stubs
+    write_statement(TAG_IMPORT, node);
+    write_elements(node->urls());
+    write(node->import_queries());
+  }
+
+  void Serializer::operator()(Import_Stub* node)
+  {
+    // stubs must follow the order of the imports
+    if (next_import == imports.size()) {
+      throw std::runtime_error("import stub without import");
+    }
+    const CachedImport& imp(imports[next_import++]);
+    if (imp.abs_path != node->abs_path()) {
+      throw std::runtime_error("import stub out of order");
+    }
+    write_statement(TAG_IMPORT_STUB, node);
+    write_string(imp.importer.imp_path);
+    write_span(imp.pstate);
+  }
+
+  void Serializer::operator()(WarningRule* node)
+  {
+    write_statement(TAG_WARNING, node);
+    write(node->message());
+  }
+
+  void Serializer::operator()(ErrorRule* node)
+  {
+    write_statement(TAG_ERROR, node);
+    write(node->message());
+  }
+
+  void Serializer::operator()(DebugRule* node)
+  {
+    write_statement(TAG_DEBUG, node);
+    write(node->value());
+  }
+
+  void Serializer::operator()(Comment* node)
+  {
+    write_statement(TAG_COMMENT, node);
+    write(node->text());
+    write_bool(node->is_important());
+  }
+
+  void Serializer::operator()(If* node)
+  {
+    write_statement(TAG_IF, node);
+    write(node->block());
+    write(node->predicate());
+    write(node->alternative());
+  }
+
+  void Serializer::operator()(ForRule* node)
+  {
+    write_statement(TAG_FOR, node);
+    write(node->block());
+    write_string(node->variable());
+    write(node->lower_bound());
+    write(node->upper_bound());
+    write_bool(node->is_inclusive());
+  }
+
+  void Serializer::operator()(EachRule* node)
+  {
+    write_statement(TAG_EACH, node);
+    write(node->block());
+    write_strings(node->variables());
+    write(node->list());
+  }
+
+  void Serializer::operator()(WhileRule* node)
+  {
+    write_statement(TAG_WHILE, node);
+    write(node->block());
+    write(node->predicate());
+  }
+
+  void Serializer::operator()(Return* node)
+  {
+    write_statement(TAG_RETURN, node);
+    write(node->value());
+  }
+
+  void Serializer::operator()(Content* node)
+  {
+    write_statement(TAG_CONTENT, node);
+    write(node->arguments());
+  }
+
+  void Serializer::operator()(ExtendRule* node)
+  {
+    write_statement(TAG_EXTEND, node);
+    write_bool(node->isOptional());
+    write(node->selector());
+    write(node->schema());
+  }
+
+  void Serializer::operator()(Definition* node)
+  {
+    // only definitions of the parser
+    if (node->environment() || node->native_function() ||
+        node->c_function() || node->cookie() ||
+        node->is_overload_stub() || node->signature()) {
+      throw std::runtime_error("can't serialize built-in definition");
+    }
+    write_statement(TAG_DEFINITION, node);
+    write(node->block());
+    write_string(node->name());
+    write(node->parameters());
+    write_size(node->type());
+  }
+
+  void Serializer::operator()(Mixin_Call* node)
+  {
+    write_statement(TAG_MIXIN_CALL, node);
+    write(node->block());
+    write_string(node->name());
+    write(node->arguments());
+    write(node->block_parameters());
+  }
+
+  void Serializer::operator()(Null* node)
+  {
+    write_expression(TAG_NULL, node);
+  }
+
+  void Serializer::operator()(List* node)
+  {
+    write_expression(TAG_LIST, node);
+    write_size(node->separator());
+    write_bool(node->is_arglist());
+    write_bool(node->is_bracketed());
+    write_bool(node->from_selector());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(Map* node)
+  {
+    write_expression(TAG_MAP, node);
+    const sass::vector<ExpressionObj>& keys(node->keys());
+    const sass::vector<ExpressionObj>& values(node->values());
+    write_size(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      write(keys[i]);
+      write(values[i]);
+    }
+    // evaluation reports the first duplicate key
+    ExpressionObj duplicate(node->get_duplicate_key());
+    write(duplicate);
+    if (duplicate) write(node->at(duplicate));
+  }
+
+  void Serializer::operator()(Binary_Expression* node)
+  {
+    write_expression(TAG_BINARY_EXPRESSION, node);
+    const Operand& op(node->op());
+    write_size(op.operand);
+    write_bool(op.ws_before);
+    write_bool(op.ws_after);
+    write(node->left());
+    write(node->right());
+  }
+
+  void Serializer::operator()(Unary_Expression* node)
+  {
+    write_expression(TAG_UNARY_EXPRESSION, node);
+    write_size(node->optype());
+    write(node->operand());
+  }
+
+  void Serializer::operator()(Function_Call* node)
+  {
+    // only calls that are not yet resolved
+    if (node->func() || node->cookie()) {
+      throw std::runtime_error("can't serialize resolved function call");
+    }
+    write_expression(TAG_FUNCTION_CALL, node);
+    write(node->sname());
+    write(node->arguments());
+    write_bool(node->via_call());
+  }
+
+  void Serializer::operator()(Variable* node)
+  {
+    write_expression(TAG_VARIABLE, node);
+    write_string(node->name());
+  }
+
+  void Serializer::operator()(Number* node)
+  {
+    write_expression(TAG_NUMBER, node);
+    write_double(node->value());
+    write_bool(node->zero());
+    write_strings(node->numerators);
+    write_strings(node->denominators);
+  }
+
+  void Serializer::operator()(Color_RGBA* node)
+  {
+    write_expression(TAG_COLOR_RGBA, node);
+    write_double(node->r());
+    write_double(node->g());
+    write_double(node->b());
+    write_double(node->a());
+    write_string(node->disp());
+  }
+
+  void Serializer::operator()(Color_HSLA* node)
+  {
+    write_expression(TAG_COLOR_HSLA, node);
+    write_double(node->h());
+    write_double(node->s());
+    write_double(node->l());
+    write_double(node->a());
+    write_string(node->disp());
+  }
+
+  void Serializer::operator()(Boolean* node)
+  {
+    write_expression(TAG_BOOLEAN, node);
+    write_bool(node->value());
+  }
+
+  void Serializer::operator()(String_Schema* node)
+  {
+    write_expression(TAG_STRING_SCHEMA, node);
+    write_bool(node->css());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(String_Quoted* node)
+  {
+    write_expression(TAG_STRING_QUOTED, node);
+    write_size((unsigned char)node->quote_mark());
+    write_string(node->value());
+  }
+
+  void Serializer::operator()(String_Constant* node)
+  {
+    write_expression(TAG_STRING_CONSTANT, node);
+    write_size((unsigned char)node->quote_mark());
+    write_string(node->value());
+  }
+
+  void Serializer::operator()(SupportsCondition* node)
+  {
+    write_expression(TAG_SUPPORTS_CONDITION, node);
+  }
+
+  void Serializer::operator()(SupportsOperation* node)
+  {
+    write_expression(TAG_SUPPORTS_OPERATION, node);
+    write(node->left());
+    write(node->right());
+    write_size(node->operand());
+  }
+
+  void Serializer::operator()(SupportsNegation* node)
+  {
+    write_expression(TAG_SUPPORTS_NEGATION, node);
+    write(node->condition());
+  }
+
+  void Serializer::operator()(SupportsDeclaration* node)
+  {
+    write_expression(TAG_SUPPORTS_DECLARATION, node);
+    write(node->feature());
+    write(node->value());
+  }
+
+  void Serializer::operator()(Supports_Interpolation* node)
+  {
+    write_expression(TAG_SUPPORTS_INTERPOLATION, node);
+    write(node->value());
+  }
+
+  void Serializer::operator()(Media_Query* node)
+  {
+    write_expression(TAG_MEDIA_QUERY, node);
+    write(node->media_type());
+    write_bool(node->is_negated());
+    write_bool(node->is_restricted());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(Media_Query_Expression* node)
+  {
+    write_expression(TAG_MEDIA_QUERY_EXPRESSION, node);
+    write(node->feature());
+    write(node->value());
+    write_bool(node->is_interpolated());
+  }
+
+  void Serializer::operator()(At_Root_Query* node)
+  {
+    write_expression(TAG_AT_ROOT_QUERY, node);
+    write(node->feature());
+    write(node->value());
+  }
+
+  void Serializer::operator()(Parent_Reference* node)
+  {
+    write_expression(TAG_PARENT_REFERENCE, node);
+  }
+
+  void Serializer::operator()(Parameter* node)
+  {
+    write_node(TAG_PARAMETER, node);
+    write_string(node->name());
+    write(node->default_value());
+    write_bool(node->is_rest_parameter());
+  }
+
+  void Serializer::operator()(Parameters* node)
+  {
+    write_node(TAG_PARAMETERS, node);
+    write_bool(node->has_optional_parameters());
+    write_bool(node->has_rest_parameter());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(Argument* node)
+  {
+    write_expression(TAG_ARGUMENT, node);
+    write(node->value());
+    write_string(node->name());
+    write_bool(node->is_rest_argument());
+    write_bool(node->is_keyword_argument());
+  }
+
+  void Serializer::operator()(Arguments* node)
+  {
+    write_expression(TAG_ARGUMENTS, node);
+    write_bool(node->has_named_arguments());
+    write_bool(node->has_rest_argument());
+    write_bool(node->has_keyword_argument());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(Selector_Schema* node)
+  {
+    write_node(TAG_SELECTOR_SCHEMA, node);
+    write(node->contents());
+    write_bool(node->connect_parent());
+  }
+
+  void Serializer::operator()(PlaceholderSelector* node)
+  {
+    write_simple(TAG_PLACEHOLDER_SELECTOR, node);
+  }
+
+  void Serializer::operator()(TypeSelector* node)
+  {
+    write_simple(TAG_TYPE_SELECTOR, node);
+  }
+
+  void Serializer::operator()(ClassSelector* node)
+  {
+    write_simple(TAG_CLASS_SELECTOR, node);
+  }
+
+  void Serializer::operator()(IDSelector* node)
+  {
+    write_simple(TAG_ID_SELECTOR, node);
+  }
+
+  void Serializer::operator()(AttributeSelector* node)
+  {
+    write_simple(TAG_ATTRIBUTE_SELECTOR, node);
+    write_string(node->matcher());
+    write(node->value());
+    write_size((unsigned char)node->modifier());
+  }
+
+  void Serializer::operator()(PseudoSelector* node)
+  {
+    write_simple(TAG_PSEUDO_SELECTOR, node);
+    write_string(node->normalized());
+    write(node->argument());
+    write(node->selector());
+    write_bool(node->isSyntacticClass());
+    write_bool(node->isClass());
+  }
+
+  void Serializer::operator()(SelectorCombinator* node)
+  {
+    write_expression(TAG_SELECTOR_COMBINATOR, node);
+    write_bool(node->hasPostLineBreak());
+    write_size(node->combinator());
+  }
+
+  void Serializer::operator()(CompoundSelector* node)
+  {
+    write_expression(TAG_COMPOUND_SELECTOR, node);
+    write_bool(node->hasPostLineBreak());
+    write_bool(node->hasRealParent());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(ComplexSelector* node)
+  {
+    write_expression(TAG_COMPLEX_SELECTOR, node);
+    write_bool(node->chroots());
+    write_bool(node->hasPreLineFeed());
+    write_elements(node->elements());
+  }
+
+  void Serializer::operator()(SelectorList* node)
+  {
+    write_expression(TAG_SELECTOR_LIST, node);
+    write_bool(node->is_optional());
+    write_elements(node->elements());
+  }
+
+  bool serialize_sheet(const StyleSheet& sheet, sass::string& data)
+  {
+    try {
+      Serializer serializer(sheet.source.ptr(), sheet.imports);
+      data = serializer.serialize(sheet.root);
+    }
+    catch (std::runtime_error&) {
+      return false;
+    }
+    return true;
+  }
+
+  bool write_precompiled(const StyleSheet& sheet)
+  {
+    sass::string data;
+    if (!serialize_sheet(sheet, data)) return false;
+    return File::write_bytes(precompiled_path(sheet.source->getPath()), data);
+  }
+
+  /////////////////////////////////////////////////////////////////////////
+  // Reading
+  /////////////////////////////////////////////////////////////////////////
+
+  // Thrown for data we can't use (never leaves the reader)
+  struct InvalidFormat {};
+
+  Deserializer::Deserializer(Context& ctx, SourceFileObj source)
+  : ctx(ctx), traces(ctx.traces), source(source),
+    position(nullptr), end(nullptr),
+    strings(), nodes(), depth(0), last_position(0), pending()
+  { }
+
+  void Deserializer::malformed()
+  {
+    throw InvalidFormat();
+  }
+
+  Block_Obj Deserializer::deserialize(const char* data, size_t size)
+  {
+    position = data;
+    end = data + size;
+    Block_Obj root;
+    try {
+      root = read_tree();
+    }
+    catch (InvalidFormat&) {
+      return {};
+    }
+    // load the imports in the same order as the parser
+    // errors are reported the same way as when parsing
+    for (const Pending& stub : pending) {
+      const Importer importer(stub.imp_path, source->getPath());
+      Include include(ctx.import_file(importer, stub.statement));
+      Import_Stub* node = SASS_MEMORY_NEW(Import_Stub, stub.pstate, include);
+      node->tabs(stub.tabs);
+      node->group_end(stub.group_end);
+      stub.block->elements()[stub.index] = node;
+    }
+    return root;
+  }
+
+  Block_Obj Deserializer::read_tree()
+  {
+    // check the header first
+    if (size_t(end - position) < sizeof(magic)) malformed();
+    if (std::memcmp(position, magic, sizeof(magic)) != 0) malformed();
+    position += sizeof(magic);
+    if (read_u32() != SassPrecompiledFormat) malformed();
+    if (read_string_data() != libsass_version()) malformed();
+    if (read_size() != source->size()) malformed();
+    if (read_u32() != checksum(source->begin(), source->size())) malformed();
+    if (read_u32() != checksum(position, end - position)) malformed();
+    // then the string table
+    size_t count = read_count();
+    strings.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      size_t length = read_size();
+      if (length > size_t(end - position)) malformed();
+      strings.push_back(std::make_pair(position, length));
+      position += length;
+    }
+    // and finally the nodes
+    AST_Node_Obj root = read();
+    Block* block = Cast<Block>(root.ptr());
+    if (block == nullptr || position != end) malformed();
+    return block;
+  }
+
+  uint8_t Deserializer::read_byte()
+  {
+    if (position == end) malformed();
+    return (uint8_t)*position++;
+  }
+
+  uint32_t Deserializer::read_u32()
+  {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+      value |= (uint32_t)read_byte() << (i * 8);
+    }
+    return value;
+  }
+
+  size_t Deserializer::read_size()
+  {
+    uint64_t value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = read_byte();
+      value |= (uint64_t)(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        if (value > SIZE_MAX) malformed();
+        return (size_t)value;
+      }
+    }
+    malformed();
+    return 0;
+  }
+
+  size_t Deserializer::read_count()
+  {
+    // every element takes at least one byte
+    size_t count = read_size();
+    if (count > size_t(end - position)) malformed();
+    return count;
+  }
+
+  bool Deserializer::read_bool()
+  {
+    uint8_t value = read_byte();
+    if (value > 1) malformed();
+    return value == 1;
+  }
+
+  double Deserializer::read_double()
+  {
+    uint64_t bits = read_u32();
+    bits |= (uint64_t)read_u32() << 32;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  char Deserializer::read_char()
+  {
+    size_t value = read_size();
+    if (value > 0xFF) malformed();
+    return (char)value;
+  }
+
+  sass::string Deserializer::read_string_data()
+  {
+    size_t length = read_size();
+    if (length > size_t(end - position)) malformed();
+    sass::string value(position, length);
+    position += length;
+    return value;
+  }
+
+  sass::string Deserializer::read_string()
+  {
+    size_t id = read_size();
+    if (id >= strings.size()) malformed();
+    return sass::string(strings[id].first, strings[id].second);
+  }
+
+  sass::vector<sass::string> Deserializer::read_strings()
+  {
+    size_t count = read_count();
+    sass::vector<sass::string> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      values.push_back(read_string());
+    }
+    return values;
+  }
+
+  SourceSpan Deserializer::read_span()
+  {
+    int64_t position = (int64_t)last_position + unzigzag(read_size());
+    size_t offset = read_size();
+    if (position < 0 || size_t(position) > source->size()) malformed();
+    // the parser may create spans that end before they start
+    if (size_t(position) + offset > source->size()) malformed();
+    last_position = size_t(position);
+    return SourceSpan(source, last_position, offset);
+  }
+
+  Block_Obj Deserializer::read_block(const SourceSpan& pstate)
+  {
+    Block_Obj block = SASS_MEMORY_NEW(Block, pstate);
+    block->is_root(read_bool());
+    size_t count = read_count();
+    for (size_t i = 0; i < count; i++) {
+      MEMORY_GUARD(ctx.budget, pstate);
+      if (position < end && (uint8_t)*position == TAG_IMPORT_STUB) {
+        // the stub is added once the import is loaded
+        ++position;
+        nodes.push_back({});
+        Pending stub{ block, block->length(), read_span(), 0, false, "", pstate };
+        if (read_size() != Statement::IMPORT_STUB) malformed();
+        stub.tabs = read_size();
+        stub.group_end = read_bool();
+        stub.imp_path = read_string();
+        stub.statement = read_span();
+        block->elements().push_back({});
+        pending.push_back(stub);
+      }
+      else {
+        Statement_Obj child = read_as<Statement>();
+        if (child.isNull()) malformed();
+        block->elements().push_back(child);
+      }
+    }
+    return block;
+  }
+
+  AST_Node* Deserializer::read()
+  {
+    uint8_t tag = read_byte();
+    if (tag == TAG_NONE) return nullptr;
+    if (tag == TAG_REF) {
+      size_t id = read_size();
+      if (id >= nodes.size() || nodes[id].isNull()) malformed();
+      return nodes[id];
+    }
+    if (++depth > max_depth) malformed();
+    // reserve the index of the node
+    size_t id = nodes.size();
+    nodes.push_back({});
+    SourceSpan pstate(read_span());
+
+    // common fields come first
+    size_t type = 0, tabs = 0;
+    bool group_end = false;
+    bool delayed = false, expanded = false, interpolant = false;
+    if (is_statement(tag)) {
+      type = read_enum(Statement::IF);
+      tabs = read_size();
+      group_end = read_bool();
+    }
+    else if (is_expression(tag)) {
+      type = read_enum(Expression::NUM_TYPES);
+      size_t flags = read_size();
+      if (flags > 7) malformed();
+      delayed = (flags & 1) != 0;
+      expanded = (flags & 2) != 0;
+      interpolant = (flags & 4) != 0;
+    }
+
+    AST_Node_Obj node;
+    switch (tag) {
+
+      case TAG_BLOCK:
+        node = read_block(pstate);
+        break;
+
+      case TAG_STYLE_RULE: {
+        StyleRule* rule = SASS_MEMORY_NEW(StyleRule, pstate);
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->selector(read_as<SelectorList>());
+        rule->schema(read_as<Selector_Schema>());
+        rule->is_root(read_bool());
+        break;
+      }
+
+      case TAG_SUPPORTS_RULE: {
+        SupportsRule* rule = SASS_MEMORY_NEW(SupportsRule, pstate, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->condition(read_as<SupportsCondition>());
+        break;
+      }
+
+      case TAG_MEDIA_RULE: {
+        MediaRule* rule = SASS_MEMORY_NEW(MediaRule, pstate);
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->schema(read_as<List>());
+        break;
+      }
+
+      case TAG_CSS_MEDIA_RULE: {
+        CssMediaRule* rule = SASS_MEMORY_NEW(CssMediaRule, pstate, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        read_elements<CssMediaQuery>(rule);
+        break;
+      }
+
+      case TAG_AT_ROOT_RULE: {
+        AtRootRule* rule = SASS_MEMORY_NEW(AtRootRule, pstate);
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->expression(read_as<At_Root_Query>());
+        break;
+      }
+
+      case TAG_AT_RULE: {
+        AtRule* rule = SASS_MEMORY_NEW(AtRule, pstate, "");
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->keyword(read_string());
+        rule->selector(read_as<SelectorList>());
+        rule->value(read_as<Expression>());
+        break;
+      }
+
+      case TAG_KEYFRAME_RULE: {
+        Keyframe_Rule* rule = SASS_MEMORY_NEW(Keyframe_Rule, pstate, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->name(read_as<SelectorList>());
+        break;
+      }
+
+      case TAG_DECLARATION: {
+        Declaration* decl = SASS_MEMORY_NEW(Declaration, pstate, {}, {});
+        node = decl;
+        decl->block(read_as<Block>());
+        decl->property(read_as<String>());
+        decl->value(read_as<Expression>());
+        decl->is_important(read_bool());
+        decl->is_custom_property(read_bool());
+        decl->is_indented(read_bool());
+        break;
+      }
+
+      case TAG_ASSIGNMENT: {
+        sass::string variable(read_string());
+        Assignment* assn = SASS_MEMORY_NEW(Assignment, pstate, variable, {});
+        node = assn;
+        assn->value(read_as<Expression>());
+        assn->is_default(read_bool());
+        assn->is_global(read_bool());
+        break;
+      }
+
+      case TAG_IMPORT: {
+        Import* imp = SASS_MEMORY_NEW(Import, pstate);
+        node = imp;
+        size_t count = read_count();
+        for (size_t i = 0; i < count; i++) {
+          imp->urls().push_back(read_as<Expression>());
+        }
+        imp->import_queries(read_as<List>());
+        break;
+      }
+
+      case TAG_WARNING:
+        node = SASS_MEMORY_NEW(WarningRule, pstate, read_as<Expression>());
+        break;
+
+      case TAG_ERROR:
+        node = SASS_MEMORY_NEW(ErrorRule, pstate, read_as<Expression>());
+        break;
+
+      case TAG_DEBUG:
+        node = SASS_MEMORY_NEW(DebugRule, pstate, read_as<Expression>());
+        break;
+
+      case TAG_COMMENT: {
+        String_Obj text(read_as<String>());
+        node = SASS_MEMORY_NEW(Comment, pstate, text, read_bool());
+        break;
+      }
+
+      case TAG_IF: {
+        If* rule = SASS_MEMORY_NEW(If, pstate, {}, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->predicate(read_as<Expression>());
+        rule->alternative(read_as<Block>());
+        break;
+      }
+
+      case TAG_FOR: {
+        ForRule* rule = SASS_MEMORY_NEW(ForRule, pstate, "", {}, {}, {}, false);
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->variable(read_string());
+        rule->lower_bound(read_as<Expression>());
+        rule->upper_bound(read_as<Expression>());
+        rule->is_inclusive(read_bool());
+        break;
+      }
+
+      case TAG_EACH: {
+        EachRule* rule = SASS_MEMORY_NEW(EachRule, pstate, {}, {}, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->variables(read_strings());
+        rule->list(read_as<Expression>());
+        break;
+      }
+
+      case TAG_WHILE: {
+        WhileRule* rule = SASS_MEMORY_NEW(WhileRule, pstate, {}, {});
+        node = rule;
+        rule->block(read_as<Block>());
+        rule->predicate(read_as<Expression>());
+        break;
+      }
+
+      case TAG_RETURN:
+        node = SASS_MEMORY_NEW(Return, pstate, read_as<Expression>());
+        break;
+
+      case TAG_CONTENT:
+        node = SASS_MEMORY_NEW(Content, pstate, read_as<Arguments>());
+        break;
+
+      case TAG_EXTEND: {
+        ExtendRule* rule = SASS_MEMORY_NEW(ExtendRule, pstate, SelectorListObj());
+        node = rule;
+        rule->isOptional(read_bool());
+        rule->selector(read_as<SelectorList>());
+        rule->schema(read_as<Selector_Schema>());
+        break;
+      }
+
+      case TAG_DEFINITION: {
+        Block_Obj block(read_as<Block>());
+        sass::string name(read_string());
+        Parameters_Obj params(read_as<Parameters>());
+        Definition::Type def_type = read_enum(Definition::FUNCTION);
+        node = SASS_MEMORY_NEW(Definition, pstate, name, params, block, def_type);
+        break;
+      }
+
+      case TAG_MIXIN_CALL: {
+        Block_Obj block(read_as<Block>());
+        sass::string name(read_string());
+        Arguments_Obj args(read_as<Arguments>());
+        Parameters_Obj params(read_as<Parameters>());
+        node = SASS_MEMORY_NEW(Mixin_Call, pstate, name, args, params, block);
+        break;
+      }
+
+      case TAG_NULL:
+        node = SASS_MEMORY_NEW(Null, pstate);
+        break;
+
+      case TAG_LIST: {
+        List* list = SASS_MEMORY_NEW(List, pstate);
+        node = list;
+        list->separator(read_enum(SASS_HASH));
+        list->is_arglist(read_bool());
+        list->is_bracketed(read_bool());
+        list->from_selector(read_bool());
+        read_elements<Expression>(list);
+        break;
+      }
+
+      case TAG_MAP: {
+        Map* map = SASS_MEMORY_NEW(Map, pstate);
+        node = map;
+        size_t count = read_count();
+        for (size_t i = 0; i < count; i++) {
+          ExpressionObj key(read_as<Expression>());
+          ExpressionObj value(read_as<Expression>());
+          if (key.isNull()) malformed();
+          *map << std::make_pair(key, value);
+        }
+        if (ExpressionObj key = read_as<Expression>()) {
+          *map << std::make_pair(key, read_as<Expression>());
+        }
+        break;
+      }
+
+      case TAG_BINARY_EXPRESSION: {
+        Sass_OP op = read_enum(NUM_OPS);
+        bool ws_before = read_bool();
+        bool ws_after = read_bool();
+        ExpressionObj left(read_as<Expression>());
+        ExpressionObj right(read_as<Expression>());
+        node = SASS_MEMORY_NEW(Binary_Expression, pstate,
+          Operand(op, ws_before, ws_after), left, right);
+        break;
+      }
+
+      case TAG_UNARY_EXPRESSION: {
+        Unary_Expression::Type op = read_enum(Unary_Expression::SLASH);
+        node = SASS_MEMORY_NEW(Unary_Expression, pstate, op, read_as<Expression>());
+        break;
+      }
+
+      case TAG_FUNCTION_CALL: {
+        String_Obj name(read_as<String>());
+        Arguments_Obj args(read_as<Arguments>());
+        Function_Call* call = SASS_MEMORY_NEW(Function_Call, pstate, name, args);
+        node = call;
+        call->via_call(read_bool());
+        break;
+      }
+
+      case TAG_VARIABLE:
+        node = SASS_MEMORY_NEW(Variable, pstate, read_string());
+        break;
+
+      case TAG_NUMBER: {
+        double value = read_double();
+        bool zero = read_bool();
+        Number* number = SASS_MEMORY_NEW(Number, pstate, value, "", zero);
+        node = number;
+        number->numerators = read_strings();
+        number->denominators = read_strings();
+        break;
+      }
+
+      case TAG_COLOR_RGBA: {
+        double r = read_double();
+        double g = read_double();
+        double b = read_double();
+        double a = read_double();
+        node = SASS_MEMORY_NEW(Color_RGBA, pstate, r, g, b, a, read_string());
+        break;
+      }
+
+      case TAG_COLOR_HSLA: {
+        // bypass clipping in the constructor
+        Color_HSLA* color = SASS_MEMORY_NEW(Color_HSLA, pstate, 0, 0, 0);
+        node = color;
+        color->h(read_double());
+        color->s(read_double());
+        color->l(read_double());
+        color->a(read_double());
+        color->disp(read_string());
+        break;
+      }
+
+      case TAG_BOOLEAN:
+        node = SASS_MEMORY_NEW(Boolean, pstate, read_bool());
+        break;
+
+      case TAG_STRING_SCHEMA: {
+        String_Schema* schema = SASS_MEMORY_NEW(String_Schema, pstate);
+        node = schema;
+        schema->css(read_bool());
+        read_elements<PreValue>(schema);
+        break;
+      }
+
+      case TAG_STRING_QUOTED: {
+        // the value is already unquoted
+        String_Quoted* str = SASS_MEMORY_NEW(String_Quoted, pstate, "", 0, false, true);
+        node = str;
+        str->quote_mark(read_char());
+        str->value(read_string());
+        break;
+      }
+
+      case TAG_STRING_CONSTANT: {
+        // the value is already unescaped
+        String_Constant* str = SASS_MEMORY_NEW(String_Constant, pstate, "");
+        node = str;
+        str->quote_mark(read_char());
+        str->value(read_string());
+        break;
+      }
+
+      case TAG_SUPPORTS_CONDITION:
+        node = SASS_MEMORY_NEW(SupportsCondition, pstate);
+        break;
+
+      case TAG_SUPPORTS_OPERATION: {
+        SupportsConditionObj left(read_as<SupportsCondition>());
+        SupportsConditionObj right(read_as<SupportsCondition>());
+        SupportsOperation::Operand op = read_enum(SupportsOperation::OR);
+        node = SASS_MEMORY_NEW(SupportsOperation, pstate, left, right, op);
+        break;
+      }
+
+      case TAG_SUPPORTS_NEGATION:
+        node = SASS_MEMORY_NEW(SupportsNegation, pstate, read_as<SupportsCondition>());
+        break;
+
+      case TAG_SUPPORTS_DECLARATION: {
+        ExpressionObj feature(read_as<Expression>());
+        ExpressionObj value(read_as<Expression>());
+        node = SASS_MEMORY_NEW(SupportsDeclaration, pstate, feature, value);
+        break;
+      }
+
+      case TAG_SUPPORTS_INTERPOLATION:
+        node = SASS_MEMORY_NEW(Supports_Interpolation, pstate, read_as<Expression>());
+        break;
+
+      case TAG_MEDIA_QUERY: {
+        Media_Query* query = SASS_MEMORY_NEW(Media_Query, pstate);
+        node = query;
+        query->media_type(read_as<String>());
+        query->is_negated(read_bool());
+        query->is_restricted(read_bool());
+        read_elements<Media_Query_Expression>(query);
+        break;
+      }
+
+      case TAG_MEDIA_QUERY_EXPRESSION: {
+        ExpressionObj feature(read_as<Expression>());
+        ExpressionObj value(read_as<Expression>());
+        node = SASS_MEMORY_NEW(Media_Query_Expression, pstate, feature, value, read_bool());
+        break;
+      }
+
+      case TAG_AT_ROOT_QUERY: {
+        ExpressionObj feature(read_as<Expression>());
+        ExpressionObj value(read_as<Expression>());
+        node = SASS_MEMORY_NEW(At_Root_Query, pstate, feature, value);
+        break;
+      }
+
+      case TAG_PARENT_REFERENCE:
+        node = SASS_MEMORY_NEW(Parent_Reference, pstate);
+        break;
+
+      case TAG_ARGUMENT: {
+        // the name is set afterwards, since the
+        // constructor fails for named rest args
+        Argument* arg = SASS_MEMORY_NEW(Argument, pstate, read_as<Expression>());
+        node = arg;
+        arg->name(read_string());
+        arg->is_rest_argument(read_bool());
+        arg->is_keyword_argument(read_bool());
+        break;
+      }
+
+      case TAG_ARGUMENTS: {
+        // flags are not derived from the elements
+        Arguments* args = SASS_MEMORY_NEW(Arguments, pstate);
+        node = args;
+        args->has_named_arguments(read_bool());
+        args->has_rest_argument(read_bool());
+        args->has_keyword_argument(read_bool());
+        read_elements<Argument>(args);
+        break;
+      }
+
+      case TAG_PLACEHOLDER_SELECTOR:
+        node = read_simple(SASS_MEMORY_NEW(PlaceholderSelector, pstate, ""));
+        break;
+
+      case TAG_TYPE_SELECTOR:
+        node = read_simple(SASS_MEMORY_NEW(TypeSelector, pstate, ""));
+        break;
+
+      case TAG_CLASS_SELECTOR:
+        node = read_simple(SASS_MEMORY_NEW(ClassSelector, pstate, ""));
+        break;
+
+      case TAG_ID_SELECTOR:
+        node = read_simple(SASS_MEMORY_NEW(IDSelector, pstate, ""));
+        break;
+
+      case TAG_ATTRIBUTE_SELECTOR: {
+        AttributeSelector* sel = SASS_MEMORY_NEW(AttributeSelector, pstate, "", "", {});
+        node = sel;
+        read_simple(sel);
+        sel->matcher(read_string());
+        sel->value(read_as<String>());
+        sel->modifier(read_char());
+        break;
+      }
+
+      case TAG_PSEUDO_SELECTOR: {
+        PseudoSelector* sel = SASS_MEMORY_NEW(PseudoSelector, pstate, "");
+        node = sel;
+        read_simple(sel);
+        sel->normalized(read_string());
+        sel->argument(read_as<String>());
+        sel->selector(read_as<SelectorList>());
+        sel->isSyntacticClass(read_bool());
+        sel->isClass(read_bool());
+        break;
+      }
+
+      case TAG_SELECTOR_COMBINATOR: {
+        bool line_break = read_bool();
+        SelectorCombinator::Combinator combinator = read_enum(SelectorCombinator::ADJACENT);
+        node = SASS_MEMORY_NEW(SelectorCombinator, pstate, combinator, line_break);
+        break;
+      }
+
+      case TAG_COMPOUND_SELECTOR: {
+        CompoundSelector* sel = SASS_MEMORY_NEW(CompoundSelector, pstate);
+        node = sel;
+        sel->hasPostLineBreak(read_bool());
+        sel->hasRealParent(read_bool());
+        read_elements<SimpleSelector>(sel);
+        break;
+      }
+
+      case TAG_COMPLEX_SELECTOR: {
+        ComplexSelector* sel = SASS_MEMORY_NEW(ComplexSelector, pstate);
+        node = sel;
+        sel->chroots(read_bool());
+        sel->hasPreLineFeed(read_bool());
+        read_elements<SelectorComponent>(sel);
+        break;
+      }
+
+      case TAG_SELECTOR_LIST: {
+        SelectorList* list = SASS_MEMORY_NEW(SelectorList, pstate);
+        node = list;
+        list->is_optional(read_bool());
+        read_elements<ComplexSelector>(list);
+        break;
+      }
+
+      case TAG_CSS_MEDIA_QUERY: {
+        CssMediaQuery* query = SASS_MEMORY_NEW(CssMediaQuery, pstate);
+        node = query;
+        query->modifier(read_string());
+        query->type(read_string());
+        query->features(read_strings());
+        break;
+      }
+
+      case TAG_PARAMETER: {
+        sass::string name(read_string());
+        ExpressionObj value(read_as<Expression>());
+        node = SASS_MEMORY_NEW(Parameter, pstate, name, value, read_bool());
+        break;
+      }
+
+      case TAG_PARAMETERS: {
+        // flags are not derived from the elements
+        Parameters* params = SASS_MEMORY_NEW(Parameters, pstate);
+        node = params;
+        params->has_optional_parameters(read_bool());
+        params->has_rest_parameter(read_bool());
+        read_elements<Parameter>(params);
+        break;
+      }
+
+      case TAG_SELECTOR_SCHEMA: {
+        String_Schema_Obj contents(read_as<String_Schema>());
+        Selector_Schema* schema = SASS_MEMORY_NEW(Selector_Schema, pstate, contents);
+        node = schema;
+        schema->connect_parent(read_bool());
+        break;
+      }
+
+      // import stubs are only valid in blocks
+      default:
+        malformed();
+
+    }
+
+    if (is_statement(tag)) {
+      Statement* statement = static_cast<Statement*>(node.ptr());
+      statement->statement_type(Statement::Type(type));
+      statement->tabs(tabs);
+      statement->group_end(group_end);
+    }
+    else if (is_expression(tag)) {
+      Expression* expression = static_cast<Expression*>(node.ptr());
+      expression->is_delayed(delayed);
+      expression->is_expanded(expanded);
+      expression->is_interpolant(interpolant);
+      expression->concrete_type(Expression::Type(type));
+    }
+
+    nodes[id] = node;
+    --depth;
+    return node;
+  }
+
+  SimpleSelectorObj Deserializer::read_simple(SimpleSelectorObj node)
+  {
+    node->ns(read_string());
+    node->name(read_string());
+    node->simple_type(read_enum(SimpleSelector::PLACEHOLDER_SEL));
+    node->has_ns(read_bool());
+    return node;
+  }
+
+  Block_Obj load_precompiled(Context& ctx, SourceFileObj source)
+  {
+    // unmapped once the tree and its imports are loaded
+    MappedBytes data;
+    if (!data.read(precompiled_path(source->getPath()))) return {};
+    Deserializer deserializer(ctx, source);
+    return deserializer.deserialize(data.data(), data.size());
+  }
+
+}
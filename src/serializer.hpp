@@ -0,0 +1,269 @@
+#ifndef SASS_SERIALIZER_H
+#define SASS_SERIALIZER_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <map>
+#include <cstdint>
+#include <unordered_map>
+#include "ast.hpp"
+#include "operation.hpp"
+#include "stylesheet.hpp"
+
+// Binary format for parsed stylesheets, so imported files can be
+// loaded by later compilations without running the parser. The
+// precompiled tree is stored next to its source file.
+//
+// All fixed size numbers are little-endian, counts, offsets and
+// enums are stored as varints. The header is followed by a table
+// of all strings and the nodes in pre-order. Every node starts
+// with its tag and source span (byte offsets into the source), so
+// nothing needs to be fixed up after reading. Nodes that appear
+// more than once in the tree are written once and referenced by
+// their index afterwards. Import stubs only store the requested
+// url, the files are resolved again when the tree is loaded.
+
+// Change this with every change of the format or the parsed tree
+#define SassPrecompiledFormat 1
+
+namespace Sass {
+
+  class Context;
+
+  class Serializer : public Operation_CRTP<void, Serializer> {
+
+    private:
+
+      // all spans must point into this source
+      const SourceData* source;
+      // file imports of the sheet in parse order
+      const sass::vector<CachedImport>& imports;
+      // next import to be matched with a stub
+      size_t next_import;
+      // start of the previous span
+      size_t last_position;
+      // the encoded nodes
+      sass::string nodes;
+      // strings in order of first use
+      sass::vector<sass::string> strings;
+      std::map<const sass::string, size_t> string_ids;
+      // index of every node already written
+      std::unordered_map<const AST_Node*, size_t> node_ids;
+
+    public:
+
+      Serializer(const SourceData* source, const sass::vector<CachedImport>& imports);
+
+      // Encode the complete file for the given tree
+      // Throws if the tree contains nodes we can't store
+      sass::string serialize(Block* root);
+
+      // statements
+      void operator()(Block*);
+      void operator()(StyleRule*);
+      void operator()(SupportsRule*);
+      void operator()(MediaRule*);
+      void operator()(CssMediaRule*);
+      void operator()(CssMediaQuery*);
+      void operator()(AtRootRule*);
+      void operator()(AtRule*);
+      void operator()(Keyframe_Rule*);
+      void operator()(Declaration*);
+      void operator()(Assignment*);
+      void operator()(Import*);
+      void operator()(Import_Stub*);
+      void operator()(WarningRule*);
+      void operator()(ErrorRule*);
+      void operator()(DebugRule*);
+      void operator()(Comment*);
+      void operator()(If*);
+      void operator()(ForRule*);
+      void operator()(EachRule*);
+      void operator()(WhileRule*);
+      void operator()(Return*);
+      void operator()(Content*);
+      void operator()(ExtendRule*);
+      void operator()(Definition*);
+      void operator()(Mixin_Call*);
+      // expressions
+      void operator()(Null*);
+      void operator()(List*);
+      void operator()(Map*);
+      void operator()(Binary_Expression*);
+      void operator()(Unary_Expression*);
+      void operator()(Function_Call*);
+      void operator()(Variable*);
+      void operator()(Number*);
+      void operator()(Color_RGBA*);
+      void operator()(Color_HSLA*);
+      void operator()(Boolean*);
+      void operator()(String_Schema*);
+      void operator()(String_Quoted*);
+      void operator()(String_Constant*);
+      void operator()(SupportsCondition*);
+      void operator()(SupportsOperation*);
+      void operator()(SupportsNegation*);
+      void operator()(SupportsDeclaration*);
+      void operator()(Supports_Interpolation*);
+      void operator()(Media_Query*);
+      void operator()(Media_Query_Expression*);
+      void operator()(At_Root_Query*);
+      void operator()(Parent_Reference*);
+      // parameters and arguments
+      void operator()(Parameter*);
+      void operator()(Parameters*);
+      void operator()(Argument*);
+      void operator()(Arguments*);
+      // selectors
+      void operator()(Selector_Schema*);
+      void operator()(PlaceholderSelector*);
+      void operator()(TypeSelector*);
+      void operator()(ClassSelector*);
+      void operator()(IDSelector*);
+      void operator()(AttributeSelector*);
+      void operator()(PseudoSelector*);
+      void operator()(SelectorCombinator*);
+      void operator()(CompoundSelector*);
+      void operator()(ComplexSelector*);
+      void operator()(SelectorList*);
+
+      // nodes that only exist after parsing
+      template <typename U>
+      void fallback(U x)
+      { throw std::runtime_error(std::string("can't serialize ") + typeid(*x).name()); }
+
+    private:
+
+      void write(AST_Node* node);
+      void write_size(size_t value);
+      void write_bool(bool value);
+      void write_double(double value);
+      void write_string(const sass::string& value);
+      void write_strings(const sass::vector<sass::string>& values);
+      void write_span(const SourceSpan& pstate);
+      void write_node(uint8_t tag, AST_Node* node);
+      void write_statement(uint8_t tag, Statement* node);
+      void write_expression(uint8_t tag, Expression* node);
+      void write_simple(uint8_t tag, SimpleSelector* node);
+
+      template <typename T>
+      void write_elements(const sass::vector<T>& elements)
+      {
+        write_size(elements.size());
+        for (const T& element : elements) write(element);
+      }
+
+  };
+
+  class Deserializer {
+
+    private:
+
+      Context& ctx;
+      Backtraces& traces;
+      // all spans point into this source
+      SourceFileObj source;
+      // the unread data
+      const char* position;
+      const char* end;
+      // the string table
+      sass::vector<std::pair<const char*, size_t>> strings;
+      // every node read so far by index
+      sass::vector<AST_Node_Obj> nodes;
+      // nesting of the current node
+      size_t depth;
+      // start of the previous span
+      size_t last_position;
+
+      // stub to add once the import is loaded
+      struct Pending {
+        Block_Obj block;
+        size_t index;
+        SourceSpan pstate;
+        size_t tabs;
+        bool group_end;
+        sass::string imp_path;
+        SourceSpan statement;
+      };
+      sass::vector<Pending> pending;
+
+    public:
+
+      Deserializer(Context& ctx, SourceFileObj source);
+
+      // Decode the tree and load its imports. Returns null if the
+      // data was not written for the current source and version,
+      // or is malformed (the source must be parsed in that case).
+      Block_Obj deserialize(const char* data, size_t size);
+
+    private:
+
+      Block_Obj read_tree();
+      AST_Node* read();
+      uint8_t read_byte();
+      uint32_t read_u32();
+      size_t read_size();
+      size_t read_count();
+      bool read_bool();
+      char read_char();
+      double read_double();
+      sass::string read_string();
+      sass::string read_string_data();
+      sass::vector<sass::string> read_strings();
+      SourceSpan read_span();
+      Block_Obj read_block(const SourceSpan& pstate);
+      SimpleSelectorObj read_simple(SimpleSelectorObj node);
+
+      // read an enum value up to the given one
+      template <typename E>
+      E read_enum(E last)
+      {
+        size_t value = read_size();
+        if (value > size_t(last)) malformed();
+        return E(value);
+      }
+
+      // read a node that must be of the given type
+      template <class T>
+      SharedImpl<T> read_as()
+      {
+        AST_Node* node = read();
+        if (node == nullptr) return {};
+        if (T* typed = dynamic_cast<T*>(node)) return typed;
+        malformed();
+        return {};
+      }
+
+      template <class T>
+      void read_elements(Vectorized<SharedImpl<T>>* node)
+      {
+        size_t count = read_count();
+        for (size_t i = 0; i < count; i++) {
+          node->elements().push_back(read_as<T>());
+        }
+      }
+
+      void malformed();
+
+  };
+
+  // Path of the precompiled tree for the given source file
+  sass::string precompiled_path(const sass::string& abs_path);
+
+  // Encode the tree of a parsed stylesheet into `data`
+  // Returns false if the tree contains nodes we can't store
+  bool serialize_sheet(const StyleSheet& sheet, sass::string& data);
+
+  // Store the tree of a parsed stylesheet next to its source
+  // Returns false if the tree or the file can't be written
+  bool write_precompiled(const StyleSheet& sheet);
+
+  // Load the tree stored next to the source if it is still
+  // valid, otherwise null is returned (see `Deserializer`)
+  Block_Obj load_precompiled(Context& ctx, SourceFileObj source);
+
+}
+
+#endif
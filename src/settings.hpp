@@ -16,4 +16,33 @@
 // The size of the memory pool arenas in bytes.
 #define SassAllocatorArenaSize (1024 * 256)
 
+// How many unused arenas we keep for reuse by default.
+// Can be changed at runtime via `sass_memory_set_arena_retention`.
+#define SassAllocatorRetainedArenas 32
+
+// Files smaller than this are read into memory, bigger ones are
+// memory mapped if enabled (see `sass_option_set_map_files`).
+#define SassMappedFileMinSize (1024 * 16)
+
+// Files modified within the last seconds are read into memory, since
+// an editor may still be writing (truncating a mapped file is fatal).
+#define SassMappedFileMinAge 2
+
+// Milliseconds to wait for more changes before a watcher
+// compiles again (editors often write files in steps).
+#define SassWatchSettleTime 20
+
+// Entries of an environment frame before a hash index
+// is added (smaller frames are scanned linearly).
+#define SassEnvIndexThreshold 16
+
+// Slots of the chunks that hold the entries of an environment
+// frame beyond the first few (a chunk is never moved or grown).
+#define SassEnvChunkSize 16
+
+// Selectors parsed from evaluated text that a compilation keeps
+// for reuse (see `Context::parse_selector`). Also the number of
+// hashes kept to find the texts that are seen a second time.
+#define SassSelectorCacheSize 1024
+
 #endif
@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include "source.hpp"
 #include "utf8/checked.h"
 #include "position.hpp"
+#include "scanner.hpp"
 
 namespace Sass {
 
@@ -13,35 +15,31 @@ namespace Sass {
 
   SourceFile::SourceFile(
     const char* path,
-    const char* data,
+    SourceBuffer&& data,
     size_t srcid) :
     SourceData(),
-    path(sass_copy_c_string(path)),
-    data(sass_copy_c_string(data)),
-    length(0),
+    path(path),
+    data(std::move(data)),
     srcid(srcid)
   {
-    length = strlen(data);
   }
 
   SourceFile::~SourceFile() {
-    sass_free_memory(path);
-    sass_free_memory(data);
   }
 
   const char* SourceFile::end() const
   {
-    return data + length;
+    return data.c_str() + data.size();
   }
 
   const char* SourceFile::begin() const
   {
-    return data;
+    return data.c_str();
   }
 
   const char* SourceFile::getRawData() const
   {
-    return data;
+    return data.c_str();
   }
 
   SourceSpan SourceFile::getSourceSpan()
@@ -49,9 +47,58 @@ namespace Sass {
     return SourceSpan(this);
   }
 
-  ItplFile::ItplFile(const char* data, const SourceSpan& pstate) :
+  bool SourceFile::hasBOM() const
+  {
+    return data.size() >= 3 && strncmp(data.c_str(), "\xEF\xBB\xBF", 3) == 0;
+  }
+
+  void SourceFile::buildLineIndex() const
+  {
+    const char* beg = data.c_str();
+    const char* end = beg + data.size();
+    lines.push_back(0);
+    for (const char* it = beg; it < end; ++it) {
+      // also stops at any null byte
+      it = Scanner::find_char(it, '\n', end);
+      if (*it == '\n') lines.push_back(it - beg + 1);
+    }
+  }
+
+  Offset SourceFile::getLineColumn(size_t pos) const
+  {
+    std::call_once(indexed, [this]() { buildLineIndex(); });
+    pos = std::min(pos, data.size());
+    // find the line containing the position
+    auto it = std::upper_bound(lines.begin(), lines.end(), pos);
+    size_t line = it - lines.begin() - 1;
+    const char* beg = data.c_str() + lines[line];
+    // the unicode BOM does not count as a column
+    if (line == 0 && pos >= 3 && hasBOM()) beg += 3;
+    // count columns up to the position
+    return Offset(line, 0).add(beg, data.c_str() + pos);
+  }
+
+  size_t SourceFile::getByteOffset(const Offset& pos) const
+  {
+    std::call_once(indexed, [this]() { buildLineIndex(); });
+    // clamp to the last line
+    size_t line = std::min(pos.line, lines.size() - 1);
+    const char* beg = data.c_str() + lines[line];
+    const char* end = line + 1 < lines.size()
+      ? data.c_str() + lines[line + 1] - 1
+      : data.c_str() + data.size();
+    // the unicode BOM does not count as a column
+    if (line == 0 && hasBOM()) beg += 3;
+    // skip columns (utf8 chars) up to the line end
+    for (size_t column = pos.column; column && beg < end; --column) {
+      do { ++beg; } while (beg < end && (*beg & 192) == 128);
+    }
+    return beg - data.c_str();
+  }
+
+  ItplFile::ItplFile(sass::string&& data, const SourceSpan& pstate) :
     SourceFile(pstate.getPath(),
-      data, pstate.getSrcId()),
+      std::move(data), pstate.getSrcId()),
     pstate(pstate)
   {}
 
@@ -64,6 +111,11 @@ namespace Sass {
   {
     return SourceSpan(pstate);
   }
+  const SourceData* ItplFile::getOrigin() const
+  {
+    return pstate.source ? pstate.source->getOrigin() : this;
+  }
+
 
 }
 
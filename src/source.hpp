@@ -1,6 +1,7 @@
 #ifndef SASS_SOURCE_H
 #define SASS_SOURCE_H
 
+#include <mutex>
 #include "sass.hpp"
 #include "memory.hpp"
 #include "position.hpp"
@@ -8,18 +9,54 @@
 
 namespace Sass {
 
+  // Bytes of a source file. Either owns a string or borrows
+  // a buffer that is guaranteed to outlive it (resources are
+  // kept alive by the context). Must be null terminated.
+  class SourceBuffer {
+  private:
+    // only used if we own the bytes
+    sass::string storage;
+    // null if we own the bytes
+    const char* bytes;
+    size_t length;
+  public:
+    // take ownership of the string
+    SourceBuffer(sass::string&& data) :
+      storage(std::move(data)),
+      bytes(nullptr),
+      length(0)
+    {}
+    // borrow buffer with known length
+    SourceBuffer(const char* data, size_t size) :
+      bytes(data),
+      length(size)
+    {}
+    const char* c_str() const {
+      return bytes ? bytes : storage.c_str();
+    }
+    size_t size() const {
+      return bytes ? length : storage.size();
+    }
+  };
+
   class SourceFile :
     public SourceData {
   protected:
-    char* path;
-    char* data;
-    size_t length;
+    sass::string path;
+    SourceBuffer data;
     size_t srcid;
+    // Byte offsets of all line starts
+    // Built once on first lookup
+    mutable sass::vector<size_t> lines;
+    mutable std::once_flag indexed;
+    void buildLineIndex() const;
+    // starts with a unicode BOM
+    bool hasBOM() const;
   public:
 
     SourceFile(
       const char* path,
-      const char* data,
+      SourceBuffer&& data,
       size_t srcid);
 
     ~SourceFile();
@@ -30,17 +67,20 @@ namespace Sass {
     virtual SourceSpan getSourceSpan() override;
 
     size_t size() const override final {
-      return length;
+      return data.size();
     }
 
     virtual const char* getPath() const override {
-      return path;
+      return path.c_str();
     }
 
     virtual size_t getSrcId() const override {
       return srcid;
     }
 
+    Offset getLineColumn(size_t pos) const override final;
+    size_t getByteOffset(const Offset& pos) const override final;
+
   };
 
   class SynthFile :
@@ -73,6 +113,14 @@ namespace Sass {
       return std::string::npos;
     }
 
+    Offset getLineColumn(size_t pos) const override final {
+      return Offset(0, 0);
+    }
+
+    size_t getByteOffset(const Offset& pos) const override final {
+      return 0;
+    }
+
   };
   
 
@@ -82,12 +130,12 @@ namespace Sass {
     SourceSpan pstate;
   public:
 
-    ItplFile(const char* data,
+    ItplFile(sass::string&& data,
       const SourceSpan& pstate);
 
-    // Offset getPosition() const override final;
     const char* getRawData() const override final;
     SourceSpan getSourceSpan() override final;
+    const SourceData* getOrigin() const override final;
   };
 
 }
@@ -6,6 +6,7 @@
 
 namespace Sass {
 
+  class Offset;
   class SourceSpan;
 
   class SourceData :
@@ -17,9 +18,14 @@ namespace Sass {
     virtual const char* end() const = 0;
     virtual const char* begin() const = 0;
     virtual const char* getPath() const = 0;
-    // virtual Offset getPosition() const = 0;
+    // Resolve byte offset to line and column
+    virtual Offset getLineColumn(size_t pos) const = 0;
+    // Resolve line and column to byte offset
+    virtual size_t getByteOffset(const Offset& pos) const = 0;
     virtual const char* getRawData() const = 0;
     virtual SourceSpan getSourceSpan() = 0;
+    // Source it was derived from (e.g. interpolated)
+    virtual const SourceData* getOrigin() const { return this; }
 
     sass::string to_string() const override {
       return sass::string{ begin(), end() };
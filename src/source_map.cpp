@@ -94,9 +94,10 @@ namespace Sass {
     for (size_t i = 0; i < mappings.size(); ++i) {
       const size_t generated_line = mappings[i].generated_position.line;
       const size_t generated_column = mappings[i].generated_position.column;
-      const size_t original_line = mappings[i].original_position.line;
-      const size_t original_column = mappings[i].original_position.column;
-      const size_t original_file = mappings[i].original_position.file;
+      const Offset original_position(mappings[i].original_position());
+      const size_t original_line = original_position.line;
+      const size_t original_column = original_position.column;
+      const size_t original_file = mappings[i].original_file;
 
       if (generated_line != previous_generated_line) {
         previous_generated_column = 0;
@@ -173,30 +174,30 @@ namespace Sass {
     current_position += offset;
   }
 
+  size_t SourceMap::source_id(const SourceSpan& span) const
+  {
+    if (!shared_ids.empty() && span.source) {
+      auto it = shared_ids.find(span.source->getOrigin());
+      if (it != shared_ids.end()) return it->second;
+    }
+    return span.getSrcId();
+  }
+
   void SourceMap::add_open_mapping(const AST_Node* node)
   {
     const SourceSpan& span(node->pstate());
-    Position from(span.getSrcId(), span.position);
-    mappings.push_back(Mapping(from, current_position));
+    const size_t srcid = source_id(span);
+    // synthetic nodes have no source
+    if (srcid == sass::string::npos) return;
+    mappings.push_back(Mapping(span.source, srcid, span.position, current_position));
   }
 
   void SourceMap::add_close_mapping(const AST_Node* node)
   {
     const SourceSpan& span(node->pstate());
-    Position to(span.getSrcId(), span.position + span.offset);
-    mappings.push_back(Mapping(to, current_position));
-  }
-
-  SourceSpan SourceMap::remap(const SourceSpan& pstate) {
-    for (size_t i = 0; i < mappings.size(); ++i) {
-      if (
-        mappings[i].generated_position.file == pstate.getSrcId() &&
-        mappings[i].generated_position.line == pstate.position.line &&
-        mappings[i].generated_position.column == pstate.position.column
-      ) return SourceSpan(pstate.source, mappings[i].original_position, pstate.offset);
-    }
-    return SourceSpan(pstate.source, Position(-1, -1, -1), Offset(0, 0));
-
+    const size_t srcid = source_id(span);
+    if (srcid == sass::string::npos) return;
+    mappings.push_back(Mapping(span.source, srcid, span.position + span.offset, current_position));
   }
 
 }
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "ast_fwd_decl.hpp"
 #include "base64vlq.hpp"
@@ -34,12 +35,16 @@ namespace Sass {
     void add_open_mapping(const AST_Node* node);
     void add_close_mapping(const AST_Node* node);
 
+    // indexes of sources shared with other compilations
+    // (their own index is from the one that read them)
+    std::unordered_map<const SourceData*, size_t> shared_ids;
+
     sass::string render_srcmap(Context &ctx);
-    SourceSpan remap(const SourceSpan& pstate);
 
   private:
 
     sass::string serialize_mappings();
+    size_t source_id(const SourceSpan& span) const;
 
     sass::vector<Mapping> mappings;
     Position current_position;
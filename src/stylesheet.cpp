@@ -7,16 +7,113 @@
 namespace Sass {
 
   // Constructor
-  Sass::StyleSheet::StyleSheet(const Resource& res, Block_Obj root) :
+  Sass::StyleSheet::StyleSheet(const Resource& res, SourceFileObj source,
+    Block_Obj root, sass::vector<CachedImport> imports) :
     Resource(res),
-    root(root)
+    source(source),
+    root(root),
+    imports(std::move(imports))
   {
   }
 
   StyleSheet::StyleSheet(const StyleSheet& sheet) :
     Resource(sheet),
-    root(sheet.root)
+    source(sheet.source),
+    root(sheet.root),
+    imports(sheet.imports)
   {
   }
 
+  CachedImport::CachedImport(const Importer& importer,
+    const sass::string& abs_path, const SourceSpan& pstate) :
+    importer(importer),
+    abs_path(abs_path),
+    pstate(pstate)
+  {
+  }
+
+  CachedStyleSheet::CachedStyleSheet(const FileStamp& stamp,
+    const StyleSheet& sheet, sass::string tree) :
+    stamp(stamp),
+    resource(sheet),
+    source(sheet.source),
+    root(tree.empty() ? sheet.root : Block_Obj()),
+    tree(std::move(tree)),
+    imports(sheet.imports),
+    user(nullptr)
+  {
+    // compilations must not free it
+    resource.cached = true;
+  }
+
+  CachedStyleSheet::~CachedStyleSheet()
+  {
+    // release nodes before their source
+    root = {}; imports.clear(); source = {};
+    resource.release();
+  }
+
+  sass::string CachedStyleSheet::to_string() const
+  {
+    return source->getPath();
+  }
+
+  CachedStyleSheet* StyleSheetCache::find(const sass::string& abs_path,
+    const FileStamp& stamp, const void* user)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sheets.find(abs_path);
+    if (it == sheets.end()) return nullptr;
+    CachedStyleSheet* sheet = it->second;
+    // only the user may touch it
+    if (sheet->user && sheet->user != user) return nullptr;
+    if (sheet->stamp == stamp) {
+      sheet->user = user;
+      return sheet;
+    }
+    // file has changed
+    if (sheet->user == nullptr) sheets.erase(it);
+    return nullptr;
+  }
+
+  void StyleSheetCache::insert(const sass::string& abs_path,
+    CachedStyleSheet* sheet, const void* user)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sheet->user = user;
+    CachedStyleSheetObj& cached(sheets[abs_path]);
+    if (cached && cached->user && cached->user != user) return;
+    cached = sheet;
+  }
+
+  void StyleSheetCache::release(sass::vector<CachedStyleSheetObj>& used)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (CachedStyleSheetObj& sheet : used) {
+      sheet->user = nullptr;
+    }
+    // drop our references while locked
+    used.clear();
+  }
+
+  void StyleSheetCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = sheets.begin(); it != sheets.end();) {
+      if (it->second->user) ++it;
+      else it = sheets.erase(it);
+    }
+  }
+
+  size_t StyleSheetCache::size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sheets.size();
+  }
+
+  CachedStyleSheets::~CachedStyleSheets()
+  {
+    if (cache) cache->release(sheets);
+  }
+
 }
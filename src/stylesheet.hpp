@@ -5,12 +5,31 @@
 // __EXTENSIONS__ fix on Solaris.
 #include "sass.hpp"
 
+#include <map>
+#include <mutex>
 #include "ast_fwd_decl.hpp"
 #include "extender.hpp"
+#include "source.hpp"
 #include "file.hpp"
 
 namespace Sass {
 
+  // file import done while parsing a stylesheet
+  // must resolve to the same file once reused
+  class CachedImport {
+    public:
+      // import as requested
+      Importer importer;
+      // resolved file path
+      sass::string abs_path;
+      // the import statement
+      SourceSpan pstate;
+    public:
+      CachedImport(const Importer& importer,
+        const sass::string& abs_path,
+        const SourceSpan& pstate);
+  };
+
   // parsed stylesheet from loaded resource
   // this should be a `Module` for sass 4.0
   class StyleSheet : public Resource {
@@ -38,20 +57,97 @@ namespace Sass {
       // [css]'s style rules in-place based on downstream extensions.
       // Extender extender;
 
+      // The module's source file.
+      SourceFileObj source;
+
       // The module's CSS tree.
       Block_Obj root;
 
+      // File imports in load order.
+      sass::vector<CachedImport> imports;
+
     public:
 
       // default argument constructor
-      StyleSheet(const Resource& res, Block_Obj root);
+      StyleSheet(const Resource& res, SourceFileObj source,
+        Block_Obj root, sass::vector<CachedImport> imports);
 
       // Copy constructor
       StyleSheet(const StyleSheet& res);
 
   };
 
+  // parsed stylesheet that can be shared between
+  // compilations, as long as the file is unchanged
+  class CachedStyleSheet : public SharedObj {
+    public:
+      // state of the file when it was read
+      FileStamp stamp;
+      // contents (owned by us)
+      Resource resource;
+      // referenced by all nodes
+      SourceFileObj source;
+      // the unevaluated tree (prefetched sheets, used once)
+      Block_Obj root;
+      // or the encoded tree (see `Serializer`) for sheets shared
+      // between compilations, each decodes a copy of its own since
+      // evaluation changes nodes in place
+      sass::string tree;
+      // file imports in load order
+      sass::vector<CachedImport> imports;
+      // compilation using it (guarded by the cache)
+      const void* user;
+    public:
+      CachedStyleSheet(const FileStamp& stamp,
+        const StyleSheet& sheet, sass::string tree = "");
+      ~CachedStyleSheet();
+      sass::string to_string() const override;
+  };
+
+  typedef SharedImpl<CachedStyleSheet> CachedStyleSheetObj;
+
+  // Parsed stylesheets by absolute path. The nodes of a cached tree
+  // reference its source, whose refcount is not thread safe, therefore
+  // a sheet is only used by one compilation at a time. Others parse the file on their own until it is given
+  // back. It is safe to use from many threads, but must outlive all
+  // compilations using it.
+  class StyleSheetCache {
+    private:
+      std::mutex mutex;
+      std::map<const sass::string, CachedStyleSheetObj> sheets;
+    public:
+      // get the sheet if the file is unchanged and no other
+      // compilation uses it (ours until given back)
+      CachedStyleSheet* find(const sass::string& abs_path,
+        const FileStamp& stamp, const void* user);
+      // add the sheet used by the compilation, replaces
+      // the sheet for the path unless used by another one
+      void insert(const sass::string& abs_path,
+        CachedStyleSheet* sheet, const void* user);
+      // give back (and drop) the sheets of a compilation
+      void release(sass::vector<CachedStyleSheetObj>& used);
+      // drop all sheets not used by a compilation
+      void clear();
+      // number of cached sheets
+      size_t size();
+  };
+
+  // Sheets a compilation took from a cache. They are given back once
+  // destroyed, so it must outlive all nodes of the compilation.
+  class CachedStyleSheets {
+    public:
+      StyleSheetCache* cache;
+      sass::vector<CachedStyleSheetObj> sheets;
+    public:
+      CachedStyleSheets(StyleSheetCache* cache)
+      : cache(cache), sheets()
+      { }
+      ~CachedStyleSheets();
+  };
 
 }
 
+// handle for the c api
+struct Sass_StyleSheet_Cache : Sass::StyleSheetCache {};
+
 #endif
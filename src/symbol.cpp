@@ -0,0 +1,52 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+#include "symbol.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace Sass {
+
+  // Table and lock are created on first use and never
+  // destroyed, so symbols stay valid during shutdown.
+  // Uses the standard allocator to stay out of regions.
+  typedef std::unordered_map<std::string, size_t> SymbolTable;
+
+  static std::mutex& symbolMutex()
+  {
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+  }
+
+  static SymbolTable& symbolTable()
+  {
+    static SymbolTable* table = new SymbolTable();
+    return *table;
+  }
+
+  const Symbol::Entry* Symbol::intern(const std::string& name)
+  {
+    if (name.empty()) return nullptr;
+    std::lock_guard<std::mutex> lock(symbolMutex());
+    SymbolTable& table = symbolTable();
+    // Nodes of unordered maps are stable across rehashes
+    auto it = table.emplace(name, table.size() + 1).first;
+    return &*it;
+  }
+
+  Symbol::Symbol(const char* name)
+  : entry(intern(name))
+  { }
+
+  Symbol::Symbol(const sass::string& name)
+  : entry(intern(std::string(name.c_str(), name.length())))
+  { }
+
+  size_t Symbol::count()
+  {
+    std::lock_guard<std::mutex> lock(symbolMutex());
+    return symbolTable().size();
+  }
+
+}
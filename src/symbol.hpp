@@ -0,0 +1,63 @@
+#ifndef SASS_SYMBOL_H
+#define SASS_SYMBOL_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <string>
+#include <utility>
+#include <functional>
+
+namespace Sass {
+
+  // ##########################################################################
+  // Interned identifier for variable, function and mixin names.
+  // All symbols with the same name share one entry of a process-wide
+  // (thread-safe) table, so they compare and hash in constant time.
+  // Entries are never freed and live outside of any memory region,
+  // therefore symbols can be freely passed between compilations.
+  // ##########################################################################
+  class Symbol {
+  public:
+    // Name and unique id of a symbol
+    typedef std::pair<const std::string, size_t> Entry;
+  private:
+    // Shared table entry (null for the empty symbol)
+    const Entry* entry;
+    // Get or create the entry for the given name
+    static const Entry* intern(const std::string& name);
+  public:
+    Symbol() : entry(nullptr) {}
+    // Interning takes a global lock, so keep symbols around
+    // instead of converting names on every lookup
+    explicit Symbol(const char* name);
+    explicit Symbol(const sass::string& name);
+    // Unique id, zero for the empty symbol
+    size_t id() const { return entry ? entry->second : 0; }
+    // Access to the interned name
+    const char* c_str() const { return entry ? entry->first.c_str() : ""; }
+    size_t length() const { return entry ? entry->first.length() : 0; }
+    bool empty() const { return entry == nullptr; }
+    sass::string to_string() const { return sass::string(c_str(), length()); }
+    // Ids are unique, so there is no need to look at the names
+    bool operator==(const Symbol& rhs) const { return entry == rhs.entry; }
+    bool operator!=(const Symbol& rhs) const { return entry != rhs.entry; }
+    bool operator<(const Symbol& rhs) const { return id() < rhs.id(); }
+    size_t hash() const { return id(); }
+    // Number of symbols interned so far
+    static size_t count();
+  };
+
+}
+
+namespace std {
+  template <> struct hash<Sass::Symbol> {
+    size_t operator()(const Sass::Symbol& symbol) const
+    {
+      return symbol.hash();
+    }
+  };
+}
+
+#endif
@@ -77,14 +77,11 @@ namespace Sass {
   {
     switch (sass_value_get_tag(val)) {
       case SASS_NUMBER:
-        return SASS_MEMORY_NEW(Number,
-                               SourceSpan("[C-VALUE]"),
-                               sass_number_get_value(val),
-                               sass_number_get_unit(val));
+        return make_number(SourceSpan("[C-VALUE]"),
+                           sass_number_get_value(val),
+                           sass_number_get_unit(val));
       case SASS_BOOLEAN:
-        return SASS_MEMORY_NEW(Boolean,
-                               SourceSpan("[C-VALUE]"),
-                               sass_boolean_get_value(val));
+        return immortal_boolean(sass_boolean_get_value(val));
       case SASS_COLOR:
         // ToDo: allow to also use HSLA colors!!
         return SASS_MEMORY_NEW(Color_RGBA,
@@ -123,7 +120,7 @@ namespace Sass {
         return m;
       }
       case SASS_NULL:
-        return SASS_MEMORY_NEW(Null, SourceSpan("[C-VALUE]"));
+        return immortal_null();
       case SASS_ERROR:
         return SASS_MEMORY_NEW(Custom_Error,
                                SourceSpan("[C-VALUE]"),
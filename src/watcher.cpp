@@ -0,0 +1,156 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#ifdef __linux__
+# include <unistd.h>
+# include <poll.h>
+# include <sys/inotify.h>
+#endif
+
+#include "watcher.hpp"
+#include "context.hpp"
+#include "sass_context.hpp"
+
+namespace Sass {
+
+  #ifdef __linux__
+    // changes of the directory entries and file contents
+    static const uint32_t watch_mask = IN_CLOSE_WRITE | IN_CREATE |
+      IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+  #endif
+
+  Watcher::Watcher(Sass_Watch_Options_Fn setup, Sass_Watch_Result_Fn deliver, void* cookie) :
+    setup(setup),
+    deliver(deliver),
+    cookie(cookie),
+    fd(-1)
+  {
+    #ifdef __linux__
+      fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    #endif
+  }
+
+  Watcher::~Watcher()
+  {
+    #ifdef __linux__
+      if (fd != -1) close(fd);
+    #endif
+  }
+
+  void Watcher::watch(const sass::string& dir)
+  {
+    #ifdef __linux__
+      if (!watched.insert(dir).second) return;
+      int wd = inotify_add_watch(fd, dir.c_str(), watch_mask);
+      // try again once it is created
+      if (wd == -1) watched.erase(dir);
+      else watches[wd] = dir;
+    #endif
+  }
+
+  void Watcher::add(const sass::string& input_path)
+  {
+    // the input may be created later
+    watch(File::dir_name(File::rel2abs(input_path)));
+    compile(input_path);
+  }
+
+  void Watcher::compile(const sass::string& input_path)
+  {
+    Sass_File_Context* file_ctx = sass_make_file_context(input_path.c_str());
+    Sass_Options* options = sass_file_context_get_options(file_ctx);
+    if (setup) setup(options, cookie);
+    sass_option_set_stylesheet_cache(options, &sheets);
+    sass_option_set_directory_cache(options, &dirs);
+    Sass_Compiler* compiler = sass_make_file_compiler(file_ctx);
+    sass_compiler_parse(compiler);
+    if (Context* ctx = compiler->cpp_ctx) {
+      // also the ones loaded before an error
+      std::set<sass::string> used = { File::dir_name(File::rel2abs(input_path)) };
+      for (const sass::string& path : ctx->included_files) {
+        used.insert(File::dir_name(path));
+      }
+      for (const sass::string& path : ctx->include_paths) {
+        sass::string dir(File::rel2abs(path));
+        if (dir.back() != '/') dir += '/';
+        used.insert(dir);
+      }
+      for (const sass::string& dir : used) watch(dir);
+      if (compiler->c_ctx->error_status == 0) {
+        graph.add(*ctx);
+        inputs[ctx->entry_path] = input_path;
+        failed.erase(input_path);
+      }
+      else {
+        failed[input_path] = std::move(used);
+      }
+    }
+    sass_compiler_execute(compiler);
+    sass_delete_compiler(compiler);
+    if (deliver) deliver(sass_file_context_get_context(file_ctx), cookie);
+    sass_delete_file_context(file_ctx);
+  }
+
+  int Watcher::poll(int timeout)
+  {
+    #ifdef __linux__
+      if (fd == -1) return -1;
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      int ready = ::poll(&pfd, 1, timeout);
+      if (ready <= 0) return ready;
+      sass::vector<sass::string> changed;
+      std::set<sass::string> changed_dirs;
+      bool overflow = false;
+      // editors often write a file in several steps
+      do {
+        alignas(struct inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+          for (char* ptr = buffer; ptr < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*) ptr;
+            ptr += sizeof(struct inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) overflow = true;
+            auto it = watches.find(event->wd);
+            if (it == watches.end()) continue;
+            sass::string path(it->second);
+            if (event->len) path += event->name;
+            dirs.invalidate(path);
+            changed.push_back(path);
+            changed_dirs.insert(it->second);
+            // the directory itself is gone
+            if (event->mask & IN_IGNORED) {
+              watched.erase(it->second);
+              watches.erase(it);
+            }
+          }
+        }
+      } while (::poll(&pfd, 1, SassWatchSettleTime) > 0);
+      std::set<sass::string> rebuild;
+      for (auto& input : failed) {
+        for (const sass::string& dir : input.second) {
+          // also if it could not be watched (yet)
+          if (overflow || changed_dirs.count(dir) || !watched.count(dir)) {
+            rebuild.insert(input.first);
+            break;
+          }
+        }
+      }
+      if (overflow) {
+        // we don't know what changed
+        dirs.clear();
+        for (auto& input : inputs) rebuild.insert(input.second);
+      }
+      for (const sass::string& entry : graph.find_affected(changed)) {
+        rebuild.insert(inputs.at(entry));
+      }
+      for (const sass::string& input_path : rebuild) {
+        compile(input_path);
+      }
+      return (int)rebuild.size();
+    #else
+      return -1;
+    #endif
+  }
+
+}
@@ -0,0 +1,82 @@
+#ifndef SASS_WATCHER_H
+#define SASS_WATCHER_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <map>
+#include <set>
+#include "sass/context.h"
+#include "file.hpp"
+#include "stylesheet.hpp"
+#include "dependencies.hpp"
+
+namespace Sass {
+
+  // Compiles entry points again whenever files they depend on change.
+  // Parsed imports, directory listings and the import graph are kept
+  // between compilations, so only the changed files are parsed again.
+  // The directories of all included files and the include paths are
+  // watched (via inotify, so this is only supported on Linux). Since
+  // created files are seen too, new partials that change what an
+  // import resolves to are picked up. Not safe to use from many threads.
+  class Watcher {
+
+    private:
+
+      // sets the options of every compilation
+      Sass_Watch_Options_Fn setup;
+      // receives the result of every compilation
+      Sass_Watch_Result_Fn deliver;
+      void* cookie;
+
+      // inotify instance (-1 if not supported)
+      int fd;
+      // watched directories by watch descriptor
+      std::map<int, sass::string> watches;
+      std::set<sass::string> watched;
+
+      // kept warm between the compilations
+      Sass_StyleSheet_Cache sheets;
+      Sass_Directory_Cache dirs;
+      Sass_Dependency_Graph graph;
+
+      // input path by entry path (see `Context::entry_path`)
+      std::map<const sass::string, sass::string> inputs;
+      // directories by input for the inputs that could not be
+      // parsed, their dependencies are not known, so they are
+      // compiled on every change in one of the directories
+      std::map<const sass::string, std::set<sass::string>> failed;
+
+    public:
+
+      Watcher(Sass_Watch_Options_Fn setup, Sass_Watch_Result_Fn deliver, void* cookie);
+      ~Watcher();
+
+      // false if watching is not supported
+      bool valid() const { return fd != -1; }
+
+      // Compile the input file and watch its dependencies
+      void add(const sass::string& input_path);
+
+      // Wait up to timeout milliseconds (forever if negative) for changes
+      // and compile the affected entry points. Returns the number of
+      // compilations or -1 on errors.
+      int poll(int timeout);
+
+    private:
+
+      void compile(const sass::string& input_path);
+      void watch(const sass::string& dir);
+
+  };
+
+}
+
+// handle for the c api
+struct Sass_Watcher : Sass::Watcher {
+  using Sass::Watcher::Watcher;
+};
+
+#endif
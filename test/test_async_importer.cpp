@@ -0,0 +1,178 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_async_importer");
+
+// Resolves the requested imports on its own thread, like the
+// thread pool of an embedder. Waits until `batch` requests are
+// queued (or a while), so imports requested at once are pending
+// at the same time.
+class Resolver {
+  std::mutex mutex;
+  std::condition_variable queued;
+  std::deque<std::pair<std::string, Sass_Pending_Import_Entry>> queue;
+  std::thread thread;
+  bool stopping;
+  size_t batch;
+ public:
+  // most requests pending at once
+  size_t most_pending;
+  // urls resolved so far
+  std::vector<std::string> resolved;
+
+  Resolver(size_t batch) : stopping(false), batch(batch), most_pending(0) {
+    thread = std::thread(&Resolver::work, this);
+  }
+  ~Resolver() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    queued.notify_all();
+    thread.join();
+  }
+  void request(const std::string& url, Sass_Pending_Import_Entry pending) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back({ url, pending });
+    if (queue.size() > most_pending) most_pending = queue.size();
+    queued.notify_all();
+  }
+  size_t count() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return resolved.size();
+  }
+ private:
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      queued.wait_for(lock, std::chrono::milliseconds(200),
+        [this] { return stopping || queue.size() >= batch; });
+      if (queue.empty()) {
+        if (stopping) return;
+        continue;
+      }
+      batch = 1;
+      std::string url(queue.front().first);
+      Sass_Pending_Import_Entry pending(queue.front().second);
+      queue.pop_front();
+      lock.unlock();
+      Sass_Import_List list = result(url);
+      lock.lock();
+      resolved.push_back(url);
+      // must not be used afterwards
+      sass_pending_import_resolve(pending, list);
+    }
+  }
+  static Sass_Import_List result(const std::string& url) {
+    // resolved to nothing, the file is loaded from disk
+    if (url == "skipped") return 0;
+    // still busy when the compilation fails
+    if (url == "slow") std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Sass_Import_List list = sass_make_import_list(1);
+    if (url == "broken") {
+      list[0] = sass_make_import_entry(url.c_str(), 0, 0);
+      sass_import_set_error(list[0], "can't load it", -1, -1);
+    }
+    else {
+      std::string source = "." + url + " { from: async; }\n";
+      list[0] = sass_make_import_entry(url.c_str(), sass_copy_c_string(source.c_str()), 0);
+    }
+    return list;
+  }
+};
+
+Sass_Pending_Import_Entry async_importer(const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* comp) {
+  // left to the next importer right away
+  if (std::string(url).compare(0, 4, "disk") == 0) return 0;
+  Resolver* resolver = static_cast<Resolver*>(sass_importer_get_cookie(cb));
+  Sass_Pending_Import_Entry pending = sass_make_pending_import();
+  resolver->request(url, pending);
+  return pending;
+}
+
+using Testing::Result;
+
+Result compile(const char* scss, Resolver& resolver) {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(scss));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  Sass_Importer_List importers = sass_make_importer_list(1);
+  sass_importer_set_list_entry(importers, 0, sass_make_async_importer(async_importer, 0, &resolver));
+  sass_option_set_c_importers(options, importers);
+  sass_option_set_include_path(options, dir.path().c_str());
+  sass_option_set_output_style(options, SASS_STYLE_COMPACT);
+  sass_compile_data_context(ctx);
+  Result result(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  return result;
+}
+
+bool TestResolvedFromOtherThread() {
+  Resolver resolver(1);
+  Result result = compile("@import 'a';\n.b { c: d; }\n", resolver);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == ".a { from: async; }\n\n.b { c: d; }\n");
+  ASSERT(resolver.count() == 1);
+  return true;
+}
+
+bool TestRequestedAtOnce() {
+  // the urls of consecutive statements, in order
+  Resolver resolver(3);
+  Result result = compile("@import 'a';\n@import 'b', 'c';\n.d { e: f; }\n@import 'g';\n", resolver);
+  ASSERT(result.status == 0);
+  ASSERT(result.css ==
+    ".a { from: async; }\n\n.b { from: async; }\n\n.c { from: async; }\n\n"
+    ".d { e: f; }\n\n.g { from: async; }\n");
+  ASSERT(resolver.most_pending == 3);
+  ASSERT(resolver.count() == 4);
+  ASSERT(resolver.resolved == std::vector<std::string>({ "a", "b", "c", "g" }));
+  return true;
+}
+
+bool TestSkipped() {
+  // a null pending import or a null list
+  Resolver resolver(1);
+  Result result = compile("@import 'disk';\n@import 'skipped';\n", resolver);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == ".disk { from: disk; }\n\n.skipped { from: disk; }\n");
+  ASSERT(resolver.count() == 1);
+  return true;
+}
+
+bool TestWaitsForUnneededAfterError() {
+  // `slow` is requested with the others, but never taken
+  Resolver resolver(3);
+  Result result = compile("@import 'a', 'broken', 'slow';\n", resolver);
+  ASSERT(result.status == 1);
+  ASSERT(result.message.find("can't load it") != std::string::npos);
+  // freed by the compiler once resolved
+  ASSERT(resolver.count() == 3);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  for (const std::string name : { "disk", "skipped" }) {
+    dir.write("_" + name + ".scss", "." + name + " { from: disk; }\n");
+  }
+
+  Testing::Tests tests;
+  TEST(TestResolvedFromOtherThread);
+  TEST(TestRequestedAtOnce);
+  TEST(TestSkipped);
+  TEST(TestWaitsForUnneededAfterError);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,169 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_dependencies");
+
+// Parses the entry point and records it in the graph
+bool add(struct Sass_Dependency_Graph* graph, const std::string& name) {
+  struct Sass_File_Context* ctx = sass_make_file_context(dir.path(name).c_str());
+  struct Sass_Compiler* compiler = sass_make_file_compiler(ctx);
+  sass_compiler_parse(compiler);
+  bool parsed = sass_context_get_error_status(sass_file_context_get_context(ctx)) == 0;
+  sass_dependency_graph_add_compiler(graph, compiler);
+  sass_delete_compiler(compiler);
+  sass_delete_file_context(ctx);
+  return parsed;
+}
+
+// Entry points (by name) affected by the changed files
+std::string affected(struct Sass_Dependency_Graph* graph, std::vector<std::string> changed) {
+  std::vector<const char*> paths;
+  for (std::string& path : changed) {
+    path = dir.path(path);
+    paths.push_back(path.c_str());
+  }
+  size_t count = sass_dependency_graph_find_affected(graph, paths.data(), paths.size());
+  std::string names;
+  for (size_t i = 0; i < count; ++i) {
+    if (i) names += " ";
+    names += std::string(sass_dependency_graph_get_affected(graph, i)).substr(dir.path().size() + 1);
+  }
+  return names;
+}
+
+struct Sass_Dependency_Graph* make_graph() {
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  if (!add(graph, "a.scss") || !add(graph, "b.scss") || !add(graph, "c.scss")) {
+    sass_delete_dependency_graph(graph);
+    return nullptr;
+  }
+  return graph;
+}
+
+bool TestImportEdges() {
+  struct Sass_File_Context* ctx = sass_make_file_context(dir.path("a.scss").c_str());
+  struct Sass_Compiler* compiler = sass_make_file_compiler(ctx);
+  sass_compiler_parse(compiler);
+  ASSERT(sass_compiler_get_import_edges_size(compiler) == 3);
+  // added once the imported file is loaded
+  Sass_Import_Edge_Entry edge = sass_compiler_get_import_edge(compiler, 0);
+  ASSERT(sass_import_edge_get_importer(edge) == dir.path("a.scss"));
+  ASSERT(sass_import_edge_get_imported(edge) == dir.path("_shared.scss"));
+  ASSERT(std::string(sass_import_edge_get_imp_path(edge)) == "shared");
+  // nested imports have the partial as importer
+  edge = sass_compiler_get_import_edge(compiler, 1);
+  ASSERT(sass_import_edge_get_importer(edge) == dir.path("_only_a.scss"));
+  ASSERT(sass_import_edge_get_imported(edge) == dir.path("_shared.scss"));
+  ASSERT(sass_import_edge_get_line(edge) == 1);
+  ASSERT(sass_import_edge_get_column(edge) == 1);
+  ASSERT(sass_import_edge_get_hash(edge) == sass_import_edge_get_hash(sass_compiler_get_import_edge(compiler, 0)));
+  // at the position of the import statement
+  edge = sass_compiler_get_import_edge(compiler, 2);
+  ASSERT(sass_import_edge_get_imported(edge) == dir.path("_only_a.scss"));
+  ASSERT(std::string(sass_import_edge_get_imp_path(edge)) == "only_a");
+  ASSERT(sass_import_edge_get_line(edge) == 2);
+  ASSERT(sass_import_edge_get_column(edge) == 1);
+  ASSERT(sass_import_edge_get_hash(edge) != sass_import_edge_get_hash(sass_compiler_get_import_edge(compiler, 0)));
+  sass_delete_compiler(compiler);
+  sass_delete_file_context(ctx);
+  return true;
+}
+
+bool TestChangedContents() {
+  struct Sass_Dependency_Graph* graph = make_graph();
+  ASSERT(graph != nullptr);
+  ASSERT(sass_dependency_graph_get_size(graph) == 3);
+  // saved without changes
+  dir.write("_shared.scss", ".s { s: s; }\n");
+  ASSERT(affected(graph, { "_shared.scss" }) == "");
+  dir.write("_shared.scss", ".s { s: t; }\n");
+  ASSERT(affected(graph, { "_shared.scss" }) == "a.scss b.scss");
+  dir.write("_only_a.scss", "@import 'shared';\n.o { o: p; }\n");
+  ASSERT(affected(graph, { "_only_a.scss" }) == "a.scss");
+  // entry points themselves and index files
+  dir.write("c.scss", ".c { c: d; }\n");
+  dir.write("lib/_index.scss", ".l { l: m; }\n");
+  ASSERT(affected(graph, { "c.scss", "lib/_index.scss" }) == "b.scss c.scss");
+  // recorded again with the new contents
+  ASSERT(add(graph, "a.scss"));
+  ASSERT(affected(graph, { "_shared.scss" }) == "b.scss");
+  sass_delete_dependency_graph(graph);
+  dir.write("_shared.scss", ".s { s: s; }\n");
+  dir.write("_only_a.scss", "@import 'shared';\n.o { o: o; }\n");
+  dir.write("c.scss", ".c { c: c; }\n");
+  dir.write("lib/_index.scss", ".l { l: l; }\n");
+  return true;
+}
+
+bool TestDeletedFile() {
+  struct Sass_Dependency_Graph* graph = make_graph();
+  ASSERT(graph != nullptr);
+  dir.remove("_only_a.scss");
+  ASSERT(affected(graph, { "_only_a.scss" }) == "a.scss");
+  dir.write("_only_a.scss", "@import 'shared';\n.o { o: o; }\n");
+  sass_delete_dependency_graph(graph);
+  return true;
+}
+
+bool TestCreatedFile() {
+  struct Sass_Dependency_Graph* graph = make_graph();
+  ASSERT(graph != nullptr);
+  // may resolve an import of the same name instead
+  dir.mkdir("other");
+  dir.write("other/shared.sass", ".x\n  y: z\n");
+  ASSERT(affected(graph, { "other/shared.sass" }) == "a.scss b.scss");
+  dir.write("lib.scss", ".x { y: z; }\n");
+  ASSERT(affected(graph, { "lib.scss" }) == "b.scss");
+  dir.write("_unrelated.scss", ".x { y: z; }\n");
+  ASSERT(affected(graph, { "_unrelated.scss" }) == "");
+  sass_delete_dependency_graph(graph);
+  return true;
+}
+
+bool TestRemoveEntry() {
+  struct Sass_Dependency_Graph* graph = make_graph();
+  ASSERT(graph != nullptr);
+  sass_dependency_graph_remove_entry(graph, dir.path("b.scss").c_str());
+  ASSERT(sass_dependency_graph_get_size(graph) == 2);
+  dir.remove("_shared.scss");
+  ASSERT(affected(graph, { "_shared.scss" }) == "a.scss");
+  dir.write("_shared.scss", ".s { s: s; }\n");
+  sass_delete_dependency_graph(graph);
+  return true;
+}
+
+bool TestFailedCompilationNotAdded() {
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  ASSERT(!add(graph, "broken.scss"));
+  ASSERT(sass_dependency_graph_get_size(graph) == 0);
+  sass_delete_dependency_graph(graph);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  dir.mkdir("lib");
+  dir.write("_shared.scss", ".s { s: s; }\n");
+  dir.write("_only_a.scss", "@import 'shared';\n.o { o: o; }\n");
+  dir.write("lib/_index.scss", ".l { l: l; }\n");
+  dir.write("a.scss", "// a\n@import 'shared',\n  'only_a';\n");
+  dir.write("b.scss", "@import 'shared', 'lib';\n");
+  dir.write("c.scss", ".c { c: c; }\n");
+  dir.write("broken.scss", "@import 'shared';\n.x {\n");
+
+  Testing::Tests tests;
+  TEST(TestImportEdges);
+  TEST(TestChangedContents);
+  TEST(TestDeletedFile);
+  TEST(TestCreatedFile);
+  TEST(TestRemoveEntry);
+  TEST(TestFailedCompilationNotAdded);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,140 @@
+#include "../src/file.hpp"
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_directory_cache");
+
+int compile(const std::string& name, struct Sass_Directory_Cache* cache) {
+  std::string path = dir.path(name);
+  struct Sass_File_Context* ctx = sass_make_file_context(path.c_str());
+  struct Sass_Options* options = sass_file_context_get_options(ctx);
+  sass_option_set_directory_cache(options, cache);
+  sass_compile_file_context(ctx);
+  int status = sass_context_get_error_status(sass_file_context_get_context(ctx));
+  sass_delete_file_context(ctx);
+  return status;
+}
+
+bool TestListsRegularFiles() {
+  Sass::DirectoryCache cache;
+  dir.write("a.scss", "");
+  dir.mkdir("sub");
+  symlink(dir.path("a.scss").c_str(), dir.path("link.scss").c_str());
+  ASSERT(cache.file_exists(dir.path("a.scss")));
+  ASSERT(cache.file_exists(dir.path("link.scss")));
+  // directories are not importable files
+  ASSERT(!cache.file_exists(dir.path("sub")));
+  ASSERT(!cache.file_exists(dir.path("b.scss")));
+  // all answered from one listing
+  ASSERT(cache.size() == 1);
+  ASSERT(!cache.file_exists(dir.path("sub/c.scss")));
+  ASSERT(cache.size() == 2);
+  dir.remove("link.scss");
+  dir.remove("a.scss");
+  dir.remove("sub");
+  return true;
+}
+
+bool TestInvalidateFile() {
+  Sass::DirectoryCache cache;
+  dir.write("a.scss", "");
+  ASSERT(cache.file_exists(dir.path("a.scss")));
+  ASSERT(!cache.file_exists(dir.path("b.scss")));
+  // kept until invalidated
+  dir.write("b.scss", "");
+  dir.remove("a.scss");
+  ASSERT(cache.file_exists(dir.path("a.scss")));
+  ASSERT(!cache.file_exists(dir.path("b.scss")));
+  // for any file of the directory
+  cache.invalidate(dir.path("b.scss"));
+  ASSERT(cache.size() == 0);
+  ASSERT(!cache.file_exists(dir.path("a.scss")));
+  ASSERT(cache.file_exists(dir.path("b.scss")));
+  dir.remove("b.scss");
+  return true;
+}
+
+bool TestInvalidateDirectory() {
+  Sass::DirectoryCache cache;
+  // a missing directory is cached as empty
+  ASSERT(!cache.file_exists(dir.path("sub/a.scss")));
+  ASSERT(!cache.file_exists(dir.path("other.scss")));
+  ASSERT(cache.size() == 2);
+  dir.mkdir("sub");
+  dir.write("sub/a.scss", "");
+  ASSERT(!cache.file_exists(dir.path("sub/a.scss")));
+  // forgets the directory and the one containing it
+  cache.invalidate(dir.path("sub"));
+  ASSERT(cache.size() == 0);
+  ASSERT(cache.file_exists(dir.path("sub/a.scss")));
+  // also with self references in the path
+  dir.write("sub/b.scss", "");
+  cache.invalidate(dir.path("./sub/./b.scss"));
+  ASSERT(cache.file_exists(dir.path("sub/b.scss")));
+  cache.clear();
+  ASSERT(cache.size() == 0);
+  dir.remove("sub/a.scss");
+  dir.remove("sub/b.scss");
+  dir.remove("sub");
+  return true;
+}
+
+bool TestSharedBetweenCompilations() {
+  struct Sass_Directory_Cache* cache = sass_make_directory_cache();
+  dir.write("main.scss", "@import 'partial';\n");
+  ASSERT(compile("main.scss", cache) != 0);
+  ASSERT(sass_directory_cache_get_size(cache) > 0);
+  // created after the listing was read
+  dir.write("_partial.scss", ".a { b: c; }\n");
+  ASSERT(compile("main.scss", cache) != 0);
+  ASSERT(compile("main.scss", nullptr) == 0);
+  sass_directory_cache_invalidate(cache, dir.path("_partial.scss").c_str());
+  ASSERT(compile("main.scss", cache) == 0);
+  // and removed again
+  dir.remove("_partial.scss");
+  sass_directory_cache_clear(cache);
+  ASSERT(sass_directory_cache_get_size(cache) == 0);
+  ASSERT(compile("main.scss", cache) != 0);
+  sass_delete_directory_cache(cache);
+  dir.remove("main.scss");
+  return true;
+}
+
+bool TestConcurrentProbes() {
+  Sass::DirectoryCache cache;
+  dir.write("a.scss", "");
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (size_t i = 0; i < failures.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t n = 0; n < 200; ++n) {
+        if (!cache.file_exists(dir.path("a.scss"))) ++failures[i];
+        if (cache.file_exists(dir.path("b.scss"))) ++failures[i];
+        if (n % 20 == i) cache.invalidate(dir.path("a.scss"));
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (int failed : failures) ASSERT(failed == 0);
+  dir.remove("a.scss");
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestListsRegularFiles);
+  TEST(TestInvalidateFile);
+  TEST(TestInvalidateDirectory);
+  TEST(TestSharedBetweenCompilations);
+  TEST(TestConcurrentProbes);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,117 @@
+#include "../src/ast.hpp"
+#include "../src/environment.hpp"
+#include "../src/settings.hpp"
+#include "testing.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+Sass::AST_Node_Obj value(const std::string& text) {
+  return SASS_MEMORY_NEW(Sass::String_Constant, Sass::SourceSpan("[test]"), text);
+}
+
+std::string text(const Sass::AST_Node_Obj& node) {
+  return node ? node->to_string() : "";
+}
+
+std::vector<Sass::Symbol> symbols(size_t count) {
+  std::vector<Sass::Symbol> keys;
+  for (size_t i = 0; i < count; ++i) {
+    keys.push_back(Sass::Symbol("$v" + std::to_string(i)));
+  }
+  return keys;
+}
+
+bool TestIndexThreshold() {
+  Sass::EnvSlots frame;
+  std::vector<Sass::Symbol> keys(symbols(SassEnvIndexThreshold * 4));
+  // scanned linearly before, found through the index afterwards
+  for (size_t i = 0; i < keys.size(); ++i) {
+    frame[keys[i]] = value(std::to_string(i));
+    for (size_t j = 0; j <= i; ++j) {
+      ASSERT(frame.find(keys[j]) == j);
+    }
+    ASSERT(frame.find(Sass::Symbol("$missing")) == std::string::npos);
+  }
+  ASSERT(frame.size() == keys.size());
+  size_t visited = 0;
+  for (auto& entry : frame) {
+    ASSERT(entry.first == keys[visited]);
+    ASSERT(text(entry.second) == std::to_string(visited));
+    ++visited;
+  }
+  ASSERT(visited == keys.size());
+  return true;
+}
+
+bool TestReferencesStayValid() {
+  Sass::EnvSlots frame;
+  std::vector<Sass::Symbol> keys(symbols(SassEnvIndexThreshold * 4));
+  Sass::AST_Node_Obj& first = frame[keys[0]];
+  Sass::EnvResult result(&frame, frame.find(keys[0]));
+  // e.g. while a function call adds entries
+  for (size_t i = 1; i < keys.size(); ++i) frame[keys[i]] = value("new");
+  first = value("first");
+  ASSERT(&result.value() == &first);
+  ASSERT(text(frame[keys[0]]) == "first");
+  return true;
+}
+
+bool TestDeletedSlotIsReused() {
+  Sass::EnvSlots frame;
+  std::vector<Sass::Symbol> keys(symbols(SassEnvIndexThreshold + 1));
+  for (const Sass::Symbol& key : keys) frame[key] = value("a");
+  // before and after the index was built
+  for (size_t i : { size_t(1), keys.size() - 1 }) {
+    size_t slot = frame.find(keys[i]);
+    frame.erase(keys[i]);
+    ASSERT(frame.find(keys[i]) == std::string::npos);
+    ASSERT(!frame.at(slot).used);
+    ASSERT(!frame.at(slot).second);
+    frame[keys[i]] = value("b");
+    ASSERT(frame.find(keys[i]) == slot);
+    ASSERT(text(frame.at(slot).second) == "b");
+  }
+  ASSERT(frame.size() == keys.size());
+  return true;
+}
+
+bool TestShadowsFrozenFrame() {
+  Sass::Symbol fn("fn[f]"), other("other[f]");
+  Sass::Env built_ins;
+  built_ins.set_local(fn, value("built-in"));
+  built_ins.set_local(other, value("other"));
+  built_ins.is_frozen(true);
+  // like the stack of a compilation (see `Context::compile`)
+  Sass::Env root(&built_ins);
+  Sass::Env global(&root);
+  Sass::Env local(&global);
+  // the frozen frame is no scope of the stack
+  ASSERT(!root.is_global());
+  ASSERT(global.is_global());
+  ASSERT(local.global_env() == &global);
+  ASSERT(text(local.get(fn)) == "built-in");
+  // a user definition shadows the built-in one
+  local.set_global(fn, value("user"));
+  ASSERT(text(local.get(fn)) == "user");
+  ASSERT(text(built_ins.get_local(fn)) == "built-in");
+  ASSERT(!local.has_lexical(fn));
+  // and the built-in one is found again once it is deleted
+  local.del_global(fn);
+  ASSERT(text(local.get(fn)) == "built-in");
+  ASSERT(text(local.get(other)) == "other");
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestIndexThreshold);
+  TEST(TestReferencesStayValid);
+  TEST(TestDeletedSlotIsReused);
+  TEST(TestShadowsFrozenFrame);
+  return tests.report(argv[0]);
+}
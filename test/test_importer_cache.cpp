@@ -0,0 +1,141 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace {
+
+Testing::TempDir dir("sass_importer_cache");
+// calls of the importer by url
+std::map<std::string, int> calls;
+
+// Returns different contents on every call, so a reused
+// result shows up as the contents of the first call
+Sass_Import_List importer(const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* comp) {
+  const std::string name(url);
+  const int call = ++calls[name];
+  Sass_Import_List list = sass_make_import_list(1);
+  if (name == "counted" || name == "uncached" || name == "versioned") {
+    // another path every time (a path is only parsed once anyway)
+    std::string path = name + "-" + std::to_string(call);
+    std::string source = ".c { " + name + ": " + std::to_string(call) + "; }\n";
+    list[0] = sass_make_import_entry(path.c_str(), sass_copy_c_string(source.c_str()), 0);
+    if (name == "counted") sass_import_set_cache_key(list[0], "counted", "1");
+    // changes with the third call
+    if (name == "versioned") sass_import_set_cache_key(list[0], "versioned", call < 3 ? "1" : "2");
+  }
+  else if (name == "file") {
+    // only a path, loaded by LibSass
+    std::string path = dir.path(call == 1 ? "first.scss" : "second.scss");
+    list[0] = sass_make_import_entry(path.c_str(), 0, 0);
+    sass_import_set_cache_key(list[0], "file", "1");
+  }
+  else if (name == "loop") {
+    list[0] = sass_make_import_entry(url, sass_copy_c_string("@import 'loop';\n"), 0);
+    sass_import_set_cache_key(list[0], "loop", "1");
+  }
+  else if (name == "failing") {
+    list[0] = sass_make_import_entry(url, 0, 0);
+    sass_import_set_error(list[0], "failed to load", -1, -1);
+    // same as an earlier result
+    sass_import_set_cache_key(list[0], "counted", "1");
+  }
+  else {
+    sass_delete_import_list(list);
+    return 0;
+  }
+  return list;
+}
+
+using Testing::Result;
+
+Result compile(const char* scss) {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(scss));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  Sass_Importer_List importers = sass_make_importer_list(1);
+  sass_importer_set_list_entry(importers, 0, sass_make_importer(importer, 0, 0));
+  sass_option_set_c_importers(options, importers);
+  sass_option_set_output_style(options, SASS_STYLE_COMPACT);
+  sass_compile_data_context(ctx);
+  Result result(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  calls.clear();
+  return result;
+}
+
+bool TestReusedWithinCompilation() {
+  Result result = compile("@import 'counted';\n@import 'counted';\n");
+  ASSERT(result.status == 0);
+  ASSERT(result.css == ".c { counted: 1; }\n\n.c { counted: 1; }\n");
+  return true;
+}
+
+bool TestNotReusedWithoutKey() {
+  Result result = compile("@import 'uncached';\n@import 'uncached';\n");
+  ASSERT(result.status == 0);
+  ASSERT(result.css == ".c { uncached: 1; }\n\n.c { uncached: 2; }\n");
+  return true;
+}
+
+bool TestNotReusedAcrossCompilations() {
+  ASSERT(compile("@import 'counted';\n").css == ".c { counted: 1; }\n");
+  ASSERT(compile("@import 'counted';\n").css == ".c { counted: 1; }\n");
+  return true;
+}
+
+bool TestVersionMismatch() {
+  // a new version replaces the cached result
+  Result result = compile(
+    "@import 'versioned';\n"
+    "@import 'versioned';\n"
+    "@import 'versioned';\n"
+    "@import 'versioned';\n");
+  ASSERT(result.status == 0);
+  ASSERT(result.css ==
+    ".c { versioned: 1; }\n\n.c { versioned: 1; }\n\n"
+    ".c { versioned: 3; }\n\n.c { versioned: 3; }\n");
+  return true;
+}
+
+bool TestFilePathReused() {
+  Result result = compile("@import 'file';\n@import 'file';\n");
+  ASSERT(result.status == 0);
+  // the second path is never loaded
+  ASSERT(result.css == ".first { f: 1; }\n\n.first { f: 1; }\n");
+  return true;
+}
+
+bool TestImportLoop() {
+  // only cached once parsed
+  Result result = compile("@import 'loop';\n");
+  ASSERT(result.status == 1);
+  ASSERT(result.message.find("An @import loop has been found") != std::string::npos);
+  return true;
+}
+
+bool TestErrorNotReplacedByCachedResult() {
+  Result result = compile("@import 'counted';\n@import 'failing';\n");
+  ASSERT(result.status == 1);
+  ASSERT(result.message.find("failed to load") != std::string::npos);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  dir.write("first.scss", ".first { f: 1; }\n");
+  dir.write("second.scss", ".second { f: 2; }\n");
+
+  Testing::Tests tests;
+  TEST(TestReusedWithinCompilation);
+  TEST(TestNotReusedWithoutKey);
+  TEST(TestNotReusedAcrossCompilations);
+  TEST(TestVersionMismatch);
+  TEST(TestFilePathReused);
+  TEST(TestImportLoop);
+  TEST(TestErrorNotReplacedByCachedResult);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,273 @@
+#include "../src/context.hpp"
+#include "../src/parser.hpp"
+#include "../src/sass_context.hpp"
+#include "testing.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+
+namespace {
+
+using Testing::Result;
+
+Testing::TempDir dir("sass_indented");
+
+Result compile(const std::string& sass) {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(sass.c_str()));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  sass_option_set_input_path(options, "input.sass");
+  sass_option_set_is_indented_syntax_src(options, true);
+  sass_compile_data_context(ctx);
+  Result result(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  return result;
+}
+
+// Input and expected output like the fixtures of sass-spec
+struct Fixture {
+  const char* sass;
+  const char* css;
+};
+
+bool check(const Fixture& fixture) {
+  Result result = compile(fixture.sass);
+  if (result.status != 0) std::cerr << result.message;
+  ASSERT(result.status == 0);
+  if (result.css != fixture.css) std::cerr << result.css;
+  ASSERT(result.css == fixture.css);
+  return true;
+}
+
+// A fixture that fails at the given position
+struct ErrorFixture {
+  const char* sass;
+  const char* message;
+  size_t line;
+  size_t column;
+};
+
+bool check(const ErrorFixture& fixture) {
+  Result result = compile(fixture.sass);
+  ASSERT(result.status == 1);
+  if (result.message.find(fixture.message) == std::string::npos) std::cerr << result.message;
+  ASSERT(result.message.find(fixture.message) != std::string::npos);
+  ASSERT(result.line == fixture.line);
+  ASSERT(result.column == fixture.column);
+  return true;
+}
+
+bool TestMixinShorthands() {
+  return check(Fixture{
+    "=m($x: 1px)\n"
+    "  a: $x\n"
+    "  @content\n"
+    ".a\n"
+    "  +m\n"
+    "  +m(2px)\n"
+    "    b: c\n",
+    ".a {\n  a: 1px;\n  a: 2px;\n  b: c; }\n" });
+}
+
+bool TestColonProperties() {
+  return check(Fixture{
+    ".a\n"
+    "  :color red\n"
+    "  :font\n"
+    "    size: 2px\n"
+    "    weight: bold\n"
+    "  :margin 1px\n"
+    "    top: 2px\n",
+    ".a {\n  color: red;\n  font-size: 2px;\n  font-weight: bold;\n"
+    "  margin: 1px;\n    margin-top: 2px; }\n" });
+}
+
+bool TestColonSelectors() {
+  // pseudo classes and values starting with a colon
+  return check(Fixture{
+    ".a\n"
+    "  :hover b\n"
+    "    c: d\n"
+    "  :e :f\n"
+    "    g: h\n"
+    "  &:focus\n"
+    "    i: j\n",
+    ".a :hover b {\n  c: d; }\n\n.a :e :f {\n  g: h; }\n\n"
+    ".a:focus {\n  i: j; }\n" });
+}
+
+bool TestCommaContinuedSelectors() {
+  return check(Fixture{
+    ".a,\n"
+    ".b,\n"
+    "// between the lines\n"
+    ".c\n"
+    "  d: e\n"
+    ".f,\n"
+    "  .g\n"
+    "    h: i\n",
+    ".a,\n.b,\n.c {\n  d: e; }\n\n.f .g {\n  h: i; }\n" });
+}
+
+bool TestMultiLineComments() {
+  return check(Fixture{
+    "/* one\n"
+    "   two\n"
+    ".a\n"
+    "  /* nested\n"
+    "     closed */\n"
+    "  b: c\n"
+    "// silent\n"
+    "   continued\n"
+    ".d\n"
+    "  e: f // trailing\n"
+    "  g: \"h // i\"\n",
+    "/* one\n   two */\n.a {\n  /* nested\n     closed */\n  b: c; }\n\n"
+    ".d {\n  e: f;\n  g: \"h // i\"; }\n" });
+}
+
+bool TestControlDirectives() {
+  return check(Fixture{
+    "@function f($n)\n"
+    "  @return $n * 2\n"
+    "@each $i in 1 2\n"
+    "  .i-#{$i}\n"
+    "    @if $i == 1\n"
+    "      w: f($i)\n"
+    "    // between\n"
+    "    @else\n"
+    "      w: 0\n"
+    "@media screen\n"
+    "  .m\n"
+    "    n: o\n",
+    ".i-1 {\n  w: 2; }\n\n.i-2 {\n  w: 0; }\n\n"
+    "@media screen {\n  .m {\n    n: o; } }\n" });
+}
+
+bool TestStaticValues() {
+  // kept as written like in scss
+  return check(Fixture{
+    ".a\n"
+    "  b: 1e3\n"
+    "  c: 0.50 !important\n",
+    ".a {\n  b: 1e3;\n  c: 0.50 !important; }\n" });
+}
+
+bool TestBraceBlocks() {
+  // a whole block in braces on the line, as in scss
+  return check(Fixture{
+    ".a { b: c; }\n"
+    ".d\n"
+    "  .e { f: g }\n"
+    "  h: i\n"
+    "@media print { .j { k: l } }\n",
+    ".a {\n  b: c; }\n\n.d {\n  h: i; }\n  .d .e {\n    f: g; }\n\n"
+    "@media print {\n  .j {\n    k: l; } }\n" });
+}
+
+bool TestErrorPositions() {
+  return check(ErrorFixture{
+      ".a\n  b: c\n  d: (1 +\n.e\n  f: g\n",
+      "Invalid CSS after \"  d: (1 +\"", 3, 10 })
+    && check(ErrorFixture{
+      ".a\n  +m(1px\n",
+      "Invalid CSS after \"  +m(1px\"", 2, 6 })
+    && check(ErrorFixture{
+      ".b\n  x: y\n.a\n  @extend .b\n    c: d\n",
+      "Illegal nesting: Nothing may be nested beneath this statement.", 5, 5 })
+    && check(ErrorFixture{
+      ".a\n  b: c\n  @if true\n    d: e\n   @else\n    f: g\n",
+      "@else must come after @if", 5, 4 })
+    && check(ErrorFixture{
+      "=m\n  a: b\n.c\n  +n\n",
+      "no mixin named n", 4, 4 });
+}
+
+bool TestErrorShowsWholeLine() {
+  // the excerpt is taken from the source after the error
+  Result result = compile(".a\n  b: c\n  d: (1 + 2 3;\n");
+  ASSERT(result.status == 1);
+  ASSERT(result.message.find(">>   d: (1 + 2 3;\n") != std::string::npos);
+  return true;
+}
+
+// The parser terminates every statement in its copy of the source
+// and must never write into the source itself, also if it fails.
+bool parses_to_same_source(const char* sass, bool& failed) {
+  struct Sass_Data_Context* data = sass_make_data_context(strdup(sass));
+  struct Sass_Compiler* compiler = sass_make_data_compiler(data);
+  Sass::SourceFileObj source = SASS_MEMORY_NEW(Sass::SourceFile, "input.sass",
+    Sass::SourceBuffer(std::string(sass)), 0);
+  failed = false;
+  try {
+    Sass::Parser parser(source, *compiler->cpp_ctx, compiler->cpp_ctx->traces);
+    parser.indented_syntax = true;
+    parser.parse();
+  }
+  catch (...) {
+    failed = true;
+  }
+  bool same = source->to_string() == sass;
+  source = {};
+  sass_delete_compiler(compiler);
+  sass_delete_data_context(data);
+  return same;
+}
+
+bool TestSourceRestored() {
+  bool failed;
+  ASSERT(parses_to_same_source(".a\n  b: c\n  d: e\n", failed));
+  ASSERT(!failed);
+  // fails in a statement, in a nested block and after a block
+  ASSERT(parses_to_same_source(".a\n  b: (c\n.d\n  e: f\n", failed));
+  ASSERT(failed);
+  ASSERT(parses_to_same_source(".a\n  .b\n    c: d e)\n  g: h\n", failed));
+  ASSERT(failed);
+  ASSERT(parses_to_same_source(".a\n  b: c\n.d\n  @extend .a\n    e: f\n", failed));
+  ASSERT(failed);
+  return true;
+}
+
+bool TestMappedFile() {
+  // big enough to be mapped read-only, the parser would crash if it
+  // wrote into it
+  std::string sass;
+  for (size_t i = 0; sass.size() < 64 * 1024 + 100; ++i) {
+    sass += ".a" + std::to_string(i) + "\n  b: c\n";
+  }
+  std::string path = dir.write("mapped.sass", sass);
+  // pretend it was written a minute ago
+  struct timeval times[2];
+  gettimeofday(&times[0], nullptr);
+  times[0].tv_sec -= 60;
+  times[1] = times[0];
+  utimes(path.c_str(), times);
+  struct Sass_File_Context* ctx = sass_make_file_context(path.c_str());
+  sass_option_set_map_files(sass_file_context_get_options(ctx), true);
+  sass_compile_file_context(ctx);
+  Result result(Testing::result_of(sass_file_context_get_context(ctx)));
+  sass_delete_file_context(ctx);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == compile(sass).css);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestMixinShorthands);
+  TEST(TestColonProperties);
+  TEST(TestColonSelectors);
+  TEST(TestCommaContinuedSelectors);
+  TEST(TestMultiLineComments);
+  TEST(TestControlDirectives);
+  TEST(TestStaticValues);
+  TEST(TestBraceBlocks);
+  TEST(TestErrorPositions);
+  TEST(TestErrorShowsWholeLine);
+  TEST(TestSourceRestored);
+  TEST(TestMappedFile);
+  return tests.report(argv[0]);
+}
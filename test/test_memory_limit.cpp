@@ -0,0 +1,76 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <cstring>
+#include <string>
+
+// Builds a list that needs a few megabytes
+const char* growing =
+  "@function grow($n) {\n"
+  "  $l: ();\n"
+  "  @for $i from 1 through $n {\n"
+  "    $l: append($l, $i * 1px);\n"
+  "  }\n"
+  "  @return $l;\n"
+  "}\n"
+  "a {\n"
+  "  b: length(grow(20000));\n"
+  "}\n";
+
+using Testing::Result;
+
+Result compile(const char* scss, size_t limit) {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(scss));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  sass_option_set_input_path(options, "input.scss");
+  sass_option_set_memory_limit(options, limit);
+  sass_compile_data_context(ctx);
+  Result result(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  return result;
+}
+
+bool TestUnlimited() {
+  Result result = compile(growing, 0);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == "a {\n  b: 20000; }\n");
+  return true;
+}
+
+bool TestLimitIsEnforced() {
+  Result result = compile(growing, 256 * 1024);
+  ASSERT(result.status == 1);
+  ASSERT(result.text == "Memory limit of 262144 bytes exceeded");
+  // points into the function with a backtrace to the call
+  ASSERT(result.line == 4);
+  ASSERT(result.column == 5);
+  ASSERT(result.message.find("on line 4:5 of input.scss, in function `grow`") != std::string::npos);
+  ASSERT(result.message.find("from line 9:13 of input.scss") != std::string::npos);
+  return true;
+}
+
+bool TestLimitAboveUsage() {
+  Result result = compile(growing, 256 * 1024 * 1024);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == "a {\n  b: 20000; }\n");
+  return true;
+}
+
+bool TestCompileAfterLimit() {
+  // the budget of a failed compilation must not leak into the next
+  ASSERT(compile(growing, 256 * 1024).status == 1);
+  Result result = compile("a { b: c; }", 256 * 1024);
+  ASSERT(result.status == 0);
+  ASSERT(result.css == "a {\n  b: c; }\n");
+  return true;
+}
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestUnlimited);
+  TEST(TestLimitIsEnforced);
+  TEST(TestLimitAboveUsage);
+  TEST(TestCompileAfterLimit);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,276 @@
+#include "../src/memory/allocator.hpp"
+#include "../src/memory/shared_ptr.hpp"
+#include "../src/memory/memory_pool.hpp"
+#include "testing.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestObj : public Sass::SharedObj {
+ public:
+  TestObj(bool *destroyed) : destroyed_(destroyed) {}
+  ~TestObj() { *destroyed_ = true; }
+  Sass::sass::string to_string() const { return "TestObj"; }
+ private:
+  bool *destroyed_;
+};
+
+using SharedTestObj = Sass::SharedImpl<TestObj>;
+
+bool TestOwnerOfSmallSlice() {
+  Sass::MemoryPool pool;
+  void* ptr = pool.allocate(24);
+  ASSERT(Sass::MemoryPool::getOwner(ptr) == &pool);
+  pool.deallocate(ptr);
+  return true;
+}
+
+bool TestOwnerOfLargeSlice() {
+  Sass::MemoryPool pool(true);
+  void* ptr = pool.allocate(SassAllocatorBuckets * SASS_MEM_ALIGN * 2);
+  ASSERT(Sass::MemoryPool::getOwner(ptr) == &pool);
+  pool.deallocate(ptr);
+  return true;
+}
+
+bool TestFreeListReuse() {
+  Sass::MemoryPool pool;
+  void* a = pool.allocate(32);
+  pool.deallocate(a);
+  void* b = pool.allocate(32);
+  ASSERT(a == b);
+  pool.deallocate(b);
+  return true;
+}
+
+bool TestRegionServesAllocations() {
+  Sass::MemoryRegion region(true);
+  void* ptr = nullptr;
+  {
+    Sass::MemoryRegionScope scope(&region);
+    ptr = Sass::allocateMem(16);
+  }
+  ASSERT(Sass::MemoryPool::getOwner(ptr)->isRegion());
+  Sass::deallocateMem(ptr);
+  return true;
+}
+
+bool TestSuspendedRegion() {
+  Sass::MemoryRegion region(true);
+  Sass::MemoryRegionScope scope(&region);
+  {
+    Sass::MemoryRegionScope suspend(nullptr);
+    void* ptr = Sass::allocateMem(16);
+    ASSERT(!Sass::MemoryPool::getOwner(ptr)->isRegion());
+    Sass::deallocateMem(ptr);
+  }
+  return true;
+}
+
+bool TestRegionSkipsDestructors() {
+  bool destroyed = false;
+  {
+    Sass::MemoryRegion region(true);
+    SharedTestObj obj;
+    {
+      Sass::MemoryRegionScope scope(&region);
+      obj = SASS_MEMORY_NEW(TestObj, &destroyed);
+    }
+    region.release();
+    obj = {};
+  }
+  ASSERT(!destroyed);
+  return true;
+}
+
+bool TestRegionDestroysBeforeRelease() {
+  bool destroyed = false;
+  Sass::MemoryRegion region(true);
+  {
+    Sass::MemoryRegionScope scope(&region);
+    SharedTestObj obj = SASS_MEMORY_NEW(TestObj, &destroyed);
+  }
+  ASSERT(destroyed);
+  return true;
+}
+
+bool TestPoolSurvivesZeroAllocations() {
+  void* a = Sass::allocateMem(16);
+  Sass::MemoryPool* owner = Sass::MemoryPool::getOwner(a);
+  Sass::deallocateMem(a);
+  void* b = Sass::allocateMem(16);
+  ASSERT(Sass::MemoryPool::getOwner(b) == owner);
+  ASSERT(a == b);
+  Sass::deallocateMem(b);
+  return true;
+}
+
+bool TestCrossThreadFree() {
+  std::vector<void*> slices;
+  Sass::MemoryPool* owner = nullptr;
+  std::thread producer([&]() {
+    for (size_t i = 0; i < 100; i++) {
+      slices.push_back(Sass::allocateMem(48));
+    }
+    owner = Sass::MemoryPool::getOwner(slices[0]);
+  });
+  producer.join();
+  ASSERT(owner != nullptr);
+  // Free on this thread, returned to the owner
+  for (void* ptr : slices) {
+    ASSERT(Sass::MemoryPool::getOwner(ptr) == owner);
+    Sass::deallocateMem(ptr);
+  }
+  // New thread adopts the orphaned pool and
+  // reuses the slices that were freed remotely
+  bool reused = false;
+  std::thread consumer([&]() {
+    void* ptr = Sass::allocateMem(48);
+    reused = Sass::MemoryPool::getOwner(ptr) == owner;
+    Sass::deallocateMem(ptr);
+  });
+  consumer.join();
+  ASSERT(reused);
+  return true;
+}
+
+bool TestConcurrentRemoteFrees() {
+  const size_t count = 10000;
+  std::vector<SharedTestObj> objs;
+  bool flags[count];
+  for (size_t i = 0; i < count; i++) {
+    flags[i] = false;
+    objs.push_back(SASS_MEMORY_NEW(TestObj, &flags[i]));
+  }
+  std::thread a([&]() { for (size_t i = 0; i < count; i += 2) objs[i] = {}; });
+  std::thread b([&]() { for (size_t i = 1; i < count; i += 2) objs[i] = {}; });
+  a.join(); b.join();
+  for (size_t i = 0; i < count; i++) {
+    ASSERT(flags[i]);
+  }
+  return true;
+}
+
+bool TestPoolStats() {
+  Sass::MemoryPool pool;
+  void* a = pool.allocate(32);
+  void* b = pool.allocate(32);
+  void* c = pool.allocate(SassAllocatorBuckets * SASS_MEM_ALIGN * 2);
+  pool.deallocate(a);
+  Sass::MemoryStats stats;
+  pool.collectStats(stats);
+  ASSERT(stats.arenas == 1);
+  ASSERT(stats.buckets.size() == 1);
+  ASSERT(stats.buckets[0].objects == 1);
+  ASSERT(stats.buckets[0].free == 1);
+  ASSERT(stats.buckets[0].size >= 32);
+  ASSERT(stats.largeObjects == 1);
+  ASSERT(stats.largeBytes >= SassAllocatorBuckets * SASS_MEM_ALIGN * 2);
+  ASSERT(stats.resident == SassAllocatorArenaSize + stats.largeBytes);
+  pool.deallocate(b);
+  pool.deallocate(c);
+  Sass::MemoryStats after;
+  pool.collectStats(after);
+  ASSERT(after.largeObjects == 0);
+  ASSERT(after.buckets[0].objects == 0);
+  ASSERT(after.peak == stats.resident);
+  return true;
+}
+
+bool TestRemoteFreeStats() {
+  Sass::MemoryPool pool;
+  void* a = pool.allocate(32);
+  void* b = pool.allocate(SassAllocatorBuckets * SASS_MEM_ALIGN * 2);
+  std::thread other([&]() {
+    pool.deallocateRemote(a);
+    pool.deallocateRemote(b);
+  });
+  other.join();
+  Sass::MemoryStats stats;
+  pool.collectStats(stats);
+  ASSERT(stats.largeObjects == 0);
+  // Only seen once collected
+  ASSERT(stats.buckets[0].objects == 1);
+  void* c = pool.allocate(32);
+  ASSERT(c == a);
+  pool.deallocate(c);
+  return true;
+}
+
+bool TestArenaRetention() {
+  Sass::setArenaRetention(4);
+  Sass::trimArenas();
+  void* first = nullptr;
+  {
+    Sass::MemoryPool pool;
+    first = pool.allocate(32);
+  }
+  ASSERT(Sass::retainedArenas() == 1);
+  {
+    // Next pool gets the same arena again
+    Sass::MemoryPool pool;
+    void* again = pool.allocate(32);
+    ASSERT(Sass::retainedArenas() == 0);
+    ASSERT(again == first);
+    ASSERT(Sass::MemoryPool::getOwner(again) == &pool);
+  }
+  ASSERT(Sass::trimArenas() == SassAllocatorArenaSize);
+  ASSERT(Sass::retainedArenas() == 0);
+  // Nothing is kept without retention
+  Sass::setArenaRetention(0);
+  { Sass::MemoryPool pool; pool.allocate(32); }
+  ASSERT(Sass::retainedArenas() == 0);
+  Sass::setArenaRetention(SassAllocatorRetainedArenas);
+  return true;
+}
+
+bool TestMemoryBudget() {
+  Sass::MemoryBudget budget(1024);
+  {
+    Sass::MemoryBudgetScope scope(&budget);
+    void* a = Sass::allocateMem(16);
+    ASSERT(budget.used == Sass::MemoryPool::sliceSize(a));
+    ASSERT(!budget.exceeded());
+    void* b = Sass::allocateMem(2048);
+    ASSERT(budget.used >= 2048);
+    ASSERT(budget.exceeded());
+    Sass::deallocateMem(b);
+    ASSERT(!budget.exceeded());
+    Sass::deallocateMem(a);
+    ASSERT(budget.used == 0);
+  }
+  // Nothing is charged outside the scope
+  void* c = Sass::allocateMem(16);
+  Sass::deallocateMem(c);
+  ASSERT(budget.used == 0);
+  // Unlimited budgets are never charged
+  Sass::MemoryBudget unlimited(0);
+  {
+    Sass::MemoryBudgetScope scope(&unlimited);
+    void* d = Sass::allocateMem(16);
+    ASSERT(unlimited.used == 0);
+    Sass::deallocateMem(d);
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestOwnerOfSmallSlice);
+  TEST(TestOwnerOfLargeSlice);
+  TEST(TestFreeListReuse);
+  TEST(TestRegionServesAllocations);
+  TEST(TestSuspendedRegion);
+  TEST(TestRegionSkipsDestructors);
+  TEST(TestRegionDestroysBeforeRelease);
+  TEST(TestPoolSurvivesZeroAllocations);
+  TEST(TestCrossThreadFree);
+  TEST(TestConcurrentRemoteFrees);
+  TEST(TestPoolStats);
+  TEST(TestRemoteFreeStats);
+  TEST(TestArenaRetention);
+  TEST(TestMemoryBudget);
+  return tests.report(argv[0]);
+}
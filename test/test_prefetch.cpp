@@ -0,0 +1,197 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_prefetch");
+
+struct Compiled : Testing::Result {
+  std::string file;
+  std::vector<std::string> included;
+  bool operator==(const Compiled& other) const {
+    return status == other.status && css == other.css && map == other.map &&
+      message == other.message && file == other.file && line == other.line &&
+      column == other.column && included == other.included;
+  }
+};
+
+Compiled compile(const std::string& name, size_t threads) {
+  std::string path = dir.path(name);
+  struct Sass_File_Context* ctx = sass_make_file_context(path.c_str());
+  struct Sass_Options* options = sass_file_context_get_options(ctx);
+  sass_option_set_output_path(options, (path + ".css").c_str());
+  sass_option_set_source_map_file(options, (path + ".css.map").c_str());
+  sass_option_set_omit_source_map_url(options, true);
+  sass_option_set_import_prefetch(options, threads);
+  sass_compile_file_context(ctx);
+  struct Sass_Context* c = sass_file_context_get_context(ctx);
+  Compiled result;
+  static_cast<Testing::Result&>(result) = Testing::result_of(c);
+  if (result.status != 0) result.file = sass_context_get_error_file(c);
+  char** included = sass_context_get_included_files(c);
+  for (size_t i = 0; included && included[i]; ++i) {
+    result.included.push_back(included[i]);
+  }
+  sass_delete_file_context(ctx);
+  return result;
+}
+
+// Compiles the file in order and with a few worker pools
+// and expects the same result every time, including the
+// order of the included files and the source map.
+bool same_as_sequential(const std::string& name, int status) {
+  Compiled expected = compile(name, 0);
+  ASSERT(expected.status == status);
+  for (size_t threads : { 1, 2, 4, 16 }) {
+    // the workers race with the compilation
+    for (size_t n = 0; n < 10; ++n) {
+      Compiled out = compile(name, threads);
+      ASSERT(out == expected);
+    }
+  }
+  return true;
+}
+
+bool TestSameAsSequential() {
+  Compiled out = compile("main.scss", 0);
+  ASSERT(out.status == 0);
+  // the entry, base with its two imports, the mixins
+  // and the partials (imported only once each)
+  ASSERT(out.included.size() == 5 + 20);
+  ASSERT(out.css.find("@import url(plain.css);") != std::string::npos);
+  return same_as_sequential("main.scss", 0);
+}
+
+bool TestRegistrationOrder() {
+  // the included files are sorted, but the sources of the
+  // map are in order: the imports of a partial come first
+  std::string sources = "\"sources\": [\n"
+    "\t\t\"main.scss\",\n"
+    "\t\t\"lib/_base.scss\",\n"
+    "\t\t\"lib/_colors.scss\",\n"
+    "\t\t\"_vars.scss\",\n"
+    "\t\t\"_mixins.sass\",\n";
+  for (size_t i = 0; i < 20; ++i) {
+    sources += "\t\t\"_p" + std::to_string(i) + ".scss\"";
+    sources += i < 19 ? ",\n" : "\n";
+  }
+  sources += "\t]";
+  for (size_t threads : { 0, 4 }) {
+    Compiled out = compile("main.scss", threads);
+    ASSERT(out.status == 0);
+    ASSERT(out.map.find(sources) != std::string::npos);
+  }
+  return true;
+}
+
+bool TestRetryOnWarning() {
+  std::stringstream warnings;
+  std::streambuf* stderr_buf = std::cerr.rdbuf(warnings.rdbuf());
+  bool same = same_as_sequential("warns.scss", 0);
+  std::cerr.rdbuf(stderr_buf);
+  ASSERT(same);
+  // reported in order by the compilation, never by a worker
+  const std::string warning = "WARNING on line 1, column 9 of ";
+  size_t count = 0;
+  for (size_t pos = 0; (pos = warnings.str().find(warning, pos)) != std::string::npos; ++pos) {
+    ++count;
+  }
+  ASSERT(count == 1 + 4 * 10);
+  return true;
+}
+
+bool TestRetryOnParseError() {
+  Compiled out = compile("breaks.scss", 4);
+  ASSERT(out.file == dir.path("_broken.scss"));
+  ASSERT(out.line == 3);
+  return same_as_sequential("breaks.scss", 1);
+}
+
+bool TestRetryOnAmbiguousImport() {
+  Compiled out = compile("ambiguous.scss", 4);
+  ASSERT(out.message.find("It's not clear which file to import") != std::string::npos);
+  return same_as_sequential("ambiguous.scss", 1);
+}
+
+bool TestRetryOnMissingImport() {
+  Compiled out = compile("missing.scss", 4);
+  ASSERT(out.message.find("File to import not found or unreadable: nope.") != std::string::npos);
+  return same_as_sequential("missing.scss", 1);
+}
+
+bool TestImportLoop() {
+  Compiled out = compile("loops.scss", 4);
+  ASSERT(out.message.find("An @import loop has been found") != std::string::npos);
+  return same_as_sequential("loops.scss", 1);
+}
+
+bool TestConcurrentCompilations() {
+  // every compilation has its own workers
+  Compiled expected = compile("main.scss", 0);
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (size_t i = 0; i < failures.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t n = 0; n < 10; ++n) {
+        if (!(compile("main.scss", 1 + (i + n) % 4) == expected)) {
+          ++failures[i];
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (int failed : failures) ASSERT(failed == 0);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  dir.mkdir("lib");
+  dir.write("_vars.scss", "$c: red;\n");
+  dir.write("lib/_colors.scss", "$b: blue;\n");
+  dir.write("lib/_base.scss", "@import 'colors';\n@import '../vars';\n.base { b: $b; c: $c; }\n");
+  dir.write("_mixins.sass", "=m($x)\n  m: $x\n");
+  std::string main = "@import 'lib/base', 'mixins';\n@import 'plain.css';\n";
+  for (size_t i = 0; i < 20; ++i) {
+    const std::string n = std::to_string(i);
+    // later partials import earlier ones again
+    dir.write("_p" + n + ".scss",
+      "@import 'lib/base', 'mixins';\n" +
+      (i ? "@import 'p" + std::to_string(i / 2) + "';\n" : "") +
+      ".p" + n + " { @include m(" + n + "px); c: $c; }\n");
+    main += "@import 'p" + n + "';\n";
+  }
+  dir.write("main.scss", main);
+  dir.write("_warn.scss", ".w { x: && y; }\n");
+  dir.write("warns.scss", "@import 'p1', 'warn', 'p2';\n");
+  dir.write("_broken.scss", "@import 'p3';\n.x {\n  y: (;\n}\n");
+  dir.write("breaks.scss", "@import 'p1';\n@import 'broken';\n");
+  dir.write("_amb.scss", ".a { a: a; }\n");
+  dir.write("amb.scss", ".a { a: b; }\n");
+  dir.write("_uses_amb.scss", "@import 'p1';\n@import 'amb';\n");
+  dir.write("ambiguous.scss", "@import 'p0', 'uses_amb';\n");
+  dir.write("_uses_missing.scss", "@import 'p4', 'nope';\n");
+  dir.write("missing.scss", "@import 'uses_missing';\n");
+  dir.write("_loop1.scss", "@import 'p5', 'loop2';\n");
+  dir.write("_loop2.scss", "@import 'loop1';\n");
+  dir.write("loops.scss", "@import 'loop1';\n");
+
+  Testing::Tests tests;
+  TEST(TestSameAsSequential);
+  TEST(TestRegistrationOrder);
+  TEST(TestRetryOnWarning);
+  TEST(TestRetryOnParseError);
+  TEST(TestRetryOnAmbiguousImport);
+  TEST(TestRetryOnMissingImport);
+  TEST(TestImportLoop);
+  TEST(TestConcurrentCompilations);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,100 @@
+#include "../src/file.hpp"
+#include "testing.hpp"
+
+#include <string>
+#include <sys/time.h>
+
+namespace {
+
+// Big enough to be mapped and not a multiple of the page size
+const size_t big = 64 * 1024 + 100;
+
+Testing::TempDir dir("sass_read_resource");
+
+std::string temp_file(const char* ext, size_t size, bool old) {
+  std::string path = dir.write(std::string("file") + ext, std::string(size, 'a'));
+  if (old) {
+    // pretend it was written a minute ago
+    struct timeval times[2];
+    gettimeofday(&times[0], nullptr);
+    times[0].tv_sec -= 60;
+    times[1] = times[0];
+    utimes(path.c_str(), times);
+  }
+  return path;
+}
+
+bool check(const char* ext, size_t size, bool old, bool map, bool mapped) {
+  std::string path = temp_file(ext, size, old);
+  Sass::Resource res(Sass::File::read_resource(path, map));
+  unlink(path.c_str());
+  ASSERT(res.contents != nullptr);
+  ASSERT(res.length == size);
+  ASSERT(res.mapped == mapped);
+  // the lexer relies on two null bytes after the contents
+  ASSERT(res.contents[size] == 0 && res.contents[size + 1] == 0);
+  ASSERT(res.contents[size - 1] == 'a');
+  res.release();
+  return true;
+}
+
+bool TestMapsSettledFiles() {
+  return check(".scss", big, true, true, true);
+}
+
+bool TestReadsRecentlyModifiedFiles() {
+  // an editor may still be writing it
+  return check(".scss", big, false, true, false);
+}
+
+bool TestReadsSmallFiles() {
+  return check(".scss", 100, true, true, false);
+}
+
+bool TestReadsWhenNotMapping() {
+  // e.g. kept by a stylesheet cache while files change
+  return check(".scss", big, true, false, false);
+}
+
+bool TestReadsByDefault() {
+  // mapping must be asked for
+  std::string path = temp_file(".scss", big, true);
+  Sass::Resource res(Sass::File::read_resource(path));
+  unlink(path.c_str());
+  ASSERT(res.contents != nullptr);
+  ASSERT(!res.mapped);
+  res.release();
+  return true;
+}
+
+bool TestMapsIndentedFiles() {
+  // the parser never writes into the contents
+  std::string path = temp_file(".sass", big, true);
+  Sass::Resource res(Sass::File::read_resource(path, true));
+  unlink(path.c_str());
+  ASSERT(res.mapped);
+  ASSERT(res.indented);
+  ASSERT(res.length == big);
+  res.release();
+  return true;
+}
+
+bool TestMissingFile() {
+  Sass::Resource res(Sass::File::read_resource(dir.path("missing.scss")));
+  ASSERT(res.contents == nullptr);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestMapsSettledFiles);
+  TEST(TestReadsRecentlyModifiedFiles);
+  TEST(TestReadsSmallFiles);
+  TEST(TestReadsWhenNotMapping);
+  TEST(TestReadsByDefault);
+  TEST(TestMapsIndentedFiles);
+  TEST(TestMissingFile);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,164 @@
+#include "../src/scanner.hpp"
+#include "testing.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Reference implementations
+const char* naive_skip_spaces(const char* src) {
+  while (*src && strchr(" \t\n\v\f\r", *src)) ++src;
+  return src;
+}
+
+const char* naive_find_any(const char* src, const char* chars) {
+  while (*src && !strchr(chars, *src)) ++src;
+  return src;
+}
+
+const char* naive_find_comment_end(const char* src) {
+  while (*src && !(src[0] == '*' && src[1] == '/')) ++src;
+  return src;
+}
+
+// Run the check at every alignment and length, with the
+// interesting char placed at every position of the buffer.
+// Buffers are exactly as big as needed, so any read past the
+// final null shows up with the address sanitizer.
+template <typename Check>
+bool each_placement(const char* fill, const char* mark, Check check) {
+  size_t fills = strlen(fill);
+  for (size_t offset = 0; offset < 64; offset++) {
+    for (size_t length = 0; length < 96; length++) {
+      for (size_t at = 0; at <= length; at++) {
+        std::vector<char> buffer(offset + length + 1);
+        char* src = buffer.data() + offset;
+        for (size_t i = 0; i < length; i++) {
+          src[i] = fill[i % fills];
+        }
+        if (at < length) memcpy(src + at, mark,
+          std::min(strlen(mark), length - at));
+        src[length] = 0;
+        if (!check(src, src + length)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compare the scanner with the reference when scanning to the
+// final null, up to an explicit end and inside a parser buffer
+template <typename Scan, typename Naive>
+bool matches(const char* src, const char* end, Scan scan, Naive naive) {
+  const char* expected = naive(src);
+  if (scan(src, nullptr) != expected) return false;
+  if (scan(src, end) != expected) return false;
+  Sass::Scanner::Buffer buffer(src, end);
+  return scan(src, nullptr) == expected;
+}
+
+}
+
+bool TestSkipSpaces() {
+  return each_placement(" \t\n\v\f\r", "x", [](const char* src, const char* end) {
+    return matches(src, end, Sass::Scanner::skip_spaces, naive_skip_spaces);
+  });
+}
+
+bool TestSkipSpacesBoundaries() {
+  // Bytes around the white-space range
+  ASSERT(*Sass::Scanner::skip_spaces("\t\x08") == '\x08');
+  ASSERT(*Sass::Scanner::skip_spaces("\r\x0e") == '\x0e');
+  ASSERT(*Sass::Scanner::skip_spaces("  !") == '!');
+  ASSERT(*Sass::Scanner::skip_spaces("  \x80") == '\x80');
+  ASSERT(*Sass::Scanner::skip_spaces("   ") == 0);
+  return true;
+}
+
+bool TestFindLineEnd() {
+  return each_placement("ab/ *", "\r", [](const char* src, const char* end) {
+    return matches(src, end, Sass::Scanner::find_line_end,
+      [](const char* src) { return naive_find_any(src, "\n\r\f"); });
+  });
+}
+
+bool TestFindCommentEnd() {
+  return each_placement("a* /", "*/", [](const char* src, const char* end) {
+    return matches(src, end, Sass::Scanner::find_comment_end, naive_find_comment_end);
+  });
+}
+
+bool TestFindChar() {
+  return each_placement("abc ", ")", [](const char* src, const char* end) {
+    return matches(src, end,
+      [](const char* src, const char* end) { return Sass::Scanner::find_char(src, ')', end); },
+      [](const char* src) { return naive_find_any(src, ")"); });
+  });
+}
+
+bool TestFindQuoteOrEscape() {
+  return each_placement("ab #", "\\", [](const char* src, const char* end) {
+    return matches(src, end, Sass::Scanner::find_quote_or_escape,
+      [](const char* src) { return naive_find_any(src, "\"'\\"); });
+  });
+}
+
+bool TestFindStringSpecial() {
+  ASSERT(*Sass::Scanner::find_string_special("ab\"c'", '\'') == '\'');
+  ASSERT(*Sass::Scanner::find_string_special("ab'c\"", '"') == '"');
+  ASSERT(*Sass::Scanner::find_string_special("a#{b}'", '\'') == '#');
+  ASSERT(*Sass::Scanner::find_string_special("a\\'b'", '\'') == '\\');
+  return each_placement("ab \"", "#", [](const char* src, const char* end) {
+    return matches(src, end,
+      [](const char* src, const char* end) { return Sass::Scanner::find_string_special(src, '\'', end); },
+      [](const char* src) { return naive_find_any(src, "'\\#"); });
+  });
+}
+
+bool TestStopsAtEnd() {
+  // nothing is found before the end
+  const char* src = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa)  \"*/";
+  for (size_t length = 0; length < 50; length++) {
+    const char* end = src + length;
+    ASSERT(Sass::Scanner::find_char(src, ')', end) == end);
+    ASSERT(Sass::Scanner::find_quote_or_escape(src, end) == end);
+    ASSERT(Sass::Scanner::find_comment_end(src, end) == end);
+    ASSERT(Sass::Scanner::skip_spaces(src + 51, src + 51 + length % 3) == src + 51 + length % 3);
+  }
+  // a comment end split by the end is not found either
+  ASSERT(Sass::Scanner::find_comment_end(src + 54, src + 55) == src + 55);
+  return true;
+}
+
+bool TestBufferScope() {
+  const char* src = "  x";
+  {
+    Sass::Scanner::Buffer outer(src, src + 3);
+    {
+      // nested parsers install their own buffer
+      Sass::Scanner::Buffer inner(src, src + 1);
+      ASSERT(Sass::Scanner::skip_spaces(src) == src + 1);
+    }
+    ASSERT(Sass::Scanner::skip_spaces(src) == src + 2);
+  }
+  // scans outside of any buffer go to the final null
+  ASSERT(Sass::Scanner::skip_spaces(src) == src + 2);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestSkipSpaces);
+  TEST(TestSkipSpacesBoundaries);
+  TEST(TestFindLineEnd);
+  TEST(TestFindCommentEnd);
+  TEST(TestFindChar);
+  TEST(TestFindQuoteOrEscape);
+  TEST(TestFindStringSpecial);
+  TEST(TestStopsAtEnd);
+  TEST(TestBufferScope);
+  return tests.report(argv[0]);
+}
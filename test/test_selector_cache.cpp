@@ -0,0 +1,134 @@
+#include "../src/context.hpp"
+#include "../src/sass_context.hpp"
+#include "testing.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Compiles the data and keeps the context around to look into it
+struct Compiled {
+  struct Sass_Data_Context* data;
+  struct Sass_Compiler* compiler;
+  std::string css;
+  std::string warnings;
+  Compiled(const char* scss) {
+    data = sass_make_data_context(strdup(scss));
+    compiler = sass_make_data_compiler(data);
+    // the parser prints its warnings right away
+    std::ostringstream err;
+    std::streambuf* cerr = std::cerr.rdbuf(err.rdbuf());
+    sass_compiler_parse(compiler);
+    sass_compiler_execute(compiler);
+    std::cerr.rdbuf(cerr);
+    warnings = err.str();
+    const char* output = sass_context_get_output_string(
+      sass_data_context_get_context(data));
+    if (output) css = output;
+  }
+  ~Compiled() {
+    sass_delete_compiler(compiler);
+    sass_delete_data_context(data);
+  }
+  Sass::Context& ctx() { return *compiler->cpp_ctx; }
+};
+
+size_t count(const std::string& text, const std::string& part) {
+  size_t found = 0;
+  for (size_t pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + 1)) {
+    ++found;
+  }
+  return found;
+}
+
+bool TestHitIsClone() {
+  Compiled compiled("");
+  Sass::Context& ctx(compiled.ctx());
+  Sass::SourceFileObj source = SASS_MEMORY_NEW(Sass::SourceFile, "input.scss",
+    Sass::SourceBuffer(std::string(".a .b, .c")), 0);
+  Sass::SourceSpan pstate(source);
+  Sass::SelectorListObj first = ctx.parse_selector(".a .b, .c", pstate, ctx.traces, false, false);
+  ASSERT(first->to_string() == ".a .b, .c");
+  // callers may change the selector and its children
+  first->at(0)->clear();
+  first->at(1)->append(first->at(1)->first());
+  Sass::SelectorListObj second = ctx.parse_selector(".a .b, .c", pstate, ctx.traces, false, false);
+  ASSERT(ctx.selectors.size() == 1);
+  ASSERT(second->to_string() == ".a .b, .c");
+  ASSERT(second->at(0).ptr() != first->at(0).ptr());
+  // and the copies don't share the cached nodes either
+  second->at(0)->clear();
+  Sass::SelectorListObj third = ctx.parse_selector(".a .b, .c", pstate, ctx.traces, false, false);
+  ASSERT(third->to_string() == ".a .b, .c");
+  return true;
+}
+
+bool TestSelectorFunctions() {
+  // the arguments are parsed through `get_arg_sels`, and the functions
+  // build their results from the parsed selectors
+  Compiled compiled(
+    "@mixin m {\n"
+    "  r: selector-replace('.a .b', '.b', '.c');\n"
+    "  e: selector-extend('.a .b', '.b', '.d');\n"
+    "  u: selector-unify('.a', '.b');\n"
+    "  s: is-superselector('.a', '.a.b');\n"
+    "}\n"
+    ".x { @include m; @include m; @include m; }\n");
+  ASSERT(!compiled.ctx().selectors.empty());
+  ASSERT(count(compiled.css, "r: .a .c;") == 3);
+  ASSERT(count(compiled.css, "e: .a .b, .a .d;") == 3);
+  ASSERT(count(compiled.css, "u: .a.b;") == 3);
+  ASSERT(count(compiled.css, "s: true;") == 3);
+  return true;
+}
+
+bool TestOnlyRepeatsAreCached() {
+  Compiled compiled(
+    "@for $i from 1 through 20 {\n"
+    "  .d#{$i} { x: y; }\n"
+    "}\n");
+  ASSERT(count(compiled.css, "x: y;") == 20);
+  ASSERT(compiled.ctx().selectors.empty());
+  return true;
+}
+
+bool TestBounded() {
+  Compiled compiled("");
+  Sass::Context& ctx(compiled.ctx());
+  Sass::SourceFileObj source = SASS_MEMORY_NEW(Sass::SourceFile, "input.scss",
+    Sass::SourceBuffer(std::string(".a")), 0);
+  Sass::SourceSpan pstate(source);
+  for (size_t i = 0; i < SassSelectorCacheSize + 10; i++) {
+    std::string text(".a" + std::to_string(i));
+    ctx.parse_selector(text.c_str(), pstate, ctx.traces, false, false);
+    ctx.parse_selector(text.c_str(), pstate, ctx.traces, false, false);
+  }
+  ASSERT(ctx.selectors.size() == SassSelectorCacheSize);
+  return true;
+}
+
+bool TestWarningsEveryTime() {
+  // an interpolation in the attribute value is parsed as a value
+  Compiled compiled(
+    "@mixin m { u: selector-unify(unquote('[x=\"#{\"#\"}{&& c}\"]'), '.d'); }\n"
+    ".x { @include m; @include m; @include m; }\n");
+  ASSERT(count(compiled.css, "u: [x=\"#{& & c}\"].d;") == 3);
+  ASSERT(count(compiled.warnings, "\"&&\" means two copies") == 3);
+  // only selectors parsed without warnings are kept
+  ASSERT(compiled.ctx().selectors.size() == 1);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestHitIsClone);
+  TEST(TestSelectorFunctions);
+  TEST(TestOnlyRepeatsAreCached);
+  TEST(TestBounded);
+  TEST(TestWarningsEveryTime);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,319 @@
+#include "../src/serializer.hpp"
+#include "../src/context.hpp"
+#include "../src/parser.hpp"
+#include "../src/sass_context.hpp"
+#include "../src/MurmurHash2.hpp"
+#include "testing.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Uses most kinds of nodes the parser creates
+const char* stylesheet =
+  "$map: (a: 1px, 'b': #fff, c: (1 2 3));\n"
+  "@function double($n, $args...) { @return $n * 2; }\n"
+  "@mixin box($w: 10px) {\n"
+  "  width: $w;\n"
+  "  @content;\n"
+  "}\n"
+  "%placeholder { color: rgba(0, 0, 0, .5); }\n"
+  "/* a comment */\n"
+  ".a > .b + .c ~ d, #id:hover::before, [lang|=\"en\"] {\n"
+  "  @extend %placeholder;\n"
+  "  @include box(double(2px)) { margin: -1px; }\n"
+  "  font: #{12px}/1.5 \"Helvetica\", sans-serif;\n"
+  "  &-suffix { x: not true and null or false; }\n"
+  "  @each $key, $value in $map { .#{$key} { v: $value; } }\n"
+  "  @for $i from 1 through 3 { .i-#{$i} { w: 10% * $i; } }\n"
+  "  $i: 0;\n"
+  "  @while $i < 2 { $i: $i + 1; }\n"
+  "  @if $i == 1 { y: 1; } @else if $i > 1 { y: 2; } @else { y: 3; }\n"
+  "}\n"
+  "@media screen and (min-width: 100px), print {\n"
+  "  .m { @at-root .r { z: url(foo.png); } }\n"
+  "}\n"
+  "@supports (display: grid) and (not (display: inline-grid)) {\n"
+  "  .s { display: grid; }\n"
+  "}\n"
+  "@keyframes spin { from { t: 0deg; } to { t: 360deg; } }\n"
+  "@font-face { font-family: x; }\n"
+  "@warn 'w'; @debug 'd';\n";
+
+// Parses the data without compiling it (which changes the tree)
+struct Parsed {
+  struct Sass_Data_Context* data;
+  struct Sass_Compiler* compiler;
+  Sass::SourceFileObj source;
+  Sass::Block_Obj root;
+  std::vector<Sass::CachedImport> imports;
+  bool failed;
+  Parsed(const char* scss) : failed(false) {
+    data = sass_make_data_context(strdup(scss));
+    compiler = sass_make_data_compiler(data);
+    source = SASS_MEMORY_NEW(Sass::SourceFile, "input.scss",
+      Sass::SourceBuffer(std::string(scss)), 0);
+    try {
+      Sass::Parser parser(source, ctx(), ctx().traces);
+      root = parser.parse();
+    }
+    catch (...) {
+      failed = true;
+    }
+  }
+  ~Parsed() {
+    root = {};
+    source = {};
+    sass_delete_compiler(compiler);
+    sass_delete_data_context(data);
+  }
+  Sass::Context& ctx() { return *compiler->cpp_ctx; }
+};
+
+std::string serialize(Parsed& parsed, Sass::Block* root) {
+  Sass::Serializer serializer(parsed.source.ptr(), parsed.imports);
+  return serializer.serialize(root);
+}
+
+Sass::Block_Obj deserialize(Parsed& parsed, const std::string& data) {
+  Sass::Deserializer deserializer(parsed.ctx(), parsed.source);
+  return deserializer.deserialize(data.data(), data.size());
+}
+
+size_t varint_size(size_t value) {
+  size_t size = 1;
+  while (value >= 0x80) { value >>= 7; ++size; }
+  return size;
+}
+
+// Offset of the data checksum (the string table and nodes follow it)
+size_t checksum_offset(size_t source_size) {
+  size_t version = strlen(libsass_version());
+  return 4 + 4 + varint_size(version) + version + varint_size(source_size) + 4;
+}
+
+void put_u32(std::string& data, size_t offset, uint32_t value) {
+  for (size_t i = 0; i < 4; i++) {
+    data[offset + i] = (char)((value >> (i * 8)) & 0xFF);
+  }
+}
+
+bool TestRoundTrip() {
+  Parsed parsed(stylesheet);
+  ASSERT(!parsed.failed);
+  std::string data = serialize(parsed, parsed.root);
+  Sass::Block_Obj root = deserialize(parsed, data);
+  ASSERT(!root.isNull());
+  // the same tree is written the same way again
+  ASSERT(serialize(parsed, root) == data);
+  return true;
+}
+
+bool TestFormatVersion() {
+  Parsed parsed(stylesheet);
+  std::string data = serialize(parsed, parsed.root);
+  ASSERT(data.compare(0, 4, "SASC") == 0);
+  ASSERT((uint8_t)data[4] == SassPrecompiledFormat);
+  // written by another version of the format
+  std::string other(data);
+  put_u32(other, 4, SassPrecompiledFormat + 1);
+  ASSERT(deserialize(parsed, other).isNull());
+  // or by another version of the library
+  other = data;
+  ++other[9];
+  ASSERT(deserialize(parsed, other).isNull());
+  ASSERT(!deserialize(parsed, data).isNull());
+  return true;
+}
+
+bool TestChangedSource() {
+  Parsed parsed("a { b: c; }");
+  std::string data = serialize(parsed, parsed.root);
+  // same size, but different contents
+  Parsed changed("a { b: d; }");
+  ASSERT(deserialize(changed, data).isNull());
+  ASSERT(!deserialize(parsed, data).isNull());
+  return true;
+}
+
+bool TestTruncated() {
+  Parsed parsed(stylesheet);
+  std::string data = serialize(parsed, parsed.root);
+  for (size_t size = 0; size < data.size(); size++) {
+    ASSERT(deserialize(parsed, data.substr(0, size)).isNull());
+  }
+  ASSERT(deserialize(parsed, data + '\0').isNull());
+  return true;
+}
+
+bool TestCorrupted() {
+  Parsed parsed(stylesheet);
+  std::string data = serialize(parsed, parsed.root);
+  // every changed byte is detected by the checksums
+  for (size_t i = 0; i < data.size(); i++) {
+    std::string corrupted(data);
+    corrupted[i] ^= 0x55;
+    ASSERT(deserialize(parsed, corrupted).isNull());
+  }
+  return true;
+}
+
+bool TestMalformed() {
+  Parsed parsed(stylesheet);
+  std::string data = serialize(parsed, parsed.root);
+  size_t offset = checksum_offset(parsed.source->size());
+  ASSERT(offset + 4 < data.size());
+  // data with a valid checksum must not crash the reader
+  // (it may still be a valid tree, e.g. for changed strings)
+  const uint8_t values[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+  for (size_t i = offset + 4; i < data.size(); i++) {
+    for (uint8_t value : values) {
+      std::string malformed(data);
+      malformed[i] = (char)value;
+      put_u32(malformed, offset, MurmurHash2(malformed.data() + offset + 4,
+        (int)(malformed.size() - offset - 4), 0x5A55C0DE));
+      deserialize(parsed, malformed);
+    }
+  }
+  return true;
+}
+
+// Files for the tests of the c api
+
+Testing::TempDir dir("sass_serializer");
+
+std::string path(const std::string& name) {
+  return dir.path(name);
+}
+
+std::string read_file(const std::string& name) {
+  std::string contents;
+  FILE* fd = std::fopen(path(name).c_str(), "rb");
+  if (fd == nullptr) return "missing";
+  char buffer[4096];
+  size_t read;
+  while ((read = std::fread(buffer, 1, sizeof(buffer), fd)) > 0) {
+    contents.append(buffer, read);
+  }
+  std::fclose(fd);
+  return contents;
+}
+
+using Compiled = Testing::Result;
+
+Compiled compile(const std::string& name, bool load) {
+  struct Sass_File_Context* ctx = sass_make_file_context(path(name).c_str());
+  struct Sass_Options* options = sass_file_context_get_options(ctx);
+  sass_option_set_source_map_file(options, path(name + ".map").c_str());
+  sass_option_set_omit_source_map_url(options, true);
+  sass_option_set_load_precompiled(options, load);
+  sass_compile_file_context(ctx);
+  Compiled result(Testing::result_of(sass_file_context_get_context(ctx)));
+  sass_delete_file_context(ctx);
+  return result;
+}
+
+Compiled precompile(const std::string& name, Sass_Importer_Fn importer = nullptr) {
+  struct Sass_File_Context* ctx = sass_make_file_context(path(name).c_str());
+  if (importer) {
+    Sass_Importer_List importers = sass_make_importer_list(1);
+    sass_importer_set_list_entry(importers, 0, sass_make_importer(importer, 0, 0));
+    sass_option_set_c_importers(sass_file_context_get_options(ctx), importers);
+  }
+  sass_precompile_file_context(ctx);
+  Compiled result(Testing::result_of(sass_file_context_get_context(ctx)));
+  sass_delete_file_context(ctx);
+  return result;
+}
+
+Sass_Import_List skip_import(const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* comp) {
+  return nullptr;
+}
+
+void setup_library() {
+  // big enough to be memory mapped
+  std::string rules;
+  for (size_t i = 0; i < 500; i++) {
+    rules += ".r-" + std::to_string(i) + " { @include m(" + std::to_string(i) + "px); }\n";
+  }
+  dir.write("_mixins.scss", "@mixin m($w) { width: $w; height: $w * 2; }\n");
+  dir.write("_rules.scss", rules);
+  dir.write("lib.scss", "@import 'mixins';\n.lib { a: b; }\n@import 'rules';\n");
+  dir.write("main.scss", "@import 'lib';\n.main { @include m(1px); }\n");
+}
+
+bool TestPrecompile() {
+  setup_library();
+  Compiled parsed = compile("main.scss", false);
+  ASSERT(parsed.status == 0);
+  ASSERT(precompile("lib.scss").status == 0);
+  // the entry is stored as well, it may be imported
+  ASSERT(read_file("lib.scssc").compare(0, 4, "SASC") == 0);
+  ASSERT(read_file("_mixins.scssc").compare(0, 4, "SASC") == 0);
+  ASSERT(read_file("_rules.scssc").size() > 16 * 1024);
+  ASSERT(read_file("main.scssc") == "missing");
+  // later compilations use them instead of parsing
+  std::string rules = read_file("_rules.scssc");
+  Compiled loaded = compile("main.scss", true);
+  ASSERT(loaded.status == 0);
+  ASSERT(loaded.css == parsed.css);
+  ASSERT(loaded.map == parsed.map);
+  ASSERT(read_file("_rules.scssc") == rules);
+  return true;
+}
+
+bool TestStaleSidecar() {
+  setup_library();
+  ASSERT(precompile("lib.scss").status == 0);
+  dir.write("_mixins.scss", "@mixin m($w) { width: $w + 1px; }\n");
+  Compiled loaded = compile("main.scss", true);
+  ASSERT(loaded.status == 0);
+  ASSERT(loaded.css == compile("main.scss", false).css);
+  ASSERT(loaded.css.find("width: 2px") != std::string::npos);
+  return true;
+}
+
+bool TestCorruptSidecar() {
+  setup_library();
+  ASSERT(precompile("lib.scss").status == 0);
+  std::string rules = read_file("_rules.scssc");
+  rules[rules.size() / 2] ^= 0x55;
+  dir.write("_rules.scssc", rules);
+  dir.write("_mixins.scssc", "SASC");
+  Compiled loaded = compile("main.scss", true);
+  ASSERT(loaded.status == 0);
+  ASSERT(loaded.css == compile("main.scss", false).css);
+  return true;
+}
+
+bool TestPrecompileErrors() {
+  dir.write("broken.scss", "@import 'mixins';\n.a { b: c;\n");
+  Compiled broken = precompile("broken.scss");
+  ASSERT(broken.status == 1);
+  ASSERT(broken.message.find("broken.scss") != std::string::npos);
+  ASSERT(read_file("broken.scssc") == "missing");
+  Compiled importer = precompile("lib.scss", skip_import);
+  ASSERT(importer.status != 0);
+  ASSERT(importer.message.find("custom importers") != std::string::npos);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestRoundTrip);
+  TEST(TestFormatVersion);
+  TEST(TestChangedSource);
+  TEST(TestTruncated);
+  TEST(TestCorrupted);
+  TEST(TestMalformed);
+  TEST(TestPrecompile);
+  TEST(TestStaleSidecar);
+  TEST(TestCorruptSidecar);
+  TEST(TestPrecompileErrors);
+  return tests.report(argv[0]);
+}
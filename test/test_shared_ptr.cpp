@@ -162,6 +162,105 @@ bool TestComparisonWithNullptr() {
   return true;
 }
 
+bool TestObjectCensus() {
+  bool destroyed = false;
+  Sass::ObjectCensus census;
+  SharedTestObj a, b;
+  {
+    Sass::ObjectCensus::Scope scope(&census);
+    a = SASS_MEMORY_NEW(TestObj, &destroyed);
+    b = SASS_MEMORY_NEW(TestObj, &destroyed);
+    SharedTestObj c = b;
+    Sass::SharedImpl<EmptyTestObj> d = new EmptyTestObj();
+  }
+  auto counts = census.counts();
+  ASSERT(counts.size() == 1);
+  ASSERT(counts[0].first == "TestObj");
+  ASSERT(counts[0].second == 2);
+  {
+    Sass::ObjectCensus::Scope scope(&census);
+    a = {};
+  }
+  counts = census.counts();
+  ASSERT(counts.size() == 1);
+  ASSERT(counts[0].second == 1);
+  return true;
+}
+
+bool TestObjectCensusOwner() {
+  bool destroyed = false;
+  Sass::ObjectCensus first, second;
+  SharedTestObj a, b, c;
+  {
+    Sass::ObjectCensus::Scope scope(&first);
+    a = SASS_MEMORY_NEW(TestObj, &destroyed);
+    b = SASS_MEMORY_NEW(TestObj, &destroyed);
+  }
+  {
+    // freed during another compilation
+    Sass::ObjectCensus::Scope scope(&second);
+    c = SASS_MEMORY_NEW(TestObj, &destroyed);
+    a = {};
+  }
+  ASSERT(first.counts()[0].second == 1);
+  ASSERT(second.counts()[0].second == 1);
+  // and outside of any
+  b = {};
+  ASSERT(first.counts().empty());
+  {
+    // outlives its census
+    Sass::ObjectCensus third;
+    Sass::ObjectCensus::Scope scope(&third);
+    a = SASS_MEMORY_NEW(TestObj, &destroyed);
+  }
+  a = {};
+  ASSERT(second.counts()[0].second == 1);
+  return true;
+}
+
+bool TestObjectCensusInactive() {
+  bool destroyed = false;
+  Sass::ObjectCensus census;
+  SharedTestObj a = SASS_MEMORY_NEW(TestObj, &destroyed);
+  ASSERT(census.counts().empty());
+  return true;
+}
+
+bool TestObjectCensusImmortal() {
+  bool destroyed = false;
+  Sass::ObjectCensus census;
+  TestObj* obj;
+  {
+    Sass::ObjectCensus::Scope scope(&census);
+    obj = SASS_MEMORY_NEW(TestObj, &destroyed);
+    ASSERT(census.counts().size() == 1);
+    // created on first use during a compilation
+    obj->makeImmortal();
+  }
+  ASSERT(census.counts().empty());
+  delete obj;
+  return true;
+}
+
+bool TestImmortal() {
+  bool destroyed = false;
+  TestObj* obj = new TestObj(&destroyed);
+  obj->makeImmortal();
+  Sass::ObjectCensus census;
+  {
+    Sass::ObjectCensus::Scope scope(&census);
+    SharedTestObj a = obj;
+    SharedTestObj b = a;
+    a.detach();
+    ASSERT(a->to_string() == "refcount=0 destroyed=0");
+  }
+  ASSERT(!destroyed);
+  ASSERT(census.counts().empty());
+  delete obj;
+  ASSERT(destroyed);
+  return true;
+}
+
 #define TEST(fn) \
   if (fn()) { \
     passed.push_back(#fn); \
@@ -184,6 +283,11 @@ int main(int argc, char **argv) {
   TEST(TestDetachNull);
   TEST(TestComparisonWithSharedPtr);
   TEST(TestComparisonWithNullptr);
+  TEST(TestObjectCensus);
+  TEST(TestObjectCensusOwner);
+  TEST(TestObjectCensusInactive);
+  TEST(TestObjectCensusImmortal);
+  TEST(TestImmortal);
   std::cerr << argv[0] << ": Passed: " << passed.size()
             << ", failed: " << failed.size()
             << "." << std::endl;
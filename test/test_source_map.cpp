@@ -0,0 +1,247 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <cstring>
+#include <string>
+
+using Compiled = Testing::Result;
+
+Compiled compile(const char* scss, bool indented = false) {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(scss));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  sass_option_set_input_path(options, indented ? "input.sass" : "input.scss");
+  sass_option_set_is_indented_syntax_src(options, indented);
+  sass_option_set_output_path(options, "input.css");
+  sass_option_set_source_map_file(options, "input.css.map");
+  sass_option_set_omit_source_map_url(options, true);
+  sass_compile_data_context(ctx);
+  Compiled result(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  return result;
+}
+
+int vlq(const char*& p) {
+  static const std::string digits =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  int result = 0, shift = 0, digit = 0;
+  do {
+    digit = (int)digits.find(*p++);
+    result += (digit & 31) << shift;
+    shift += 5;
+  } while (digit & 32);
+  return result & 1 ? -(result >> 1) : result >> 1;
+}
+
+// Source position "line:column" (zero based) of the segment that
+// starts at the given generated position, or "" if there is none.
+std::string mapped(const Compiled& out, size_t line, size_t column) {
+  size_t start = out.map.find("\"mappings\": \"");
+  if (start == std::string::npos) return "";
+  const char* p = out.map.c_str() + start + 13;
+  size_t gen_line = 0;
+  int gen_col = 0, src_line = 0, src_col = 0;
+  while (*p && *p != '"') {
+    if (*p == ';') { ++gen_line; gen_col = 0; ++p; continue; }
+    if (*p == ',') { ++p; continue; }
+    gen_col += vlq(p);
+    if (*p && *p != ',' && *p != ';' && *p != '"') {
+      vlq(p);
+      src_line += vlq(p);
+      src_col += vlq(p);
+    }
+    if (gen_line == line && gen_col == (int)column) {
+      return std::to_string(src_line) + ":" + std::to_string(src_col);
+    }
+  }
+  return "";
+}
+
+// Generated position of the first occurrence of needle
+bool find(const Compiled& out, const char* needle, size_t& line, size_t& column) {
+  size_t pos = out.css.find(needle);
+  if (pos == std::string::npos) return false;
+  line = 0;
+  size_t bol = 0;
+  for (size_t i = 0; i < pos; i++) {
+    if (out.css[i] == '\n') { ++line; bol = i + 1; }
+  }
+  column = pos - bol;
+  return true;
+}
+
+std::string mapped(const Compiled& out, const char* needle) {
+  size_t line, column;
+  if (!find(out, needle, line, column)) return "not in output";
+  return mapped(out, line, column);
+}
+
+// Same as above, but for the position after the needle
+std::string mapped_end(const Compiled& out, const char* needle) {
+  size_t line, column;
+  if (!find(out, needle, line, column)) return "not in output";
+  return mapped(out, line, column + strlen(needle));
+}
+
+bool TestImmortalDeclarationValue() {
+  Compiled out = compile(
+    "a {\n"
+    "  b: 1 == 1;\n"
+    "}\n");
+  ASSERT(out.css == "a {\n  b: true; }\n");
+  ASSERT(mapped(out, "true") == "1:5");
+  return true;
+}
+
+bool TestImmortalListItems() {
+  Compiled out = compile(
+    "@function f() {\n"
+    "  @return 1 == 1;\n"
+    "}\n"
+    "$t: 2 > 1;\n"
+    "a {\n"
+    "  b: x f() y;\n"
+    "  c: x $t;\n"
+    "  d: length(a b) x;\n"
+    "}\n");
+  ASSERT(out.css == "a {\n  b: x true y;\n  c: x true;\n  d: 2 x; }\n");
+  // mapped to the expression that produced them
+  ASSERT(mapped(out, "true y") == "5:7");
+  ASSERT(mapped(out, "true;") == "6:7");
+  ASSERT(mapped(out, "2 x") == "7:5");
+  return true;
+}
+
+bool TestImmortalLoopVariable() {
+  Compiled out = compile(
+    "@for $i from 1 through 1 {\n"
+    "  .i { w: $i; }\n"
+    "}\n");
+  ASSERT(out.css == ".i {\n  w: 1; }\n");
+  ASSERT(mapped(out, "1;") == "1:10");
+  return true;
+}
+
+bool TestClosingBrace() {
+  Compiled out = compile(
+    ".a { b: c; }\n"
+    ".d {\n"
+    "  e: f;\n"
+    "}\n");
+  ASSERT(out.css == ".a {\n  b: c; }\n\n.d {\n  e: f; }\n");
+  // right after the brace, not one column behind
+  ASSERT(mapped_end(out, "b: c; }") == "0:12");
+  ASSERT(mapped_end(out, "e: f; }") == "3:1");
+  return true;
+}
+
+bool TestAfterSelectorInterpolation() {
+  Compiled out = compile(
+    ".x#{\".y\"}.z { q: r; }\n");
+  ASSERT(out.css == ".x.y.z {\n  q: r; }\n");
+  // the rest of the line is not shifted by the interpolation
+  ASSERT(mapped(out, ".x.y.z") == "0:0");
+  ASSERT(mapped(out, "{") == "0:12");
+  ASSERT(mapped(out, "q:") == "0:14");
+  ASSERT(mapped(out, "r;") == "0:17");
+  return true;
+}
+
+bool TestInterpolatedString() {
+  Compiled out = compile(
+    "$n: 0;\n"
+    "a { h: \"x#{1}y\"; i: #{$n}#{$n}; j: k; }\n");
+  ASSERT(out.css == "a {\n  h: \"x1y\";\n  i: 00;\n  j: k; }\n");
+  // spans cover the whole string and nothing after it
+  ASSERT(mapped(out, "\"x1y\"") == "1:7");
+  ASSERT(mapped_end(out, "\"x1y\"") == "1:15");
+  ASSERT(mapped(out, "00") == "1:20");
+  ASSERT(mapped_end(out, "00") == "1:30");
+  ASSERT(mapped(out, "j:") == "1:32");
+  ASSERT(mapped(out, "k;") == "1:35");
+  return true;
+}
+
+bool TestMultiLine() {
+  Compiled out = compile(
+    ".a,\n"
+    ".b\n"
+    "{\n"
+    "  color:\n"
+    "    red;\n"
+    "}\n");
+  ASSERT(out.css == ".a,\n.b {\n  color: red; }\n");
+  ASSERT(mapped(out, ".a") == "0:0");
+  ASSERT(mapped(out, ".b") == "1:0");
+  ASSERT(mapped(out, "color") == "3:2");
+  ASSERT(mapped(out, "red") == "4:4");
+  ASSERT(mapped_end(out, "red; }") == "5:1");
+  return true;
+}
+
+bool TestIndented() {
+  Compiled out = compile(
+    "=m($x)\n"
+    "  e: $x\n"
+    ".a\n"
+    "  b: c\n"
+    ".d\n"
+    "  +m(1px)\n", true);
+  ASSERT(out.css == ".a {\n  b: c; }\n\n.d {\n  e: 1px; }\n");
+  ASSERT(mapped(out, ".a") == "2:0");
+  ASSERT(mapped(out, "b:") == "3:2");
+  ASSERT(mapped(out, "c;") == "3:5");
+  // blocks end where the next line at their level starts
+  ASSERT(mapped_end(out, "c; }") == "4:0");
+  ASSERT(mapped(out, "e:") == "1:2");
+  // the argument of the `+m` shorthand
+  ASSERT(mapped(out, "1px") == "5:5");
+  ASSERT(mapped_end(out, "1px; }") == "6:0");
+  return true;
+}
+
+// Positions of all callees, as seen by a custom function
+union Sass_Value* callees(const union Sass_Value*, Sass_Function_Entry, struct Sass_Compiler* compiler) {
+  std::string positions;
+  for (size_t i = 0; i < sass_compiler_get_callee_stack_size(compiler); i++) {
+    Sass_Callee_Entry callee = sass_compiler_get_callee_entry(compiler, i);
+    positions += std::string(i ? " " : "") + sass_callee_get_name(callee) + "@" +
+      std::to_string(sass_callee_get_line(callee)) + ":" +
+      std::to_string(sass_callee_get_column(callee));
+  }
+  return sass_make_string(positions.c_str());
+}
+
+bool TestCalleePositions() {
+  struct Sass_Data_Context* ctx = sass_make_data_context(strdup(
+    "@mixin m {\n"
+    "  b: callees();\n"
+    "}\n"
+    "a {\n"
+    "  x: y; @include m;\n"
+    "}\n"));
+  struct Sass_Options* options = sass_data_context_get_options(ctx);
+  Sass_Function_List functions = sass_make_function_list(1);
+  sass_function_set_list_entry(functions, 0, sass_make_function("callees()", callees, 0));
+  sass_option_set_c_functions(options, functions);
+  sass_compile_data_context(ctx);
+  Compiled out(Testing::result_of(sass_data_context_get_context(ctx)));
+  sass_delete_data_context(ctx);
+  // resolved from the spans of the mixin name and the call
+  ASSERT(out.css == "a {\n  x: y;\n  b: m@5:18 callees@2:6; }\n");
+  return true;
+}
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestImmortalDeclarationValue);
+  TEST(TestImmortalListItems);
+  TEST(TestImmortalLoopVariable);
+  TEST(TestClosingBrace);
+  TEST(TestAfterSelectorInterpolation);
+  TEST(TestInterpolatedString);
+  TEST(TestMultiLine);
+  TEST(TestIndented);
+  TEST(TestCalleePositions);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,123 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_stylesheet_cache");
+
+using Compiled = Testing::Result;
+
+Compiled compile(const std::string& name, struct Sass_StyleSheet_Cache* cache) {
+  std::string path = dir.path(name);
+  struct Sass_File_Context* ctx = sass_make_file_context(path.c_str());
+  struct Sass_Options* options = sass_file_context_get_options(ctx);
+  sass_option_set_output_path(options, (path + ".css").c_str());
+  sass_option_set_source_map_file(options, (path + ".css.map").c_str());
+  sass_option_set_omit_source_map_url(options, true);
+  sass_option_set_stylesheet_cache(options, cache);
+  sass_compile_file_context(ctx);
+  Compiled result(Testing::result_of(sass_file_context_get_context(ctx)));
+  sass_delete_file_context(ctx);
+  return result;
+}
+
+// The mappings of the source map (their source indexes
+// are relative, so they differ if the index is wrong)
+std::string mappings(const Compiled& out) {
+  size_t start = out.map.find("\"mappings\": \"");
+  if (start == std::string::npos) return "";
+  return out.map.substr(start, out.map.find('"', start + 13) - start);
+}
+
+bool TestReuse() {
+  struct Sass_StyleSheet_Cache* cache = sass_make_stylesheet_cache();
+  Compiled first = compile("a.scss", cache);
+  ASSERT(first.status == 0);
+  ASSERT(sass_stylesheet_cache_get_size(cache) == 3);
+  Compiled second = compile("a.scss", cache);
+  ASSERT(second.css == first.css);
+  ASSERT(second.map == first.map);
+  ASSERT(sass_stylesheet_cache_get_size(cache) == 3);
+  sass_delete_stylesheet_cache(cache);
+  return true;
+}
+
+bool TestSourceIdsPerCompilation() {
+  struct Sass_StyleSheet_Cache* cache = sass_make_stylesheet_cache();
+  // the shared partial is the second source of a.scss,
+  // but the first one imported by b.scss
+  ASSERT(compile("a.scss", cache).status == 0);
+  Compiled cached = compile("b.scss", cache);
+  Compiled parsed = compile("b.scss", nullptr);
+  ASSERT(cached.status == 0);
+  ASSERT(cached.css == parsed.css);
+  ASSERT(mappings(cached) == mappings(parsed));
+  // and it still maps correctly for the first one
+  Compiled again = compile("a.scss", cache);
+  ASSERT(mappings(again) == mappings(compile("a.scss", nullptr)));
+  sass_delete_stylesheet_cache(cache);
+  return true;
+}
+
+bool TestEvaluatesCopy() {
+  // evaluating the default of the mixin once marks the division
+  // as done, so a shared tree would print `0.5 3` the next time
+  Compiled parsed = compile("a.scss", nullptr);
+  ASSERT(parsed.css.find("d: 1/2 3;") != std::string::npos);
+  struct Sass_StyleSheet_Cache* cache = sass_make_stylesheet_cache();
+  for (int i = 0; i < 3; ++i) {
+    Compiled cached = compile("a.scss", cache);
+    ASSERT(cached.status == 0);
+    ASSERT(cached.css == parsed.css);
+  }
+  sass_delete_stylesheet_cache(cache);
+  return true;
+}
+
+bool TestConcurrentCompilations() {
+  Compiled a = compile("a.scss", nullptr);
+  Compiled b = compile("b.scss", nullptr);
+  struct Sass_StyleSheet_Cache* cache = sass_make_stylesheet_cache();
+  std::vector<std::thread> threads;
+  std::vector<int> failures(8, 0);
+  for (size_t i = 0; i < failures.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (size_t n = 0; n < 25; ++n) {
+        const bool first = (i + n) % 2 == 0;
+        Compiled out = compile(first ? "a.scss" : "b.scss", cache);
+        const Compiled& expected(first ? a : b);
+        if (out.css != expected.css || out.map != expected.map) {
+          ++failures[i];
+        }
+        if (n % 10 == 9) sass_stylesheet_cache_clear(cache);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (int failed : failures) ASSERT(failed == 0);
+  sass_delete_stylesheet_cache(cache);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  dir.write("_colors.scss", "$c: red;\n@mixin m($x) { m: $x; }\n");
+  dir.write("_shared.scss", "@import 'colors';\n.s { @include m($c); s: 1px + 2px; }\n"
+    "@mixin d($l: 1/2 3) { d: $l; }\n.d { @include d; }\n");
+  dir.write("_own.scss", ".o { o: o; }\n");
+  dir.write("a.scss", "@import 'own';\n@import 'shared';\n.a { a: $c; }\n");
+  dir.write("b.scss", "@import 'shared';\n.b {\n  b: #{$c}-x;\n}\n");
+
+  Testing::Tests tests;
+  TEST(TestReuse);
+  TEST(TestSourceIdsPerCompilation);
+  TEST(TestEvaluatesCopy);
+  TEST(TestConcurrentCompilations);
+  return tests.report(argv[0]);
+}
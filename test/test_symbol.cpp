@@ -0,0 +1,65 @@
+#include "../src/symbol.hpp"
+#include "testing.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+bool TestSameNameSameSymbol() {
+  Sass::Symbol a("$foo");
+  Sass::Symbol b(Sass::sass::string("$foo"));
+  ASSERT(a == b);
+  ASSERT(a.id() == b.id());
+  ASSERT(a.c_str() == b.c_str());
+  return true;
+}
+
+bool TestDifferentNames() {
+  Sass::Symbol a("$foo");
+  Sass::Symbol b("$bar");
+  ASSERT(a != b);
+  ASSERT(a.id() != b.id());
+  ASSERT(a.to_string() == "$foo");
+  ASSERT(b.length() == 4);
+  return true;
+}
+
+bool TestEmptySymbol() {
+  Sass::Symbol a;
+  Sass::Symbol b("");
+  ASSERT(a == b);
+  ASSERT(a.empty());
+  ASSERT(a.id() == 0);
+  ASSERT(a.to_string() == "");
+  return true;
+}
+
+bool TestConcurrentInterning() {
+  std::vector<std::thread> threads;
+  std::vector<std::vector<Sass::Symbol>> results(4);
+  for (size_t t = 0; t < results.size(); t++) {
+    threads.emplace_back([&results, t]() {
+      for (size_t i = 0; i < 1000; i++) {
+        results[t].push_back(Sass::Symbol(("name-" + std::to_string(i)).c_str()));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (size_t t = 1; t < results.size(); t++) {
+    for (size_t i = 0; i < 1000; i++) {
+      ASSERT(results[t][i] == results[0][i]);
+    }
+  }
+  ASSERT(Sass::Symbol("name-999").to_string() == "name-999");
+  return true;
+}
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestSameNameSameSymbol);
+  TEST(TestDifferentNames);
+  TEST(TestEmptySymbol);
+  TEST(TestConcurrentInterning);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,83 @@
+#include "testing.hpp"
+
+#include <sass.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+Testing::TempDir dir("sass_watcher");
+
+// Names of the inputs compiled by the watcher, in order
+void record(struct Sass_Context* ctx, void* cookie) {
+  std::vector<std::string>* compiled = static_cast<std::vector<std::string>*>(cookie);
+  const char* path = sass_option_get_input_path(sass_context_get_options(ctx));
+  compiled->push_back(std::string(path).substr(dir.path().size() + 1));
+}
+
+struct Watched {
+  std::vector<std::string> compiled;
+  struct Sass_Watcher* watcher;
+  Watched() : watcher(sass_make_watcher(nullptr, record, &compiled)) {}
+  ~Watched() { if (watcher) sass_delete_watcher(watcher); }
+  void add(const std::string& name) { sass_watcher_add_file(watcher, dir.path(name).c_str()); }
+  // the inputs compiled after the next change
+  std::vector<std::string> poll() {
+    compiled.clear();
+    sass_watcher_poll(watcher, 1000);
+    return compiled;
+  }
+};
+
+bool TestRebuildsAffectedEntry() {
+  dir.mkdir("a");
+  dir.mkdir("b");
+  dir.write("a/_shared.scss", ".s { c: d; }\n");
+  dir.write("a/main.scss", "@import 'shared';\n");
+  dir.write("b/other.scss", ".o { c: d; }\n");
+  Watched watched;
+  // not supported on this platform
+  if (!watched.watcher) return true;
+  watched.add("a/main.scss");
+  watched.add("b/other.scss");
+  ASSERT(watched.compiled.size() == 2);
+  dir.write("a/_shared.scss", ".s { c: e; }\n");
+  ASSERT(watched.poll() == std::vector<std::string>{ "a/main.scss" });
+  return true;
+}
+
+bool TestRebuildsFailedInputInItsDirectories() {
+  dir.mkdir("c");
+  dir.mkdir("d");
+  dir.mkdir("e");
+  dir.write("c/broken.scss", "@import 'missing';\n");
+  dir.write("d/fine.scss", ".f { c: d; }\n");
+  dir.write("e/other.scss", ".o { c: d; }\n");
+  Watched watched;
+  if (!watched.watcher) return true;
+  watched.add("c/broken.scss");
+  watched.add("d/fine.scss");
+  watched.add("e/other.scss");
+  // nothing it may import changed
+  dir.write("d/fine.scss", ".f { c: e; }\n");
+  ASSERT(watched.poll() == std::vector<std::string>{ "d/fine.scss" });
+  dir.write("e/_unrelated.scss", ".u { c: d; }\n");
+  ASSERT(watched.poll().empty());
+  // the import is found now
+  dir.write("c/_missing.scss", ".m { c: d; }\n");
+  ASSERT(watched.poll() == std::vector<std::string>{ "c/broken.scss" });
+  // and its dependencies are known afterwards
+  dir.write("c/_missing.scss", ".m { c: e; }\n");
+  ASSERT(watched.poll() == std::vector<std::string>{ "c/broken.scss" });
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Testing::Tests tests;
+  TEST(TestRebuildsAffectedEntry);
+  TEST(TestRebuildsFailedInputInItsDirectories);
+  return tests.report(argv[0]);
+}
@@ -0,0 +1,119 @@
+#ifndef SASS_TEST_TESTING_H
+#define SASS_TEST_TESTING_H
+
+// Scaffolding shared by the unit tests: assertions, the runner
+// printing the summary, fixture files in a temporary directory
+// and the outcome of compilations through the C API.
+
+#include <sass.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <ftw.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define ASSERT(cond) \
+  if (!(cond)) { \
+    std::cerr << "Assertion failed: " #cond " at " __FILE__ << ":" << __LINE__ << std::endl; \
+    return false; \
+  } \
+
+// Runs the test function and records the outcome in `tests`
+#define TEST(fn) tests.run(#fn, fn)
+
+namespace Testing {
+
+  class Tests {
+    private:
+      std::vector<std::string> passed;
+      std::vector<std::string> failed;
+    public:
+      void run(const char* name, bool (*fn)()) {
+        if (fn()) {
+          passed.push_back(name);
+        } else {
+          failed.push_back(name);
+          std::cerr << "Failed: " << name << std::endl;
+        }
+      }
+      // prints the summary and returns the exit code
+      int report(const char* program) const {
+        std::cerr << program << ": Passed: " << passed.size()
+                  << ", failed: " << failed.size()
+                  << "." << std::endl;
+        return failed.size();
+      }
+  };
+
+  // Directory for fixture files, removed with everything in it
+  class TempDir {
+    private:
+      std::string root;
+      static int remove_entry(const char* path, const struct stat*, int, struct FTW*) {
+        return ::remove(path);
+      }
+    public:
+      explicit TempDir(const std::string& prefix) : root("/tmp/" + prefix + "XXXXXX") {
+        if (mkdtemp(&root[0]) == nullptr) {
+          std::cerr << "Can't create " << root << std::endl;
+          std::exit(1);
+        }
+      }
+      ~TempDir() {
+        nftw(root.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+      }
+      TempDir(const TempDir&) = delete;
+      TempDir& operator=(const TempDir&) = delete;
+      const std::string& path() const { return root; }
+      // absolute path of a file in the directory
+      std::string path(const std::string& name) const { return root + "/" + name; }
+      // creates or replaces the file, returns its path
+      std::string write(const std::string& name, const std::string& contents) const {
+        std::string file(path(name));
+        FILE* fd = std::fopen(file.c_str(), "wb");
+        if (fd == nullptr) return file;
+        std::fwrite(contents.data(), 1, contents.size(), fd);
+        std::fclose(fd);
+        return file;
+      }
+      void remove(const std::string& name) const { ::remove(path(name).c_str()); }
+      void mkdir(const std::string& name) const { ::mkdir(path(name).c_str(), 0700); }
+  };
+
+  // Outcome of a compilation (copied, the context may go away)
+  struct Result {
+    int status;
+    std::string css;
+    std::string map;
+    // the formatted message and the bare error text
+    std::string message;
+    std::string text;
+    size_t line;
+    size_t column;
+  };
+
+  inline Result result_of(struct Sass_Context* ctx) {
+    Result result;
+    result.status = sass_context_get_error_status(ctx);
+    result.line = result.column = 0;
+    if (result.status == 0) {
+      const char* css = sass_context_get_output_string(ctx);
+      const char* map = sass_context_get_source_map_string(ctx);
+      if (css) result.css = css;
+      if (map) result.map = map;
+    } else {
+      result.message = sass_context_get_error_message(ctx);
+      result.text = sass_context_get_error_text(ctx);
+      result.line = sass_context_get_error_line(ctx);
+      result.column = sass_context_get_error_column(ctx);
+    }
+    return result;
+  }
+
+}
+
+#endif